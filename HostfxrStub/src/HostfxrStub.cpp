@@ -0,0 +1,299 @@
+#include <Core/Definitions.hpp>
+#include <Core/Doorbell.hpp>
+#include <Core/Log.hpp>
+
+#include <NetCore/NetCoreGcRegion.hpp>
+#include <NetCore/NetCorePrewarm.hpp>
+
+#include <hostfxr.h>
+#include <coreclr_delegates.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+// The stub links against InteropLib for logging, so it cannot export its entry points through INTEROP_C_API
+#ifdef _MSC_VER
+#define HOSTFXR_STUB_API extern "C" __declspec(dllexport)
+
+#else
+#define HOSTFXR_STUB_API extern "C" __attribute__((visibility("default")))
+#endif
+
+// Environment variables tuning the simulated costs (in nanoseconds)
+#define HOSTFXR_STUB_CALL_LATENCY_ENV "INTEROP_HOSTFXR_STUB_CALL_LATENCY"
+#define HOSTFXR_STUB_INIT_LATENCY_ENV "INTEROP_HOSTFXR_STUB_INIT_LATENCY"
+#define HOSTFXR_STUB_BIND_LATENCY_ENV "INTEROP_HOSTFXR_STUB_BIND_LATENCY"
+
+// Comma-separated names of the methods returning a float or a double ("QuotePrice,GetRatio"): the stub only sees
+// names, and their results come back in a vector register rather than the integer one
+#define HOSTFXR_STUB_FLOAT_METHODS_ENV "INTEROP_HOSTFXR_STUB_FLOAT_METHODS"
+
+// Entry points of InteropLib itself, which take requests the stub fills in the way an idle runtime would
+#define HOSTFXR_STUB_PREWARM_CLASS_SUFFIX ".Native.Prewarm"
+#define HOSTFXR_STUB_GC_REGION_CLASS_SUFFIX ".Native.GcRegion"
+
+#define HOSTFXR_STUB_SUCCESS 0
+#define HOSTFXR_STUB_INVALID_ARG_FAILURE static_cast<i32>(0x80008081)
+#define HOSTFXR_STUB_HOST_INVALID_STATE static_cast<i32>(0x800080a3)
+
+namespace Interop::HostfxrStub
+{
+
+	struct Context
+	{
+		b8 Open = false;
+		u64 CallLatency = 0;
+		u64 BindLatency = 0;
+		const char* FloatMethods = nullptr;
+	};
+
+	static Context s_Context = {};
+
+	u64 ReadLatency(const char* name)
+	{
+		const char* value = getenv(name);
+		return value != nullptr ? strtoull(value, nullptr, 10) : 0;
+	}
+
+	INTEROP_INLINE void Spin(u64 nanoseconds)
+	{
+		if (nanoseconds == 0) return;
+
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(nanoseconds);
+		while (std::chrono::steady_clock::now() < deadline) {}
+	}
+
+	// Stands in for managed methods returning void, an integer or a pointer, all in the integer return register.
+	// Arguments are register-sized or passed by address, which a parameterless callee can safely ignore.
+	intptr_t INTEROP_DELEGATE_CALLTYPE LoopbackFunction()
+	{
+		Spin(s_Context.CallLatency);
+		return 0;
+	}
+
+	// Stands in for managed methods returning a float or a double, which come back in a vector register
+	f64 INTEROP_DELEGATE_CALLTYPE LoopbackFloatingPoint()
+	{
+		Spin(s_Context.CallLatency);
+		return 0.0;
+	}
+
+	// Pre-warms nothing, every method reads as compiled
+	i32 INTEROP_DELEGATE_CALLTYPE LoopbackPrewarm(const NetCore::PrewarmRequest* request)
+	{
+		Spin(s_Context.CallLatency);
+
+		NetCore::PrewarmStatus* status = request->Status;
+
+		status->Prepared.store(request->MethodCount, std::memory_order_relaxed);
+		status->Failed.store(0, std::memory_order_relaxed);
+		status->State.store(NetCore::INTEROP_PREWARM_STATE_DONE, std::memory_order_release);
+
+		Memory::RingDoorbell(&status->Completed);
+		return 0;
+	}
+
+	// Stands in for entering and leaving a GC region, in which no collection ever happens
+	i32 INTEROP_DELEGATE_CALLTYPE LoopbackGcRegion(const NetCore::GcRegionRequest* request)
+	{
+		Spin(s_Context.CallLatency);
+
+		if (request->Stats != nullptr) *request->Stats = {};
+		return 0;
+	}
+
+	i32 INTEROP_DELEGATE_CALLTYPE LoopbackGcStats(NetCore::GcStats* stats)
+	{
+		Spin(s_Context.CallLatency);
+
+		*stats = {};
+		return 0;
+	}
+
+	static b8 IsMethod(const char_t* name, const char* expected)
+	{
+		while (*name != 0 && *expected != 0 && *name == static_cast<char_t>(*expected))
+		{
+			name++;
+			expected++;
+		}
+
+		return *name == 0 && *expected == 0;
+	}
+
+	// Type names are "<class path>, <assembly>", the class path must end with the suffix
+	static b8 IsClass(const char_t* typeName, const char* suffix)
+	{
+		size_t length = 0;
+		while (typeName[length] != 0 && typeName[length] != ',') length++;
+
+		size_t suffixLength = strlen(suffix);
+		if (length < suffixLength) return false;
+
+		for (size_t i = 0; i < suffixLength; i++)
+		{
+			if (typeName[length - suffixLength + i] != static_cast<char_t>(suffix[i])) return false;
+		}
+
+		return true;
+	}
+
+	static b8 IsListed(const char_t* name, const char* list)
+	{
+		if (list == nullptr) return false;
+
+		while (*list != 0)
+		{
+			const char_t* cursor = name;
+
+			while (*cursor != 0 && *list != 0 && *list != ',' && *cursor == static_cast<char_t>(*list))
+			{
+				cursor++;
+				list++;
+			}
+
+			if (*cursor == 0 && (*list == 0 || *list == ',')) return true;
+
+			while (*list != 0 && *list != ',') list++;
+			if (*list == ',') list++;
+		}
+
+		return false;
+	}
+
+	static void* GetLoopback(const char_t* typeName, const char_t* methodName)
+	{
+		if (IsClass(typeName, HOSTFXR_STUB_PREWARM_CLASS_SUFFIX) && IsMethod(methodName, "Start"))
+			return reinterpret_cast<void*>(&LoopbackPrewarm);
+
+		if (IsClass(typeName, HOSTFXR_STUB_GC_REGION_CLASS_SUFFIX))
+		{
+			if (IsMethod(methodName, "Enter") || IsMethod(methodName, "Exit")) return reinterpret_cast<void*>(&LoopbackGcRegion);
+			if (IsMethod(methodName, "GetStats")) return reinterpret_cast<void*>(&LoopbackGcStats);
+		}
+
+		if (IsListed(methodName, s_Context.FloatMethods))
+			return reinterpret_cast<void*>(&LoopbackFloatingPoint);
+
+		return reinterpret_cast<void*>(&LoopbackFunction);
+	}
+
+	i32 Bind(const char_t* typeName, const char_t* methodName, void** delegate)
+	{
+		if (typeName == nullptr || methodName == nullptr || delegate == nullptr)
+			return HOSTFXR_STUB_INVALID_ARG_FAILURE;
+
+		if (!s_Context.Open)
+			return HOSTFXR_STUB_HOST_INVALID_STATE;
+
+		Spin(s_Context.BindLatency);
+		*delegate = GetLoopback(typeName, methodName);
+
+		return HOSTFXR_STUB_SUCCESS;
+	}
+
+	i32 CORECLR_DELEGATE_CALLTYPE LoadAssemblyAndGetFunctionPointer(const char_t* assemblyPath, const char_t* typeName,
+		const char_t* methodName, const char_t* delegateTypeName, void* reserved, void** delegate)
+	{
+		if (assemblyPath == nullptr)
+			return HOSTFXR_STUB_INVALID_ARG_FAILURE;
+
+		return Bind(typeName, methodName, delegate);
+	}
+
+	i32 CORECLR_DELEGATE_CALLTYPE GetFunctionPointer(const char_t* typeName, const char_t* methodName,
+		const char_t* delegateTypeName, void* loadContext, void* reserved, void** delegate)
+	{
+		return Bind(typeName, methodName, delegate);
+	}
+
+	i32 CORECLR_DELEGATE_CALLTYPE LoadAssembly(const char_t* assemblyPath, void* loadContext, void* reserved)
+	{
+		return assemblyPath != nullptr ? HOSTFXR_STUB_SUCCESS : HOSTFXR_STUB_INVALID_ARG_FAILURE;
+	}
+
+	i32 CORECLR_DELEGATE_CALLTYPE LoadAssemblyBytes(const void* assemblyBytes, size_t assemblyBytesLength,
+		const void* symbolsBytes, size_t symbolsBytesLength, void* loadContext, void* reserved)
+	{
+		return assemblyBytes != nullptr && assemblyBytesLength > 0 ? HOSTFXR_STUB_SUCCESS : HOSTFXR_STUB_INVALID_ARG_FAILURE;
+	}
+
+}
+
+using namespace Interop::HostfxrStub;
+
+HOSTFXR_STUB_API i32 HOSTFXR_CALLTYPE hostfxr_initialize_for_runtime_config(const char_t* runtime_config_path,
+	const hostfxr_initialize_parameters* parameters, hostfxr_handle* host_context_handle)
+{
+	if (runtime_config_path == nullptr || host_context_handle == nullptr)
+		return HOSTFXR_STUB_INVALID_ARG_FAILURE;
+
+	if (s_Context.Open)
+		return HOSTFXR_STUB_HOST_INVALID_STATE;
+
+	Spin(ReadLatency(HOSTFXR_STUB_INIT_LATENCY_ENV));
+
+	s_Context.Open = true;
+	s_Context.CallLatency = ReadLatency(HOSTFXR_STUB_CALL_LATENCY_ENV);
+	s_Context.BindLatency = ReadLatency(HOSTFXR_STUB_BIND_LATENCY_ENV);
+	s_Context.FloatMethods = getenv(HOSTFXR_STUB_FLOAT_METHODS_ENV);
+
+	*host_context_handle = static_cast<hostfxr_handle>(&s_Context);
+
+	return HOSTFXR_STUB_SUCCESS;
+}
+
+HOSTFXR_STUB_API i32 HOSTFXR_CALLTYPE hostfxr_get_runtime_delegate(const hostfxr_handle host_context_handle,
+	hostfxr_delegate_type type, void** delegate)
+{
+	if (host_context_handle != &s_Context || delegate == nullptr)
+		return HOSTFXR_STUB_INVALID_ARG_FAILURE;
+
+	switch (type)
+	{
+	case hdt_load_assembly_and_get_function_pointer:
+		*delegate = reinterpret_cast<void*>(&LoadAssemblyAndGetFunctionPointer);
+		return HOSTFXR_STUB_SUCCESS;
+
+	case hdt_get_function_pointer:
+		*delegate = reinterpret_cast<void*>(&GetFunctionPointer);
+		return HOSTFXR_STUB_SUCCESS;
+
+	case hdt_load_assembly:
+		*delegate = reinterpret_cast<void*>(&LoadAssembly);
+		return HOSTFXR_STUB_SUCCESS;
+
+	case hdt_load_assembly_bytes:
+		*delegate = reinterpret_cast<void*>(&LoadAssemblyBytes);
+		return HOSTFXR_STUB_SUCCESS;
+
+	default:
+		INTEROP_LOG_ERROR("The hostfxr stub does not support runtime delegate type %d", static_cast<i32>(type));
+		return HOSTFXR_STUB_INVALID_ARG_FAILURE;
+	}
+}
+
+HOSTFXR_STUB_API i32 HOSTFXR_CALLTYPE hostfxr_close(const hostfxr_handle host_context_handle)
+{
+	if (host_context_handle == nullptr)
+		return HOSTFXR_STUB_INVALID_ARG_FAILURE;
+
+	s_Context.Open = false;
+
+	return HOSTFXR_STUB_SUCCESS;
+}
+
+#undef HOSTFXR_STUB_HOST_INVALID_STATE
+#undef HOSTFXR_STUB_INVALID_ARG_FAILURE
+#undef HOSTFXR_STUB_SUCCESS
+
+#undef HOSTFXR_STUB_GC_REGION_CLASS_SUFFIX
+#undef HOSTFXR_STUB_PREWARM_CLASS_SUFFIX
+#undef HOSTFXR_STUB_FLOAT_METHODS_ENV
+#undef HOSTFXR_STUB_BIND_LATENCY_ENV
+#undef HOSTFXR_STUB_INIT_LATENCY_ENV
+#undef HOSTFXR_STUB_CALL_LATENCY_ENV
+
+#undef HOSTFXR_STUB_API
\ No newline at end of file
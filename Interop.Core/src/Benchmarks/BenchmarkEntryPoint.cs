@@ -0,0 +1,256 @@
+using Interop.Core.Examples;
+using Interop.Core.Native;
+
+namespace Interop.Core.Benchmarks;
+
+/// <summary>
+/// Entry points used by <c>InteropBench</c> to measure the cost of every boundary crossing.
+/// None of them print or allocate in the measured loop.
+/// </summary>
+public static unsafe partial class BenchmarkEntryPoint
+{
+	private static readonly (int MinQuantity, double Discount)[] s_QuoteTiers = [(1000, 0.20), (500, 0.15), (100, 0.10), (10, 0.05)];
+
+	[UnmanagedCallersOnly]
+	private static void NoopCallback(IntPtr obj) {}
+
+	/// <summary>
+	/// Empty native-to-managed call without arguments
+	/// </summary>
+	[UnmanagedCallersOnly]
+	public static void Noop() {}
+
+	/// <summary>
+	/// Empty native-to-managed call receiving a pointer to an unmanaged object
+	/// </summary>
+	/// <param name="obj" cref="CustomObject">Pointer to a <c>CustomObject</c> object</param>
+	[UnmanagedCallersOnly]
+	public static void NoopWithObject(IntPtr obj) {}
+
+	/// <summary>
+	/// Calls an empty native export through <c>LibraryImport</c> the number of times specified
+	/// </summary>
+	/// <param name="iterations">Number of managed-to-native calls to perform</param>
+	[UnmanagedCallersOnly]
+	public static void CallNativeNoop(int iterations)
+	{
+		for (int i = 0; i < iterations; i++)
+			BenchmarkNoop(IntPtr.Zero);
+	}
+
+	/// <summary>
+	/// Calls an empty native export through the function pointer table received at bootstrap
+	/// </summary>
+	/// <param name="iterations">Number of managed-to-native calls to perform</param>
+	[UnmanagedCallersOnly]
+	public static void CallNativeNoopExport(int iterations)
+	{
+		var noop = (delegate* unmanaged<IntPtr, void>)InteropLib.Exports.BenchmarkNoop;
+
+		for (int i = 0; i < iterations; i++)
+			noop(IntPtr.Zero);
+	}
+
+	/// <summary>
+	/// Calls an empty native export through the function pointer table received at bootstrap,
+	/// skipping the GC transition
+	/// </summary>
+	/// <param name="iterations">Number of managed-to-native calls to perform</param>
+	[UnmanagedCallersOnly]
+	public static void CallNativeNoopSuppressed(int iterations)
+	{
+		var noop = InteropLib.Exports.BenchmarkNoop;
+
+		for (int i = 0; i < iterations; i++)
+			noop(IntPtr.Zero);
+	}
+
+	/// <summary>
+	/// Performs the native-to-managed-to-native-to-managed roundabout of <c>EntryPoint.DelegateRoundabout</c>
+	/// the number of times specified, with an empty managed callback
+	/// </summary>
+	/// <param name="iterations">Number of roundabouts to perform</param>
+	[UnmanagedCallersOnly]
+	public static void DelegateRoundabout(int iterations)
+	{
+		CustomObject objToPass = new() { TextProp = "Amet", DoubleProp = 1123.567 };
+
+		using ScratchScope scratch = new();
+		IntPtr buffer = scratch.Write(objToPass);
+
+		for (int i = 0; i < iterations; i++)
+			InteropLib.Exports.ProcessCustomObject(buffer, &NoopCallback);
+	}
+
+	/// <summary>
+	/// Marshals a <c>CustomObject</c> into a CoTaskMem buffer and hands it to an empty native export,
+	/// as per-call interop temporaries used to be allocated, the number of times specified
+	/// </summary>
+	/// <param name="iterations">Number of allocations and calls to perform</param>
+	[UnmanagedCallersOnly]
+	public static void PassObjectCoTaskMem(int iterations)
+	{
+		CustomObject objToPass = new() { TextProp = "Dolor Sit", DoubleProp = 324.7677 };
+
+		for (int i = 0; i < iterations; i++)
+		{
+			IntPtr buffer = Marshal.AllocCoTaskMem(Marshal.SizeOf(objToPass));
+			Marshal.StructureToPtr(objToPass, buffer, false);
+
+			InteropLib.Exports.BenchmarkNoop(buffer);
+
+			Marshal.FreeCoTaskMem(buffer);
+		}
+	}
+
+	/// <summary>
+	/// Marshals a <c>CustomObject</c> into the scratch arena and hands it to an empty native export,
+	/// the number of times specified
+	/// </summary>
+	/// <param name="iterations">Number of allocations and calls to perform</param>
+	[UnmanagedCallersOnly]
+	public static void PassObjectScratch(int iterations)
+	{
+		CustomObject objToPass = new() { TextProp = "Dolor Sit", DoubleProp = 324.7677 };
+
+		for (int i = 0; i < iterations; i++)
+		{
+			using ScratchScope scratch = new();
+			IntPtr buffer = scratch.Write(objToPass);
+
+			InteropLib.Exports.BenchmarkNoop(buffer);
+		}
+	}
+
+	/// <summary>
+	/// Copies every slot of a native array, as consumers unaware of which slots changed have to
+	/// </summary>
+	/// <param name="source">Slots written by native code</param>
+	/// <param name="destination">Managed-side copy of the slots</param>
+	/// <param name="count">Number of slots</param>
+	/// <param name="slotSize">Size of a slot in bytes</param>
+	[UnmanagedCallersOnly]
+	public static void SyncAllSlots(byte* source, byte* destination, int count, int slotSize)
+	{
+		long size = (long)count * slotSize;
+		Buffer.MemoryCopy(source, destination, size, size);
+	}
+
+	/// <summary>
+	/// Copies only the slots of a native array flagged in its dirty bitmap
+	/// </summary>
+	/// <param name="bitmap">Dirty bitmap of the slots</param>
+	/// <param name="wordCount">Number of 64-bit words of the bitmap</param>
+	/// <param name="source">Slots written by native code</param>
+	/// <param name="destination">Managed-side copy of the slots</param>
+	/// <param name="slotSize">Size of a slot in bytes</param>
+	[UnmanagedCallersOnly]
+	public static void SyncDirtySlots(IntPtr bitmap, int wordCount, byte* source, byte* destination, int slotSize)
+	{
+		Span<ulong> collected = wordCount <= 1024 ? stackalloc ulong[wordCount] : new ulong[wordCount];
+
+		if (new DirtyBitmap(bitmap, wordCount).Collect(collected) == 0)
+			return;
+
+		foreach (int index in DirtyBitmap.Enumerate(collected))
+		{
+			long offset = (long)index * slotSize;
+			Buffer.MemoryCopy(source + offset, destination + offset, slotSize, slotSize);
+		}
+	}
+
+	/// <summary>
+	/// Receives a native frame by copying it into a managed array, as marshalled payloads are
+	/// </summary>
+	/// <param name="data">Data of the frame</param>
+	/// <param name="size">Size of the frame in bytes</param>
+	/// <returns>The last byte of the frame</returns>
+	[UnmanagedCallersOnly]
+	public static byte ReceiveFrameCopy(byte* data, int size)
+	{
+		byte[] frame = new byte[size];
+		new ReadOnlySpan<byte>(data, size).CopyTo(frame);
+
+		return frame[^1];
+	}
+
+	/// <summary>
+	/// Receives a native frame by taking over the buffer reference transferred by the caller
+	/// </summary>
+	/// <param name="buffer">Native buffer holding the frame</param>
+	/// <returns>The last byte of the frame</returns>
+	[UnmanagedCallersOnly]
+	public static byte ReceiveFrameBuffer(IntPtr buffer)
+	{
+		using NativeBuffer frame = NativeBuffer.Adopt(buffer);
+		Memory<byte> memory = frame.Memory;
+
+		return memory.Span[^1];
+	}
+
+	/// <summary>
+	/// Decodes an unmanaged <c>CustomObject</c> through the CLR marshaller the number of times specified
+	/// </summary>
+	/// <param name="obj" cref="CustomObject">Pointer to a <c>CustomObject</c> object</param>
+	/// <param name="iterations">Number of decodings to perform</param>
+	[UnmanagedCallersOnly]
+	public static void DecodeMarshalled(IntPtr obj, int iterations)
+	{
+		int length = 0;
+
+		for (int i = 0; i < iterations; i++)
+			length += Marshal.PtrToStructure<CustomObject>(obj).TextProp.Length;
+
+		GC.KeepAlive(length);
+	}
+
+	/// <summary>
+	/// Decodes the text of an unmanaged <c>CustomObject</c> in place with <c>NativeText</c> the number of times specified
+	/// </summary>
+	/// <param name="obj" cref="CustomObjectView">Pointer to a <c>CustomObject</c> object</param>
+	/// <param name="iterations">Number of decodings to perform</param>
+	[UnmanagedCallersOnly]
+	public static void DecodeNativeText(IntPtr obj, int iterations)
+	{
+		CustomObjectView* view = (CustomObjectView*)obj;
+		Span<char> text = stackalloc char[CustomObjectView.TextPropSize];
+		int length = 0;
+
+		for (int i = 0; i < iterations; i++)
+			length += NativeText.GetString(new ReadOnlySpan<byte>(view->TextProp, CustomObjectView.TextPropSize), text);
+
+		GC.KeepAlive(length);
+	}
+
+	/// <summary>
+	/// Pure pricing lookup, cached natively by <c>InteropBench</c> to measure result cache hits against the crossing
+	/// </summary>
+	/// <param name="quantity">Number of units</param>
+	/// <param name="unitPrice">Price of a unit before the volume discount</param>
+	/// <returns>The discounted total</returns>
+	[UnmanagedCallersOnly]
+	public static double QuotePrice(int quantity, double unitPrice)
+	{
+		foreach (var (minQuantity, discount) in s_QuoteTiers)
+		{
+			if (quantity >= minQuantity)
+				return quantity * unitPrice * (1.0 - discount);
+		}
+
+		return quantity * unitPrice;
+	}
+
+	/// <summary>
+	/// Drops the cached results of <c>QuotePrice</c>, as a change of the pricing tiers would
+	/// </summary>
+	/// <returns>The number of caches invalidated</returns>
+	[UnmanagedCallersOnly]
+	public static uint InvalidateQuotes() => ResultCache.Invalidate("Interop.Core.Benchmarks.BenchmarkEntryPoint.QuotePrice");
+
+	/// <summary>
+	/// Empty native export, used to measure the bare managed-to-native transition
+	/// </summary>
+	/// <param name="obj">Ignored</param>
+	[LibraryImport("InteropLib")]
+	private static partial void BenchmarkNoop(IntPtr obj);
+};
\ No newline at end of file
@@ -13,4 +13,17 @@ public struct CustomObject
 
 	[MarshalAs(UnmanagedType.R8)]
 	public double DoubleProp = 0.0;
+};
+
+/// <summary>
+/// Blittable view of the native <c>CustomObject</c> layout, read and written in place
+/// with <c>NativeText</c> instead of being marshalled
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct CustomObjectView
+{
+	public const int TextPropSize = 256;
+
+	public fixed byte TextProp[TextPropSize];
+	public double DoubleProp;
 };
\ No newline at end of file
@@ -1,34 +1,29 @@
+using Interop.Core.Native;
+
 namespace Interop.Core.Examples;
 
-public static partial class EntryPoint
+public static class EntryPoint
 {
 	/// <summary>
-	/// Delegate function declaration for functions manipulating <c>CustomObject</c>s
-	/// </summary>
-	/// <param name="obj" cref="CustomObject">Pointer to a <c>CustomObject</c> object</param>
-	/// <returns><c>true</c> on successful completion of the task, else <c>false</c></returns>
-	private delegate bool ParseCustomObjectFn(IntPtr obj);
-
-	/// <summary>
-	/// Prints to console the properties of the <c>CustomObject</c> provided
+	/// Prints to console the properties of the <c>CustomObject</c> provided.
+	/// Called back from native code through <c>ProcessCustomObject</c>.
 	/// </summary>
 	/// <param name="obj" cref="CustomObject">Pointer to a <c>CustomObject</c> object</param>
-	/// <returns><c>true</c> on successful completion of the task, else <c>false</c></returns>
-	private static bool PrintCustomObjProperties(IntPtr obj)
+	[UnmanagedCallersOnly]
+	private static void PrintCustomObjProperties(IntPtr obj)
 	{
 		CustomObject decoded = Marshal.PtrToStructure<CustomObject>(obj);
 
 		Console.WriteLine($"[C#] {nameof(PrintCustomObjProperties)}: TextProp=\"{decoded.TextProp}\"; DoubleProp={decoded.DoubleProp}");
-
-		return true;
 	}
 
 	/// <summary>
-	/// Edits the properties of the <c>CustomObject</c> provided and prints them to console
+	/// Edits the properties of the <c>CustomObject</c> provided and prints them to console.
+	/// Called back from native code through <c>ProcessCustomObject</c>.
 	/// </summary>
 	/// <param name="obj" cref="CustomObject">Pointer to a <c>CustomObject</c> object</param>
-	/// <returns><c>true</c> on successful completion of the task, else <c>false</c></returns>
-	private static bool EditCustomObjProperties(IntPtr obj)
+	[UnmanagedCallersOnly]
+	private static void EditCustomObjProperties(IntPtr obj)
 	{
 		CustomObject decoded = Marshal.PtrToStructure<CustomObject>(obj);
 
@@ -36,8 +31,6 @@ public static partial class EntryPoint
 		decoded.DoubleProp = 3.145628;
 
 		Console.WriteLine($"[C#] {nameof(EditCustomObjProperties)}: TextProp=\"{decoded.TextProp}\"; DoubleProp={decoded.DoubleProp}");
-
-		return true;
 	}
 
 	/// <summary>
@@ -55,16 +48,14 @@ public static partial class EntryPoint
 	/// Passes a managed <c>CustomObject</c> to the host program
 	/// </summary>
 	[UnmanagedCallersOnly]
-	public static void PassObjectToHost()
+	public static unsafe void PassObjectToHost()
 	{
 		CustomObject objToPass = new() { TextProp = "Dolor Sit", DoubleProp = 324.7677 };
 
-		IntPtr buffer = Marshal.AllocCoTaskMem(Marshal.SizeOf(objToPass));
-		Marshal.StructureToPtr(objToPass, buffer, false);
-
-		PrintHostedObjProperties(buffer);
+		using ScratchScope scratch = new();
+		IntPtr buffer = scratch.Write(objToPass);
 
-		Marshal.FreeCoTaskMem(buffer);
+		InteropLib.Exports.PrintHostedObjProperties(buffer);
 	}
 
 	/// <summary>
@@ -72,17 +63,15 @@ public static partial class EntryPoint
 	/// which, in turn, calls a managed delegate function on the object
 	/// </summary>
 	[UnmanagedCallersOnly]
-	public static void DelegateRoundabout()
+	public static unsafe void DelegateRoundabout()
 	{
 		CustomObject objToPass = new() { TextProp = "Amet", DoubleProp = 1123.567 };
 
-		IntPtr buffer = Marshal.AllocCoTaskMem(Marshal.SizeOf(objToPass));
-		Marshal.StructureToPtr(objToPass, buffer, false);
+		using ScratchScope scratch = new();
+		IntPtr buffer = scratch.Write(objToPass);
 
-		ProcessCustomObject(buffer, PrintCustomObjProperties);
-		ProcessCustomObject(buffer, EditCustomObjProperties);
-
-		Marshal.FreeCoTaskMem(buffer);
+		InteropLib.Exports.ProcessCustomObject(buffer, &PrintCustomObjProperties);
+		InteropLib.Exports.ProcessCustomObject(buffer, &EditCustomObjProperties);
 	}
 
 	/// <summary>
@@ -146,19 +135,25 @@ public static partial class EntryPoint
 	}
 
 	/// <summary>
-	/// Receives a managed <c>CustomObject</c> from the hosted managed library
-	/// and prints out its properties to standard output
+	/// Squares a number asynchronously and reports the result to the awaiting native coroutine.
+	/// The argument is only valid until this method returns, so it is read before the first await.
 	/// </summary>
-	/// <param name="obj" cref="CustomObject">The object to process</param>
-	[LibraryImport("InteropLib")]
-	private static partial void PrintHostedObjProperties(IntPtr obj);
+	/// <param name="state">Native state of the awaiting <c>ManagedTask</c></param>
+	/// <param name="completion">Native completion callback of the awaiting <c>ManagedTask</c></param>
+	/// <param name="argument">Pointer to the number to square, negative numbers fail the task</param>
+	[UnmanagedCallersOnly]
+	public static unsafe void SquareAsync(IntPtr state, delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> completion, int* argument)
+	{
+		TaskBridge.Complete(Square(*argument), state, completion);
+	}
 
-	/// <summary>
-	/// Receives a managed <c>CustomObject</c> from the hosted managed library
-	/// and calls the passed managed delegate function on the object
-	/// </summary>
-	/// <param name="obj" cref="CustomObject">The object to process</param>
-	/// <param name="callback" cref="ParseCustomObjectFn">Delegate function called on the object passed</param>
-	[LibraryImport("InteropLib")]
-	private static partial void ProcessCustomObject(IntPtr obj, ParseCustomObjectFn callback);
+	private static async Task<int> Square(int value)
+	{
+		await Task.Delay(10);
+
+		if (value < 0)
+			throw new ArgumentOutOfRangeException(nameof(value), "Only positive numbers are supported");
+
+		return value * value;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,24 @@
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Entry point called by the host controller while opening the .NET context
+/// </summary>
+public static class Bootstrap
+{
+	/// <summary>
+	/// Receives the table of native exports, which managed code then calls through raw function pointers
+	/// </summary>
+	/// <param name="exports" cref="NativeExports">Pointer to the native export table</param>
+	/// <returns><c>0</c> if the table is compatible with this assembly, else <c>-1</c></returns>
+	[UnmanagedCallersOnly]
+	public static unsafe int Initialize(NativeExports* exports)
+	{
+		if (exports == null || exports->Version < NativeExports.RequiredVersion || exports->Size < sizeof(NativeExports))
+			return -1;
+
+		InteropLib.Exports = *exports;
+		InteropLib.Exports.SetHandleReleaseCallback(&NativeHandles.FreeGCHandles);
+
+		return 0;
+	}
+};
\ No newline at end of file
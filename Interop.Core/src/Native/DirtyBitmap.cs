@@ -0,0 +1,81 @@
+using System.Numerics;
+
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Dirty bitmap of a shared memory block, one bit per slot, set by native writers.
+/// Consumers <c>Collect</c> it once per tick and only visit the slots that changed since the previous collection.
+/// </summary>
+public readonly unsafe struct DirtyBitmap
+{
+	private readonly ulong* m_Words;
+
+	/// <summary>
+	/// Wraps an existing bitmap
+	/// </summary>
+	/// <param name="address">Address of the bitmap, as published in the native <c>SharedBlock</c></param>
+	/// <param name="wordCount">Number of 64-bit words of the bitmap</param>
+	public DirtyBitmap(IntPtr address, int wordCount)
+	{
+		m_Words = (ulong*)address;
+		WordCount = wordCount;
+	}
+
+	public IntPtr Address => (IntPtr)m_Words;
+
+	public int WordCount { get; }
+
+	/// <summary>
+	/// Moves the dirty bits to the destination and clears them
+	/// </summary>
+	/// <param name="destination">Receives the bits, at least <c>WordCount</c> long</param>
+	/// <returns>The number of dirty slots</returns>
+	public int Collect(Span<ulong> destination)
+	{
+		if (destination.Length < WordCount)
+			throw new ArgumentException($"The destination must hold at least {WordCount} words", nameof(destination));
+
+		fixed (ulong* words = destination)
+			return (int)InteropLib.Exports.CollectDirtySlots(m_Words, (uint)WordCount, words);
+	}
+
+	/// <summary>
+	/// Enumerates the indices of the slots set in collected bits, in increasing order
+	/// </summary>
+	public static Enumerator Enumerate(ReadOnlySpan<ulong> collected) => new(collected);
+
+	public ref struct Enumerator
+	{
+		private readonly ReadOnlySpan<ulong> m_Words;
+		private int m_WordIndex;
+		private ulong m_Bits;
+
+		internal Enumerator(ReadOnlySpan<ulong> words)
+		{
+			m_Words = words;
+			m_WordIndex = -1;
+			m_Bits = 0;
+			Current = -1;
+		}
+
+		public int Current { get; private set; }
+
+		public readonly Enumerator GetEnumerator() => this;
+
+		public bool MoveNext()
+		{
+			while (m_Bits == 0)
+			{
+				if (++m_WordIndex >= m_Words.Length)
+					return false;
+
+				m_Bits = m_Words[m_WordIndex];
+			}
+
+			Current = m_WordIndex * 64 + BitOperations.TrailingZeroCount(m_Bits);
+			m_Bits &= m_Bits - 1;
+
+			return true;
+		}
+	};
+};
\ No newline at end of file
@@ -0,0 +1,66 @@
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Mirror of the native <c>Interop::Memory::Doorbell</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct DoorbellState
+{
+	public uint Sequence;
+	public uint Waiters;
+	public int EventFd;
+	public uint Padding;
+};
+
+/// <summary>
+/// Notification primitive living in shared memory, shared with native code and worker processes.
+/// Consumers read <c>Sequence</c>, check for data and <c>Wait</c> on the value read; producers publish data then <c>Ring</c>.
+/// </summary>
+public readonly unsafe struct Doorbell
+{
+	private readonly DoorbellState* m_State;
+
+	/// <summary>
+	/// Wraps an existing doorbell
+	/// </summary>
+	/// <param name="address">Address of the doorbell in the shared memory map</param>
+	public Doorbell(IntPtr address) => m_State = (DoorbellState*)address;
+
+	/// <summary>
+	/// Reserves a new doorbell in the shared memory map
+	/// </summary>
+	/// <param name="eventFd">Whether to also signal an eventfd on every ring (Linux only)</param>
+	/// <returns>The doorbell, with a null <c>Address</c> if the shared memory map is full</returns>
+	public static Doorbell Reserve(bool eventFd = false) => new((IntPtr)InteropLib.Exports.ReserveDoorbell(eventFd ? (byte)1 : (byte)0));
+
+	public IntPtr Address => (IntPtr)m_State;
+
+	/// <summary>
+	/// Current sequence, to read before checking for data and pass to <c>Wait</c>
+	/// </summary>
+	public uint Sequence => Volatile.Read(ref m_State->Sequence);
+
+	/// <summary>
+	/// Descriptor signaled on every ring, for epoll integration, or <c>-1</c>
+	/// </summary>
+	public int EventFd => m_State->EventFd;
+
+	/// <summary>
+	/// Wakes every consumer waiting on the doorbell
+	/// </summary>
+	public void Ring() => InteropLib.Exports.RingDoorbell(m_State);
+
+	/// <summary>
+	/// Spins, then sleeps until the doorbell rings or the timeout expires
+	/// </summary>
+	/// <param name="observed">Sequence read before checking for data</param>
+	/// <param name="timeout">Timeout in milliseconds</param>
+	/// <returns><c>true</c> if the doorbell rang since <c>observed</c> was read</returns>
+	public bool Wait(uint observed, uint timeout)
+	{
+		if (Volatile.Read(ref m_State->Sequence) != observed)
+			return true;
+
+		return InteropLib.Exports.WaitDoorbell(m_State, observed, timeout) != 0;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,165 @@
+using System.Runtime;
+
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Mirror of the native <c>Interop::NetCore::GcStats</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct GcStats
+{
+	public fixed uint Collections[3];
+	public int LatencyMode;
+
+	public ulong PauseDuration;
+	public ulong AllocatedBytes;
+};
+
+/// <summary>
+/// Mirror of the native <c>Interop::NetCore::GcRegionRequest</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct GcRegionRequest
+{
+	public ulong AllocationBudget;
+	public int FallbackLatencyMode;
+	public uint Padding;
+
+	public GcStats* Stats;
+};
+
+/// <summary>
+/// Entry points called by <c>Controller::EnterGcRegion</c> and <c>Controller::ExitGcRegion</c>, keeping the GC
+/// out of latency-critical sections that cross the boundary, and reporting whether it stayed out
+/// </summary>
+public static unsafe class GcRegion
+{
+	private const int c_NoFallback = -1;
+
+	private static readonly object s_Lock = new();
+
+	private static bool s_Entered;
+	private static bool s_NoGCRegion; // Else only the latency mode changed
+	private static GCLatencyMode s_PreviousMode;
+	private static int s_StartCollections;
+
+	/// <summary>
+	/// Enters a no-GC region of the budget requested, or switches to the fallback latency mode when the runtime cannot commit it
+	/// </summary>
+	/// <param name="request" cref="GcRegionRequest">Pointer to the request</param>
+	/// <returns><c>0</c> once in the section, <c>-1</c> for invalid requests, <c>-2</c> if a section is already open, <c>-3</c> if the budget cannot be committed and there is no fallback</returns>
+	[UnmanagedCallersOnly]
+	public static int Enter(GcRegionRequest* request)
+	{
+		if (request == null || request->AllocationBudget == 0 || request->AllocationBudget > long.MaxValue)
+			return -1;
+
+		lock (s_Lock)
+		{
+			if (s_Entered)
+				return -2;
+
+			s_PreviousMode = GCSettings.LatencyMode;
+			s_NoGCRegion = TryStartNoGCRegion((long)request->AllocationBudget);
+
+			if (!s_NoGCRegion)
+			{
+				if (request->FallbackLatencyMode == c_NoFallback)
+					return -3;
+
+				GCSettings.LatencyMode = (GCLatencyMode)request->FallbackLatencyMode;
+			}
+
+			// Counted once the region is committed: starting it may collect to make room for the budget
+			s_StartCollections = GC.CollectionCount(0);
+			s_Entered = true;
+
+			if (request->Stats != null)
+				ReadStats(request->Stats);
+
+			return 0;
+		}
+	}
+
+	/// <summary>
+	/// Leaves the section entered last and restores the previous latency mode
+	/// </summary>
+	/// <param name="request" cref="GcRegionRequest">Pointer to the request, only its stats are used</param>
+	/// <returns><c>0</c> if no collection happened in the section, <c>1</c> if some did, <c>-1</c> if no section is open</returns>
+	[UnmanagedCallersOnly]
+	public static int Exit(GcRegionRequest* request)
+	{
+		lock (s_Lock)
+		{
+			if (!s_Entered)
+				return -1;
+
+			bool collected = GC.CollectionCount(0) != s_StartCollections;
+
+			if (s_NoGCRegion)
+			{
+				// Throws when the budget was exceeded or a collection was induced, the region is over either way
+				try
+				{
+					GC.EndNoGCRegion();
+				}
+				catch (InvalidOperationException)
+				{
+					collected = true;
+				}
+			}
+
+			else
+				GCSettings.LatencyMode = s_PreviousMode;
+
+			s_Entered = false;
+
+			if (request != null && request->Stats != null)
+				ReadStats(request->Stats);
+
+			return collected ? 1 : 0;
+		}
+	}
+
+	/// <summary>
+	/// Snapshots the GC counters
+	/// </summary>
+	/// <returns><c>0</c>, or <c>-1</c> if no stats are provided</returns>
+	[UnmanagedCallersOnly]
+	public static int GetStats(GcStats* stats)
+	{
+		if (stats == null)
+			return -1;
+
+		ReadStats(stats);
+		return 0;
+	}
+
+	private static bool TryStartNoGCRegion(long budget)
+	{
+		try
+		{
+			return GC.TryStartNoGCRegion(budget);
+		}
+		catch (ArgumentOutOfRangeException)
+		{
+			// Larger than the ephemeral segment
+			return false;
+		}
+		catch (InvalidOperationException)
+		{
+			// Already in a region started by managed code
+			return false;
+		}
+	}
+
+	private static void ReadStats(GcStats* stats)
+	{
+		for (int generation = 0; generation < 3; generation++)
+			stats->Collections[generation] = (uint)GC.CollectionCount(generation);
+
+		stats->LatencyMode = (int)GCSettings.LatencyMode;
+		stats->PauseDuration = (ulong)GC.GetTotalPauseDuration().Ticks * 100;
+		stats->AllocatedBytes = (ulong)GC.GetTotalAllocatedBytes();
+	}
+};
\ No newline at end of file
@@ -0,0 +1,157 @@
+using System.Buffers;
+
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Mirror of the native <c>Interop::Buffers::Buffer</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct BufferHeader
+{
+	public IntPtr Data;
+	public ulong Size;
+
+	public uint References;
+	public uint Storage;
+
+	public uint Offset;
+
+	public IntPtr Callback;
+	public IntPtr Context;
+};
+
+/// <summary>
+/// Reference-counted native buffer exposed as <c>Memory&lt;byte&gt;</c>, so that large payloads cross the
+/// boundary at the cost of a pointer instead of being copied in and out of managed arrays.
+/// Each instance owns one reference, dropped on <c>Dispose</c>: native code keeps the buffer alive
+/// for as long as it holds references of its own, whatever managed code does with its instance.
+/// There is no finalizer, spans may outlive the instance they come from: an instance never disposed leaks its reference.
+/// </summary>
+public sealed unsafe class NativeBuffer : MemoryManager<byte>
+{
+	private readonly BufferHeader* m_Buffer;
+	private int m_Owned = 1; // Cleared once the reference of this instance is released or detached
+
+	private NativeBuffer(BufferHeader* buffer)
+	{
+		ulong size = buffer->Size;
+
+		if (size > int.MaxValue)
+		{
+			InteropLib.Exports.ReleaseBuffer(buffer);
+			throw new ArgumentOutOfRangeException(nameof(buffer), $"Buffers of {size} bytes do not fit in a Memory<byte>");
+		}
+
+		m_Buffer = buffer;
+	}
+
+	/// <summary>
+	/// Allocates a buffer on the native heap
+	/// </summary>
+	/// <exception cref="OutOfMemoryException">The native heap is exhausted</exception>
+	public static NativeBuffer Alloc(int size)
+	{
+		ArgumentOutOfRangeException.ThrowIfNegative(size);
+
+		BufferHeader* buffer = InteropLib.Exports.CreateBuffer((ulong)size);
+		return buffer != null ? new NativeBuffer(buffer) : throw new OutOfMemoryException($"Unable to allocate a native buffer of {size} bytes");
+	}
+
+	/// <summary>
+	/// Allocates a buffer in the slab heap of the shared memory map, readable by every process attached to it through <c>SharedOffset</c>
+	/// </summary>
+	/// <exception cref="OutOfMemoryException">The slab heap is exhausted or missing</exception>
+	public static NativeBuffer AllocShared(int size)
+	{
+		ArgumentOutOfRangeException.ThrowIfNegativeOrZero(size);
+		ArgumentOutOfRangeException.ThrowIfGreaterThan(size, SharedHeap.MaxSize);
+
+		BufferHeader* buffer = InteropLib.Exports.CreateSharedBuffer((uint)size);
+		return buffer != null ? new NativeBuffer(buffer) : throw new OutOfMemoryException($"Unable to allocate a shared buffer of {size} bytes");
+	}
+
+	/// <summary>
+	/// Takes over a reference transferred by native code, which must not release it anymore
+	/// </summary>
+	public static NativeBuffer Adopt(IntPtr buffer)
+	{
+		ArgumentNullException.ThrowIfNull((void*)buffer, nameof(buffer));
+		return new NativeBuffer((BufferHeader*)buffer);
+	}
+
+	/// <summary>
+	/// Acquires a reference of its own on a buffer lent by native code, to keep it past the call
+	/// </summary>
+	public static NativeBuffer Share(IntPtr buffer)
+	{
+		ArgumentNullException.ThrowIfNull((void*)buffer, nameof(buffer));
+
+		InteropLib.Exports.AcquireBuffer((BufferHeader*)buffer);
+		return new NativeBuffer((BufferHeader*)buffer);
+	}
+
+	/// <summary>
+	/// Data of a buffer lent by native code, only valid for the duration of the call
+	/// </summary>
+	public static Span<byte> Borrow(IntPtr buffer)
+	{
+		BufferHeader* header = (BufferHeader*)buffer;
+		return new Span<byte>((void*)header->Data, checked((int)header->Size));
+	}
+
+	/// <summary>
+	/// Address of the native buffer, to lend it to native code
+	/// </summary>
+	public IntPtr Handle => (IntPtr)GetBuffer();
+
+	public int Length => (int)GetBuffer()->Size;
+
+	/// <summary>
+	/// Offset of the data in the shared memory map, <c>SharedHeap.Null</c> for buffers of the native heap
+	/// </summary>
+	public uint SharedOffset => GetBuffer()->Offset;
+
+	/// <summary>
+	/// Gives the reference of this instance away, to transfer it to native code. The instance is disposed.
+	/// </summary>
+	public IntPtr Detach()
+	{
+		ObjectDisposedException.ThrowIf(Interlocked.Exchange(ref m_Owned, 0) == 0, this);
+		return (IntPtr)m_Buffer;
+	}
+
+	public override Span<byte> GetSpan()
+	{
+		BufferHeader* buffer = GetBuffer();
+		return new Span<byte>((void*)buffer->Data, (int)buffer->Size);
+	}
+
+	/// <summary>
+	/// Native memory never moves, pinning only keeps a reference until <c>Unpin</c>
+	/// </summary>
+	public override MemoryHandle Pin(int elementIndex = 0)
+	{
+		BufferHeader* buffer = GetBuffer();
+		ArgumentOutOfRangeException.ThrowIfGreaterThan((uint)elementIndex, (uint)buffer->Size, nameof(elementIndex));
+
+		InteropLib.Exports.AcquireBuffer(buffer);
+		return new MemoryHandle((byte*)buffer->Data + elementIndex, default, this);
+	}
+
+	/// <summary>
+	/// Drops the reference taken by <c>Pin</c>, pins may outlive the instance
+	/// </summary>
+	public override void Unpin() => InteropLib.Exports.ReleaseBuffer(m_Buffer);
+
+	protected override void Dispose(bool disposing)
+	{
+		if (Interlocked.Exchange(ref m_Owned, 0) != 0)
+			InteropLib.Exports.ReleaseBuffer(m_Buffer);
+	}
+
+	private BufferHeader* GetBuffer()
+	{
+		ObjectDisposedException.ThrowIf(m_Owned == 0, this);
+		return m_Buffer;
+	}
+};
\ No newline at end of file
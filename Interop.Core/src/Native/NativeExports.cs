@@ -0,0 +1,275 @@
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Mirror of the native <c>Interop::NetCore::Api::NativeExports</c> table.
+/// The layout is append-only: new exports go at the end and bump <c>RequiredVersion</c>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct NativeExports
+{
+	/// <summary>
+	/// Minimum native table version this assembly knows how to read
+	/// </summary>
+	public const uint RequiredVersion = 11;
+
+	public uint Version;
+	public uint Size;
+
+	/// <summary>
+	/// Prints the properties of a <c>CustomObject</c> from native code
+	/// </summary>
+	public delegate* unmanaged<IntPtr, void> PrintHostedObjProperties;
+
+	/// <summary>
+	/// Calls the managed callback provided on a <c>CustomObject</c> from native code
+	/// </summary>
+	public delegate* unmanaged<IntPtr, delegate* unmanaged<IntPtr, void>, void> ProcessCustomObject;
+
+	/// <summary>
+	/// Empty native function, trivial enough to skip the GC transition
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<IntPtr, void> BenchmarkNoop;
+
+	// Version 2, compact handles keeping 8 bits of generation, superseded by the version 11 exports
+
+	/// <summary>
+	/// Allocates a compact native handle for each GCHandle provided, all or nothing
+	/// </summary>
+	public delegate* unmanaged<HandleTarget*, uint, uint*, uint> AllocateCompactHandles;
+
+	/// <summary>
+	/// Releases compact native handles, handing their GCHandles back to <c>NativeHandles</c> to be freed
+	/// </summary>
+	public delegate* unmanaged<uint*, uint, uint> ReleaseCompactHandles;
+
+	/// <summary>
+	/// Lock-free lookup of the GCHandle behind a compact native handle, <c>0</c> if stale
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<uint, IntPtr> ResolveCompactHandle;
+
+	/// <summary>
+	/// Lock-free lookup of the pinned data behind a compact native handle, <c>0</c> if stale or not pinned
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<uint, IntPtr> GetCompactHandleAddress;
+
+	/// <summary>
+	/// Registers the managed function freeing the GCHandles of released native handles
+	/// </summary>
+	public delegate* unmanaged<delegate* unmanaged<IntPtr*, uint, void>, void> SetHandleReleaseCallback;
+
+	// Version 3
+
+	/// <summary>
+	/// Reserves a doorbell in shared memory, optionally backed by an eventfd
+	/// </summary>
+	public delegate* unmanaged<byte, DoorbellState*> ReserveDoorbell;
+
+	/// <summary>
+	/// Bumps the doorbell sequence and wakes its waiters
+	/// </summary>
+	public delegate* unmanaged<DoorbellState*, void> RingDoorbell;
+
+	/// <summary>
+	/// Spins then sleeps until the doorbell sequence moves away from the observed value, <c>1</c> if it rang
+	/// </summary>
+	public delegate* unmanaged<DoorbellState*, uint, uint, byte> WaitDoorbell;
+
+	// Version 4, all of them short and non-blocking
+
+	/// <summary>
+	/// Length of a null-terminated string stored in a fixed-size field
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<byte*, uint, uint> GetTextLength;
+
+	/// <summary>
+	/// Strict UTF-8 validation, <c>1</c> if valid
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<byte*, uint, byte> ValidateUtf8Text;
+
+	/// <summary>
+	/// UTF-8 to UTF-16 transcoding, returns the number of chars written or <c>-1</c>
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<byte*, uint, char*, uint, int> TranscodeUtf8ToUtf16;
+
+	/// <summary>
+	/// UTF-16 to UTF-8 transcoding, returns the number of bytes written or <c>-1</c>
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<char*, uint, byte*, uint, int> TranscodeUtf16ToUtf8;
+
+	/// <summary>
+	/// Copies UTF-8 into a fixed-size field, truncating on a code point boundary and null-terminating
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<byte*, uint, byte*, uint, uint> CopyTextBounded;
+
+	// Version 5, per-thread scratch arena, only reaching the heap when a chunk fills up
+
+	/// <summary>
+	/// Bump allocation from the scratch arena of the calling thread. Keeps the GC transition:
+	/// a full chunk falls back to the heap, which may block
+	/// </summary>
+	public delegate* unmanaged<uint, uint, IntPtr> AllocateScratch;
+
+	/// <summary>
+	/// Current position of the scratch arena of the calling thread
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<ulong> GetScratchMark;
+
+	/// <summary>
+	/// Releases everything allocated by the calling thread since the mark provided
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<ulong, void> ResetScratch;
+
+	/// <summary>
+	/// Statistics of the scratch arena of the calling thread
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<ScratchStats*, void> GetScratchStats;
+
+	// Version 6
+
+	/// <summary>
+	/// Moves the bits of a dirty bitmap to the destination and clears them, returns the number of dirty slots
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<ulong*, uint, ulong*, uint> CollectDirtySlots;
+
+	// Version 7, slab heap of the shared memory map, lock-free
+
+	/// <summary>
+	/// Allocates from the slab heap, returns the offset of the block in the shared memory map or <c>0</c>
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<uint, uint> SharedAlloc;
+
+	/// <summary>
+	/// Returns a block to the slab heap
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<uint, void> SharedFree;
+
+	/// <summary>
+	/// Address of an offset of the shared memory map in this process
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<uint, IntPtr> ResolveSharedOffset;
+
+	/// <summary>
+	/// Usable size of a slab heap block, <c>0</c> if the offset is not one
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<uint, uint> GetSharedAllocationSize;
+
+	// Version 8, reference-counted buffers
+
+	/// <summary>
+	/// Creates a buffer on the native heap, owning a single reference, <c>null</c> if out of memory
+	/// </summary>
+	public delegate* unmanaged<ulong, BufferHeader*> CreateBuffer;
+
+	/// <summary>
+	/// Creates a buffer in the slab heap of the shared memory map, owning a single reference, <c>null</c> if out of memory.
+	/// Keeps the GC transition: its header comes from the process heap and the first call sets up the slab heap under a lock
+	/// </summary>
+	public delegate* unmanaged<uint, BufferHeader*> CreateSharedBuffer;
+
+	/// <summary>
+	/// Adds a reference to a buffer
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<BufferHeader*, void> AcquireBuffer;
+
+	/// <summary>
+	/// Drops a reference to a buffer, destroying it with the last one, returns the number of references left
+	/// </summary>
+	public delegate* unmanaged<BufferHeader*, uint> ReleaseBuffer;
+
+	// Version 9, robust locks of the shared memory map, the blocking ones keep the GC transition
+
+	/// <summary>
+	/// Reserves a mutex in the shared memory map, <c>null</c> if the map is full
+	/// </summary>
+	public delegate* unmanaged<SharedMutexState*> ReserveSharedMutex;
+
+	/// <summary>
+	/// Acquires a mutex if it is free, returns a <c>LockResult</c>
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<SharedMutexState*, uint> TryLockSharedMutex;
+
+	/// <summary>
+	/// Spins, then sleeps until a mutex is acquired or the timeout (ms) expires, returns a <c>LockResult</c>
+	/// </summary>
+	public delegate* unmanaged<SharedMutexState*, uint, uint> LockSharedMutex;
+
+	/// <summary>
+	/// Releases a mutex, waking one waiter if there are any
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<SharedMutexState*, void> UnlockSharedMutex;
+
+	/// <summary>
+	/// Reserves a reader/writer lock in the shared memory map, <c>null</c> if the map is full
+	/// </summary>
+	public delegate* unmanaged<SharedRwLockState*> ReserveSharedRwLock;
+
+	/// <summary>
+	/// Acquires a reader/writer lock for reading if no writer holds or waits for it, returns a <c>LockResult</c>
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<SharedRwLockState*, uint> TryLockSharedRead;
+
+	/// <summary>
+	/// Acquires a reader/writer lock for reading or gives up after the timeout (ms), returns a <c>LockResult</c>
+	/// </summary>
+	public delegate* unmanaged<SharedRwLockState*, uint, uint> LockSharedRead;
+
+	/// <summary>
+	/// Releases a reader/writer lock held for reading
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<SharedRwLockState*, void> UnlockSharedRead;
+
+	/// <summary>
+	/// Acquires a reader/writer lock for writing if nobody holds it, returns a <c>LockResult</c>
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<SharedRwLockState*, uint> TryLockSharedWrite;
+
+	/// <summary>
+	/// Acquires a reader/writer lock for writing or gives up after the timeout (ms), returns a <c>LockResult</c>
+	/// </summary>
+	public delegate* unmanaged<SharedRwLockState*, uint, uint> LockSharedWrite;
+
+	/// <summary>
+	/// Releases a reader/writer lock held for writing
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<SharedRwLockState*, void> UnlockSharedWrite;
+
+	// Version 10
+
+	/// <summary>
+	/// Invalidates the native result caches of a function, every cache for <c>null</c>, returns the number of caches invalidated
+	/// </summary>
+	public delegate* unmanaged<byte*, uint> InvalidateResultCache;
+
+	// Version 11, 64-bit handles
+
+	/// <summary>
+	/// Allocates a native handle for each GCHandle provided, all or nothing
+	/// </summary>
+	public delegate* unmanaged<HandleTarget*, uint, ulong*, uint> AllocateHandles;
+
+	/// <summary>
+	/// Releases native handles, handing their GCHandles back to <c>NativeHandles</c> to be freed
+	/// </summary>
+	public delegate* unmanaged<ulong*, uint, uint> ReleaseHandles;
+
+	/// <summary>
+	/// Lock-free lookup of the GCHandle behind a native handle, <c>0</c> if stale
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<ulong, IntPtr> ResolveHandle;
+
+	/// <summary>
+	/// Lock-free lookup of the pinned data behind a native handle, <c>0</c> if stale or not pinned
+	/// </summary>
+	public delegate* unmanaged[SuppressGCTransition]<ulong, IntPtr> GetHandleAddress;
+};
+
+/// <summary>
+/// Native exports received from the host at startup
+/// </summary>
+public static class InteropLib
+{
+	/// <summary>
+	/// The native function table, valid once <c>Bootstrap.Initialize</c> succeeded
+	/// </summary>
+	public static NativeExports Exports;
+};
\ No newline at end of file
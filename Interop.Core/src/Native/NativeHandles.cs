@@ -0,0 +1,143 @@
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Mirror of the native <c>Interop::Handles::HandleTarget</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct HandleTarget
+{
+	public IntPtr GCHandle;
+	public IntPtr Address;
+};
+
+/// <summary>
+/// 64-bit handles to managed objects, stored in the native handle table so that native code
+/// can keep long-lived references to managed objects and pass them back without copying them.
+/// A released handle is never resolved again: its 32-bit generation no longer matches the table slot.
+/// The GCHandle behind a handle is freed as soon as it is released, so the code releasing a handle must own it:
+/// no other thread may be resolving it at the same time.
+/// </summary>
+public static unsafe class NativeHandles
+{
+	/// <summary>
+	/// Value never returned for a live handle
+	/// </summary>
+	public const ulong Invalid = 0;
+
+	private const int c_BatchSize = 256;
+
+	/// <summary>
+	/// Allocates a native handle referencing the object provided
+	/// </summary>
+	/// <param name="target">The object to reference</param>
+	/// <param name="type">Pinned handles also expose the address of the object data to native code</param>
+	/// <returns>The native handle, or <c>NativeHandles.Invalid</c> if the table is full</returns>
+	public static ulong Alloc(object target, GCHandleType type = GCHandleType.Normal)
+	{
+		ulong handle = Invalid;
+		Alloc(new ReadOnlySpan<object>(in target), new Span<ulong>(ref handle), type);
+
+		return handle;
+	}
+
+	/// <summary>
+	/// Allocates a native handle for each object provided, in batches
+	/// </summary>
+	/// <param name="targets">The objects to reference</param>
+	/// <param name="handles">Receives the native handles, at least as long as <c>targets</c></param>
+	/// <param name="type">Pinned handles also expose the address of the object data to native code</param>
+	/// <returns>The number of handles allocated, short of <c>targets.Length</c> if the table is full</returns>
+	public static int Alloc(ReadOnlySpan<object> targets, Span<ulong> handles, GCHandleType type = GCHandleType.Normal)
+	{
+		if (handles.Length < targets.Length)
+			throw new ArgumentException("The handle span is shorter than the target span", nameof(handles));
+
+		HandleTarget* batch = stackalloc HandleTarget[c_BatchSize];
+		int allocated = 0;
+
+		while (allocated < targets.Length)
+		{
+			int count = Math.Min(c_BatchSize, targets.Length - allocated);
+
+			for (int i = 0; i < count; i++)
+			{
+				GCHandle gcHandle;
+
+				try
+				{
+					gcHandle = GCHandle.Alloc(targets[allocated + i], type);
+				}
+				catch
+				{
+					for (int j = 0; j < i; j++)
+						GCHandle.FromIntPtr(batch[j].GCHandle).Free();
+
+					throw;
+				}
+
+				batch[i].GCHandle = GCHandle.ToIntPtr(gcHandle);
+				batch[i].Address = type == GCHandleType.Pinned ? gcHandle.AddrOfPinnedObject() : IntPtr.Zero;
+			}
+
+			fixed (ulong* output = handles.Slice(allocated))
+			{
+				if (InteropLib.Exports.AllocateHandles(batch, (uint)count, output) == 0)
+				{
+					for (int i = 0; i < count; i++)
+						GCHandle.FromIntPtr(batch[i].GCHandle).Free();
+
+					break;
+				}
+			}
+
+			allocated += count;
+		}
+
+		return allocated;
+	}
+
+	/// <summary>
+	/// Retrieves the object referenced by a native handle
+	/// </summary>
+	/// <param name="handle">The native handle</param>
+	/// <returns>The object, or <c>null</c> if the handle is stale or invalid</returns>
+	public static object? Resolve(ulong handle)
+	{
+		IntPtr gcHandle = InteropLib.Exports.ResolveHandle(handle);
+
+		return gcHandle == IntPtr.Zero ? null : GCHandle.FromIntPtr(gcHandle).Target;
+	}
+
+	/// <inheritdoc cref="Resolve(ulong)"/>
+	public static T? Resolve<T>(ulong handle) where T : class => Resolve(handle) as T;
+
+	/// <summary>
+	/// Releases a native handle and the GCHandle behind it
+	/// </summary>
+	/// <param name="handle">The native handle</param>
+	/// <returns><c>true</c> if the handle was live, else <c>false</c></returns>
+	public static bool Free(ulong handle) => InteropLib.Exports.ReleaseHandles(&handle, 1) == 1;
+
+	/// <summary>
+	/// Releases native handles and the GCHandles behind them, skipping stale or invalid ones
+	/// </summary>
+	/// <param name="handles">The native handles</param>
+	/// <returns>The number of handles released</returns>
+	public static int Free(ReadOnlySpan<ulong> handles)
+	{
+		fixed (ulong* input = handles)
+			return (int)InteropLib.Exports.ReleaseHandles(input, (uint)handles.Length);
+	}
+
+	/// <summary>
+	/// Release callback of the native handle table, called in batches whichever side released the handles
+	/// </summary>
+	/// <param name="gcHandles">The GCHandles of the released native handles</param>
+	/// <param name="count">The number of GCHandles</param>
+	[UnmanagedCallersOnly]
+	internal static void FreeGCHandles(IntPtr* gcHandles, uint count)
+	{
+		for (uint i = 0; i < count; i++)
+			GCHandle.FromIntPtr(gcHandles[i]).Free();
+	}
+};
\ No newline at end of file
@@ -0,0 +1,115 @@
+using System.Buffers;
+
+namespace Interop.Core.Native;
+
+/// <summary>
+/// SIMD-accelerated text helpers of InteropLib, writing into caller-provided buffers so that
+/// fixed-size text fields cross the boundary without marshalling nor managed string allocations
+/// </summary>
+public static unsafe class NativeText
+{
+	private const int c_MaxStackScratch = 1024;
+
+	/// <summary>
+	/// Length of the null-terminated string stored in a fixed-size field
+	/// </summary>
+	/// <param name="field">The field, as stored in native memory</param>
+	/// <returns>The length in bytes, or the field length if it is not terminated</returns>
+	public static int Length(ReadOnlySpan<byte> field)
+	{
+		fixed (byte* text = field)
+			return (int)InteropLib.Exports.GetTextLength(text, (uint)field.Length);
+	}
+
+	/// <summary>
+	/// Strict UTF-8 validation (no overlong encodings, surrogates nor code points above U+10FFFF)
+	/// </summary>
+	public static bool IsValidUtf8(ReadOnlySpan<byte> text)
+	{
+		fixed (byte* bytes = text)
+			return InteropLib.Exports.ValidateUtf8Text(bytes, (uint)text.Length) != 0;
+	}
+
+	/// <summary>
+	/// Transcodes UTF-8 to UTF-16
+	/// </summary>
+	/// <returns>The number of chars written, or <c>-1</c> if the input is invalid or the destination too small</returns>
+	public static int Utf8ToUtf16(ReadOnlySpan<byte> source, Span<char> destination)
+	{
+		fixed (byte* src = source)
+		fixed (char* dst = destination)
+			return InteropLib.Exports.TranscodeUtf8ToUtf16(src, (uint)source.Length, dst, (uint)destination.Length);
+	}
+
+	/// <summary>
+	/// Transcodes UTF-16 to UTF-8
+	/// </summary>
+	/// <returns>The number of bytes written, or <c>-1</c> if the input is invalid or the destination too small</returns>
+	public static int Utf16ToUtf8(ReadOnlySpan<char> source, Span<byte> destination)
+	{
+		fixed (char* src = source)
+		fixed (byte* dst = destination)
+			return InteropLib.Exports.TranscodeUtf16ToUtf8(src, (uint)source.Length, dst, (uint)destination.Length);
+	}
+
+	/// <summary>
+	/// Decodes the null-terminated UTF-8 string stored in a fixed-size field
+	/// </summary>
+	/// <param name="field">The field, as stored in native memory</param>
+	/// <param name="destination">Receives the text, at least as long as the field to always fit</param>
+	/// <returns>The number of chars written, or <c>-1</c> if the text is invalid or the destination too small</returns>
+	public static int GetString(ReadOnlySpan<byte> field, Span<char> destination)
+	{
+		fixed (byte* src = field)
+		fixed (char* dst = destination)
+		{
+			uint length = InteropLib.Exports.GetTextLength(src, (uint)field.Length);
+			return InteropLib.Exports.TranscodeUtf8ToUtf16(src, length, dst, (uint)destination.Length);
+		}
+	}
+
+	/// <summary>
+	/// Encodes text into a fixed-size field, truncating on a code point boundary and always null-terminating
+	/// </summary>
+	/// <param name="text">The text to store</param>
+	/// <param name="field">The field, as stored in native memory</param>
+	/// <returns>The number of bytes written without the terminator, or <c>-1</c> if the text is invalid UTF-16</returns>
+	public static int SetString(ReadOnlySpan<char> text, Span<byte> field)
+	{
+		if (field.IsEmpty)
+			return text.IsEmpty ? 0 : -1;
+
+		fixed (char* src = text)
+		fixed (byte* dst = field)
+		{
+			int written = InteropLib.Exports.TranscodeUtf16ToUtf8(src, (uint)text.Length, dst, (uint)field.Length - 1);
+
+			if (written >= 0)
+			{
+				dst[written] = 0;
+				return written;
+			}
+
+			// Either invalid or too long: go through a scratch buffer large enough for any text, then truncate
+			int scratchSize = text.Length * 3;
+			byte[]? rented = scratchSize > c_MaxStackScratch ? ArrayPool<byte>.Shared.Rent(scratchSize) : null;
+			Span<byte> scratch = rented ?? stackalloc byte[c_MaxStackScratch];
+
+			try
+			{
+				fixed (byte* tmp = scratch)
+				{
+					written = InteropLib.Exports.TranscodeUtf16ToUtf8(src, (uint)text.Length, tmp, (uint)scratch.Length);
+					if (written < 0) return -1;
+
+					return (int)InteropLib.Exports.CopyTextBounded(dst, (uint)field.Length, tmp, (uint)written);
+				}
+			}
+			finally
+			{
+				if (rented != null)
+					ArrayPool<byte>.Shared.Return(rented);
+			}
+		}
+	}
+};
\ No newline at end of file
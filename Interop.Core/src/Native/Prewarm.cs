@@ -0,0 +1,151 @@
+using System.Reflection;
+using System.Runtime.CompilerServices;
+
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Mirror of the native <c>Interop::NetCore::PrewarmStatus</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct PrewarmStatus
+{
+	public DoorbellState Completed;
+
+	public uint State;
+	public uint Prepared;
+	public uint Failed;
+	public uint Padding;
+};
+
+/// <summary>
+/// Mirror of the native <c>Interop::NetCore::PrewarmRequest</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct PrewarmRequest
+{
+	public byte** Methods;
+	public uint MethodCount;
+	public uint Padding;
+
+	public PrewarmStatus* Status;
+};
+
+/// <summary>
+/// Entry point called by <c>Controller::StartPrewarm</c>, compiling methods ahead of their first call
+/// on a background thread so that latency-critical threads never wait on the JIT
+/// </summary>
+public static unsafe class Prewarm
+{
+	private const uint c_StateDone = 2;
+
+	private const BindingFlags c_AllMethods = BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Static | BindingFlags.Instance | BindingFlags.DeclaredOnly;
+
+	/// <summary>
+	/// Copies the method names requested and compiles them on a background thread, reporting to the status provided
+	/// </summary>
+	/// <param name="request" cref="PrewarmRequest">Pointer to the request</param>
+	/// <returns><c>0</c> once the background thread started, else <c>-1</c></returns>
+	[UnmanagedCallersOnly]
+	public static int Start(PrewarmRequest* request)
+	{
+		if (request == null || request->Status == null || (request->Methods == null && request->MethodCount > 0))
+			return -1;
+
+		string[] methods = new string[request->MethodCount];
+
+		for (int i = 0; i < methods.Length; i++)
+			methods[i] = Marshal.PtrToStringUTF8((IntPtr)request->Methods[i]) ?? string.Empty;
+
+		PrewarmStatus* status = request->Status;
+
+		Thread thread = new(() => Run(methods, status))
+		{
+			IsBackground = true,
+			Priority = ThreadPriority.BelowNormal,
+			Name = "Interop prewarm",
+		};
+
+		thread.Start();
+
+		return 0;
+	}
+
+	private static void Run(string[] methods, PrewarmStatus* status)
+	{
+		foreach (string method in methods)
+		{
+			foreach (bool prepared in PrepareMethods(method))
+				Interlocked.Increment(ref prepared ? ref status->Prepared : ref status->Failed);
+		}
+
+		Volatile.Write(ref status->State, c_StateDone);
+		new Doorbell((IntPtr)(&status->Completed)).Ring();
+	}
+
+	/// <summary>
+	/// Compiles every overload matching "Namespace.Type.Method", or every method of the type for "Namespace.Type.*",
+	/// optionally followed by ", Assembly". Yields the outcome of each compilation, a single failure when nothing matches.
+	/// </summary>
+	private static IEnumerable<bool> PrepareMethods(string method)
+	{
+		Type? type = null;
+		string name = method;
+
+		try
+		{
+			int comma = method.IndexOf(',');
+			Assembly assembly = comma >= 0 ? Assembly.Load(method[(comma + 1)..].Trim()) : typeof(Prewarm).Assembly;
+
+			name = comma >= 0 ? method[..comma].Trim() : method;
+			int dot = name.LastIndexOf('.');
+
+			if (dot > 0)
+			{
+				type = assembly.GetType(name[..dot]);
+				name = name[(dot + 1)..];
+			}
+		}
+		catch (Exception)
+		{
+			type = null;
+		}
+
+		if (type == null)
+		{
+			yield return false;
+			yield break;
+		}
+
+		bool found = false;
+
+		foreach (MethodInfo candidate in type.GetMethods(c_AllMethods))
+		{
+			if (name != "*" && candidate.Name != name)
+				continue;
+
+			found = true;
+
+			// Open generic and abstract methods have no code of their own to compile
+			if (candidate.ContainsGenericParameters || candidate.IsAbstract)
+				continue;
+
+			yield return TryPrepare(candidate.MethodHandle);
+		}
+
+		if (!found)
+			yield return false;
+	}
+
+	private static bool TryPrepare(RuntimeMethodHandle method)
+	{
+		try
+		{
+			RuntimeHelpers.PrepareMethod(method);
+			return true;
+		}
+		catch (Exception)
+		{
+			return false;
+		}
+	}
+};
\ No newline at end of file
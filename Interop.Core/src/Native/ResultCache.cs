@@ -0,0 +1,34 @@
+using System.Text;
+
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Invalidation of the result caches native code keeps in front of pure managed functions.
+/// Cached results are served without entering managed code: invalidate them whenever the data the function reads changes.
+/// </summary>
+public static unsafe class ResultCache
+{
+	private const int c_MaxStackName = 256;
+
+	/// <summary>
+	/// Invalidates the caches in front of a function
+	/// </summary>
+	/// <param name="qualifiedName">"Namespace.Type.Method" of the cached function</param>
+	/// <returns>The number of caches invalidated, <c>0</c> if native code caches none for this function</returns>
+	public static uint Invalidate(string qualifiedName)
+	{
+		int size = Encoding.UTF8.GetByteCount(qualifiedName) + 1;
+		Span<byte> name = size > c_MaxStackName ? new byte[size] : stackalloc byte[c_MaxStackName];
+
+		name[Encoding.UTF8.GetBytes(qualifiedName, name)] = 0;
+
+		fixed (byte* bytes = name)
+			return InteropLib.Exports.InvalidateResultCache(bytes);
+	}
+
+	/// <summary>
+	/// Invalidates every result cache of the process
+	/// </summary>
+	/// <returns>The number of caches invalidated</returns>
+	public static uint InvalidateAll() => InteropLib.Exports.InvalidateResultCache(null);
+};
\ No newline at end of file
@@ -0,0 +1,72 @@
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Mirror of the native <c>Interop::Scratch::ScratchStats</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct ScratchStats
+{
+	public ulong Used;
+	public ulong HighWater;
+	public ulong Reserved;
+	public ulong Allocations;
+	public ulong ChunkAllocations;
+
+	public ulong PeakHighWater;
+};
+
+/// <summary>
+/// Transient native memory from the scratch arena of the calling thread, for buffers handed to native code
+/// for the duration of a call. Everything allocated through the scope is released at once on <c>Dispose</c>.
+/// Being a ref struct, a scope cannot span an <c>await</c> and move to another thread.
+/// </summary>
+public readonly unsafe ref struct ScratchScope
+{
+	private const uint c_DefaultAlignment = 16;
+
+	private readonly ulong m_Mark;
+
+	public ScratchScope() => m_Mark = InteropLib.Exports.GetScratchMark();
+
+	/// <summary>
+	/// Allocates uninitialized native memory
+	/// </summary>
+	/// <returns>The memory, or <c>IntPtr.Zero</c> if the native heap is exhausted</returns>
+	public IntPtr Alloc(int size, int alignment = (int)c_DefaultAlignment) => InteropLib.Exports.AllocateScratch((uint)size, (uint)alignment);
+
+	/// <summary>
+	/// Allocates uninitialized native memory for <c>count</c> values of an unmanaged type
+	/// </summary>
+	public T* Alloc<T>(int count = 1) where T : unmanaged
+		=> (T*)InteropLib.Exports.AllocateScratch((uint)(count * sizeof(T)), c_DefaultAlignment);
+
+	/// <summary>
+	/// Marshals a structure into native memory, as <c>Marshal.StructureToPtr</c> would
+	/// </summary>
+	/// <returns>The native copy, or <c>IntPtr.Zero</c> if the native heap is exhausted</returns>
+	public IntPtr Write<T>(T value) where T : notnull
+	{
+		IntPtr buffer = Alloc(Marshal.SizeOf<T>());
+
+		if (buffer != IntPtr.Zero)
+			Marshal.StructureToPtr(value, buffer, false);
+
+		return buffer;
+	}
+
+	/// <summary>
+	/// Releases everything allocated on this thread since the scope was created
+	/// </summary>
+	public void Dispose() => InteropLib.Exports.ResetScratch(m_Mark);
+
+	/// <summary>
+	/// Statistics of the scratch arena of the calling thread
+	/// </summary>
+	public static ScratchStats GetStats()
+	{
+		ScratchStats stats;
+		InteropLib.Exports.GetScratchStats(&stats);
+
+		return stats;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,69 @@
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Variable-size allocations in the shared memory map, served by the native slab heap.
+/// Allocations are identified by their offset in the map, valid in native code and in every process
+/// attached to it, so strings, blobs and arrays written here cross the boundary without copies.
+/// </summary>
+public static unsafe class SharedHeap
+{
+	/// <summary>
+	/// Offset never returned for a live allocation
+	/// </summary>
+	public const uint Null = 0;
+
+	/// <summary>
+	/// Largest allocation served, one slab page
+	/// </summary>
+	public const int MaxSize = 16384;
+
+	/// <summary>
+	/// Allocates uninitialized shared memory, rounded up to the next power of two
+	/// </summary>
+	/// <returns>The offset of the allocation, or <c>SharedHeap.Null</c> if the heap is exhausted or missing</returns>
+	public static uint Alloc(int size)
+	{
+		ArgumentOutOfRangeException.ThrowIfNegativeOrZero(size);
+		ArgumentOutOfRangeException.ThrowIfGreaterThan(size, MaxSize);
+
+		return InteropLib.Exports.SharedAlloc((uint)size);
+	}
+
+	/// <summary>
+	/// Returns an allocation to the heap, the offset must not be used afterwards by any process
+	/// </summary>
+	public static void Free(uint offset) => InteropLib.Exports.SharedFree(offset);
+
+	/// <summary>
+	/// Copies data into a new allocation
+	/// </summary>
+	/// <returns>The offset of the copy, or <c>SharedHeap.Null</c> if the heap is exhausted or missing</returns>
+	public static uint Copy(ReadOnlySpan<byte> data)
+	{
+		uint offset = Alloc(data.Length);
+
+		if (offset != Null)
+			data.CopyTo(new Span<byte>((void*)InteropLib.Exports.ResolveSharedOffset(offset), data.Length));
+
+		return offset;
+	}
+
+	/// <summary>
+	/// Whole usable memory of an allocation
+	/// </summary>
+	public static Span<byte> GetSpan(uint offset)
+	{
+		uint size = InteropLib.Exports.GetSharedAllocationSize(offset);
+		return size != 0 ? new Span<byte>((void*)InteropLib.Exports.ResolveSharedOffset(offset), (int)size) : Span<byte>.Empty;
+	}
+
+	/// <summary>
+	/// First bytes of an allocation, without checking them against its size
+	/// </summary>
+	public static Span<byte> GetSpan(uint offset, int length) => new((void*)InteropLib.Exports.ResolveSharedOffset(offset), length);
+
+	/// <summary>
+	/// Address of an allocation in this process
+	/// </summary>
+	public static IntPtr GetPointer(uint offset) => InteropLib.Exports.ResolveSharedOffset(offset);
+};
\ No newline at end of file
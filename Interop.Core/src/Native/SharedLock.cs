@@ -0,0 +1,139 @@
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Outcome of acquiring a shared lock, mirror of the native <c>Interop::Memory::LockResult</c>
+/// </summary>
+public enum LockResult : uint
+{
+	Acquired = 0,
+
+	/// <summary>
+	/// Acquired from a writer that died holding the lock, the data it protects may be half-written
+	/// </summary>
+	OwnerDied = 1,
+
+	Timeout = 2,
+};
+
+/// <summary>
+/// Mirror of the native <c>Interop::Memory::SharedMutex</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct SharedMutexState
+{
+	public uint State;
+	public uint Padding;
+};
+
+/// <summary>
+/// Mirror of the native <c>Interop::Memory::SharedRwLock</c>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct SharedRwLockState
+{
+	public uint State;
+	public uint Padding;
+	public ulong Writer;
+	public fixed ulong Readers[16];
+};
+
+/// <summary>
+/// Mutex living in shared memory, shared with native code and worker processes. A waiter takes the mutex over
+/// when its owner died holding it and gets <c>LockResult.OwnerDied</c>, to check or rebuild the protected data.
+/// Locks belong to the native thread: unlock on the thread that locked, never across an <c>await</c>.
+/// </summary>
+public readonly unsafe struct SharedMutex
+{
+	public const uint Infinite = uint.MaxValue;
+
+	private readonly SharedMutexState* m_State;
+
+	/// <summary>
+	/// Wraps an existing mutex
+	/// </summary>
+	/// <param name="address">Address of the mutex in the shared memory map</param>
+	public SharedMutex(IntPtr address) => m_State = (SharedMutexState*)address;
+
+	/// <summary>
+	/// Reserves a new mutex in the shared memory map
+	/// </summary>
+	/// <returns>The mutex, with a null <c>Address</c> if the shared memory map is full</returns>
+	public static SharedMutex Reserve() => new((IntPtr)InteropLib.Exports.ReserveSharedMutex());
+
+	public IntPtr Address => (IntPtr)m_State;
+
+	/// <summary>
+	/// Acquires the mutex if it is free, without blocking
+	/// </summary>
+	public bool TryLock() => InteropLib.Exports.TryLockSharedMutex(m_State) == (uint)LockResult.Acquired;
+
+	/// <summary>
+	/// Spins, then sleeps until the mutex is acquired or the timeout expires
+	/// </summary>
+	/// <param name="timeout">Timeout in milliseconds</param>
+	public LockResult Lock(uint timeout = Infinite)
+	{
+		if (InteropLib.Exports.TryLockSharedMutex(m_State) == (uint)LockResult.Acquired)
+			return LockResult.Acquired;
+
+		return (LockResult)InteropLib.Exports.LockSharedMutex(m_State, timeout);
+	}
+
+	public void Unlock() => InteropLib.Exports.UnlockSharedMutex(m_State);
+};
+
+/// <summary>
+/// Writer-preferring reader/writer lock living in shared memory, shared with native code and worker processes.
+/// Dead writers are taken over like <c>SharedMutex</c> owners; dead readers are dropped by the next writer.
+/// Readers must not take the lock again while holding it: a writer waiting in between would deadlock them.
+/// </summary>
+public readonly unsafe struct SharedRwLock
+{
+	private readonly SharedRwLockState* m_State;
+
+	/// <summary>
+	/// Wraps an existing reader/writer lock
+	/// </summary>
+	/// <param name="address">Address of the lock in the shared memory map</param>
+	public SharedRwLock(IntPtr address) => m_State = (SharedRwLockState*)address;
+
+	/// <summary>
+	/// Reserves a new reader/writer lock in the shared memory map
+	/// </summary>
+	/// <returns>The lock, with a null <c>Address</c> if the shared memory map is full</returns>
+	public static SharedRwLock Reserve() => new((IntPtr)InteropLib.Exports.ReserveSharedRwLock());
+
+	public IntPtr Address => (IntPtr)m_State;
+
+	public bool TryLockRead() => InteropLib.Exports.TryLockSharedRead(m_State) == (uint)LockResult.Acquired;
+
+	/// <summary>
+	/// Acquires the lock for reading, once no writer holds or waits for it
+	/// </summary>
+	/// <param name="timeout">Timeout in milliseconds</param>
+	public LockResult LockRead(uint timeout = SharedMutex.Infinite)
+	{
+		if (InteropLib.Exports.TryLockSharedRead(m_State) == (uint)LockResult.Acquired)
+			return LockResult.Acquired;
+
+		return (LockResult)InteropLib.Exports.LockSharedRead(m_State, timeout);
+	}
+
+	public void UnlockRead() => InteropLib.Exports.UnlockSharedRead(m_State);
+
+	public bool TryLockWrite() => InteropLib.Exports.TryLockSharedWrite(m_State) == (uint)LockResult.Acquired;
+
+	/// <summary>
+	/// Acquires the lock for writing, keeping new readers out while the current ones leave
+	/// </summary>
+	/// <param name="timeout">Timeout in milliseconds</param>
+	public LockResult LockWrite(uint timeout = SharedMutex.Infinite)
+	{
+		if (InteropLib.Exports.TryLockSharedWrite(m_State) == (uint)LockResult.Acquired)
+			return LockResult.Acquired;
+
+		return (LockResult)InteropLib.Exports.LockSharedWrite(m_State, timeout);
+	}
+
+	public void UnlockWrite() => InteropLib.Exports.UnlockSharedWrite(m_State);
+};
\ No newline at end of file
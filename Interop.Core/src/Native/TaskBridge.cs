@@ -0,0 +1,185 @@
+using System.Text.Unicode;
+
+namespace Interop.Core.Native;
+
+/// <summary>
+/// Reports the completion of managed <c>Task</c>s to the native <c>Interop::Tasks::ManagedTask</c> awaiting them.
+/// Async entry points start their <c>Task</c>, hand it to <c>Complete</c> with the state and completion
+/// received from native code, and return right away.
+/// </summary>
+public static unsafe class TaskBridge
+{
+	public const int Succeeded = 1;
+	public const int Failed = 2;
+	public const int Canceled = 3;
+
+	private const int c_ErrorSize = 128;
+	private const int c_PoolSize = 16;
+
+	/// <summary>
+	/// Reports the completion of a <c>Task</c> without a result
+	/// </summary>
+	/// <param name="task">The running or completed task</param>
+	/// <param name="state">Opaque native state, passed back as is</param>
+	/// <param name="completion">Native completion callback</param>
+	public static void Complete(Task task, IntPtr state, delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> completion)
+	{
+		if (task.IsCompleted)
+		{
+			Report(task, state, completion);
+			return;
+		}
+
+		Continuation continuation = Pool<Continuation>.Rent();
+		continuation.Start(task, state, completion);
+	}
+
+	/// <summary>
+	/// Reports the completion of a <c>Task</c> with a blittable result, copied into the native awaiter
+	/// </summary>
+	/// <param name="task">The running or completed task</param>
+	/// <param name="state">Opaque native state, passed back as is</param>
+	/// <param name="completion">Native completion callback</param>
+	public static void Complete<T>(Task<T> task, IntPtr state, delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> completion) where T : unmanaged
+	{
+		if (task.IsCompleted)
+		{
+			Report(task, state, completion);
+			return;
+		}
+
+		Continuation<T> continuation = Pool<Continuation<T>>.Rent();
+		continuation.Start(task, state, completion);
+	}
+
+	/// <summary>
+	/// Small lock-free pool of continuations, falling back to allocations when empty or full
+	/// </summary>
+	private static class Pool<TItem> where TItem : class, new()
+	{
+		private static readonly TItem?[] s_Items = new TItem?[c_PoolSize];
+
+		public static TItem Rent()
+		{
+			for (int i = 0; i < s_Items.Length; i++)
+			{
+				TItem? item = Interlocked.Exchange(ref s_Items[i], null);
+				if (item != null) return item;
+			}
+
+			return new TItem();
+		}
+
+		public static void Return(TItem item)
+		{
+			for (int i = 0; i < s_Items.Length; i++)
+			{
+				if (Interlocked.CompareExchange(ref s_Items[i], item, null) == null)
+					return;
+			}
+		}
+	};
+
+	/// <summary>
+	/// Registered on the task awaiter, which stores the cached <c>Action</c> as is when no context has to be captured:
+	/// a pooled continuation completes an operation without allocating
+	/// </summary>
+	private sealed class Continuation
+	{
+		private readonly Action m_Invoke;
+
+		private Task? m_Task;
+		private IntPtr m_State;
+		private delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> m_Completion;
+
+		public Continuation() => m_Invoke = Invoke;
+
+		public void Start(Task task, IntPtr state, delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> completion)
+		{
+			m_Task = task;
+			m_State = state;
+			m_Completion = completion;
+
+			task.ConfigureAwait(false).GetAwaiter().UnsafeOnCompleted(m_Invoke);
+		}
+
+		private void Invoke()
+		{
+			Task task = m_Task!;
+			IntPtr state = m_State;
+			delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> completion = m_Completion;
+
+			m_Task = null;
+			Pool<Continuation>.Return(this);
+
+			Report(task, state, completion);
+		}
+	};
+
+	/// <inheritdoc cref="Continuation"/>
+	private sealed class Continuation<T> where T : unmanaged
+	{
+		private readonly Action m_Invoke;
+
+		private Task<T>? m_Task;
+		private IntPtr m_State;
+		private delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> m_Completion;
+
+		public Continuation() => m_Invoke = Invoke;
+
+		public void Start(Task<T> task, IntPtr state, delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> completion)
+		{
+			m_Task = task;
+			m_State = state;
+			m_Completion = completion;
+
+			task.ConfigureAwait(false).GetAwaiter().UnsafeOnCompleted(m_Invoke);
+		}
+
+		private void Invoke()
+		{
+			Task<T> task = m_Task!;
+			IntPtr state = m_State;
+			delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> completion = m_Completion;
+
+			m_Task = null;
+			Pool<Continuation<T>>.Return(this);
+
+			Report(task, state, completion);
+		}
+	};
+
+	private static void Report(Task task, IntPtr state, delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> completion)
+	{
+		if (task.IsCompletedSuccessfully)
+			completion(state, Succeeded, null, 0, null);
+
+		else
+			ReportError(task, state, completion);
+	}
+
+	private static void Report<T>(Task<T> task, IntPtr state, delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> completion) where T : unmanaged
+	{
+		if (task.IsCompletedSuccessfully)
+		{
+			T result = task.Result;
+			completion(state, Succeeded, &result, (uint)sizeof(T), null);
+		}
+
+		else
+			ReportError(task, state, completion);
+	}
+
+	private static void ReportError(Task task, IntPtr state, delegate* unmanaged<IntPtr, int, void*, uint, byte*, void> completion)
+	{
+		string message = task.IsCanceled
+			? "The managed task was canceled"
+			: task.Exception?.InnerException?.Message ?? "The managed task failed";
+
+		byte* error = stackalloc byte[c_ErrorSize];
+		Utf8.FromUtf16(message, new Span<byte>(error, c_ErrorSize - 1), out _, out int written);
+		error[written] = 0;
+
+		completion(state, task.IsCanceled ? Canceled : Failed, null, 0, error);
+	}
+};
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Bench
+{
+
+	f64 Percentile(const std::vector<f64>& sorted, f64 percentile)
+	{
+		if (sorted.empty()) return 0.0;
+
+		size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+		return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+	}
+
+	Result Summarize(const char* name, u32 batchSize, std::vector<f64>& samples)
+	{
+		Result result = {};
+		result.Name = name;
+		result.Repetitions = static_cast<u32>(samples.size());
+		result.BatchSize = batchSize;
+
+		if (samples.empty()) return result;
+
+		std::sort(samples.begin(), samples.end());
+
+		f64 sum = 0.0;
+		for (f64 s : samples) sum += s;
+
+		result.Mean = sum / samples.size();
+
+		f64 variance = 0.0;
+		for (f64 s : samples) variance += (s - result.Mean) * (s - result.Mean);
+
+		result.StdDev = samples.size() > 1 ? std::sqrt(variance / (samples.size() - 1)) : 0.0;
+		result.Min = samples.front();
+		result.P50 = Percentile(samples, 50.0);
+		result.P90 = Percentile(samples, 90.0);
+		result.P99 = Percentile(samples, 99.0);
+		result.Max = samples.back();
+
+		return result;
+	}
+
+	void PrintTable(FILE* stream, const std::vector<Result>& results)
+	{
+		fprintf(stream, "%-36s %8s %8s %12s %12s %12s %12s %12s\n", "Benchmark (ns/op)", "Reps", "Batch", "Mean", "StdDev", "P50", "P99", "Max");
+
+		for (const auto& r : results)
+		{
+			fprintf(stream, "%-36s %8u %8u %12.2f %12.2f %12.2f %12.2f %12.2f\n",
+				r.Name.c_str(), r.Repetitions, r.BatchSize, r.Mean, r.StdDev, r.P50, r.P99, r.Max);
+		}
+	}
+
+	b8 WriteJson(const char* path, const std::vector<Result>& results)
+	{
+		FILE* file = fopen(path, "w");
+
+		if (file == nullptr)
+		{
+			printf("Unable to open \"%s\" to write benchmark results\n", path);
+			return false;
+		}
+
+		fprintf(file, "{\n\t\"unit\": \"ns/op\",\n\t\"benchmarks\": [\n");
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const Result& r = results[i];
+
+			fprintf(file, "\t\t{ \"name\": \"%s\", \"repetitions\": %u, \"batch\": %u, \"mean\": %.3f, \"stddev\": %.3f, "
+				"\"min\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f }%s\n",
+				r.Name.c_str(), r.Repetitions, r.BatchSize, r.Mean, r.StdDev, r.Min, r.P50, r.P90, r.P99, r.Max,
+				i + 1 < results.size() ? "," : "");
+		}
+
+		fprintf(file, "\t]\n}\n");
+		fclose(file);
+
+		return true;
+	}
+
+}
\ No newline at end of file
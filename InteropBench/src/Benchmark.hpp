@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Core/Definitions.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+
+	struct Config
+	{
+		u32 Warmup = 5;
+		u32 Repetitions = 50;
+		u32 BatchSize = 1000;
+	};
+
+	// All timings are expressed in nanoseconds per operation
+	struct Result
+	{
+		std::string Name;
+		u32 Repetitions = 0;
+		u32 BatchSize = 0;
+
+		f64 Mean = 0.0;
+		f64 StdDev = 0.0;
+		f64 Min = 0.0;
+		f64 P50 = 0.0;
+		f64 P90 = 0.0;
+		f64 P99 = 0.0;
+		f64 Max = 0.0;
+	};
+
+	INTEROP_INLINE u64 Now()
+	{
+		return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	inline const void* volatile g_Sink = nullptr;
+
+	INTEROP_INLINE void DoNotOptimize(const void* value)
+	{
+		g_Sink = value;
+	}
+
+	Result Summarize(const char* name, u32 batchSize, std::vector<f64>& samples);
+
+	void PrintTable(FILE* stream, const std::vector<Result>& results);
+	b8 WriteJson(const char* path, const std::vector<Result>& results);
+
+	// Runs `batch(n)`, which must perform n operations, Warmup + Repetitions times
+	// and records the time per operation of every measured repetition
+	template <typename Fn>
+	Result Run(const char* name, const Config& config, Fn&& batch)
+	{
+		for (u32 i = 0; i < config.Warmup; i++)
+			batch(config.BatchSize);
+
+		std::vector<f64> samples;
+		samples.reserve(config.Repetitions);
+
+		for (u32 i = 0; i < config.Repetitions; i++)
+		{
+			u64 begin = Now();
+			batch(config.BatchSize);
+			u64 end = Now();
+
+			samples.push_back(static_cast<f64>(end - begin) / config.BatchSize);
+		}
+
+		return Summarize(name, config.BatchSize, samples);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,649 @@
+#include <Core/Buffer.hpp>
+#include <Core/Definitions.hpp>
+#include <Core/DirtyBitmap.hpp>
+#include <Core/HostedAssembly.hpp>
+#include <Core/Log.hpp>
+#include <Core/Memory.hpp>
+#include <Core/ResultCache.hpp>
+#include <Core/SharedLock.hpp>
+#include <Core/SlabAllocator.hpp>
+#include <Core/Text.hpp>
+
+#include <NetCore/NetCoreController.hpp>
+
+#include <NetCore/Api/ExampleApi.hpp>
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+typedef void (INTEROP_DELEGATE_CALLTYPE *NoopFn)();
+typedef void (INTEROP_DELEGATE_CALLTYPE *NoopWithObjectFn)(void*);
+typedef void (INTEROP_DELEGATE_CALLTYPE *CallNativeNoopFn)(i32);
+typedef void (INTEROP_DELEGATE_CALLTYPE *DelegateRoundaboutFn)(i32);
+typedef void (INTEROP_DELEGATE_CALLTYPE *DecodeObjectFn)(void*, i32);
+typedef void (INTEROP_DELEGATE_CALLTYPE *SyncAllSlotsFn)(void*, void*, i32, i32);
+typedef void (INTEROP_DELEGATE_CALLTYPE *SyncDirtySlotsFn)(u64*, i32, void*, void*, i32);
+typedef u8 (INTEROP_DELEGATE_CALLTYPE *ReceiveFrameCopyFn)(void*, i32);
+typedef u8 (INTEROP_DELEGATE_CALLTYPE *ReceiveFrameBufferFn)(Interop::Buffers::Buffer*);
+typedef f64 (INTEROP_DELEGATE_CALLTYPE *QuotePriceFn)(i32, f64);
+typedef u32 (INTEROP_DELEGATE_CALLTYPE *InvalidateQuotesFn)();
+
+#define BENCHMARK_CLASS_PATH "Interop.Core.Benchmarks.BenchmarkEntryPoint"
+#define BENCHMARK_BLOCK_TYPES 8
+#define BENCHMARK_STRESS_TYPES 32
+#define BENCHMARK_STRESS_THREADS 8
+#define BENCHMARK_SYNC_SLOTS 16384
+#define BENCHMARK_SYNC_CHANGES (BENCHMARK_SYNC_SLOTS / 100)
+#define BENCHMARK_SHARED_MEMORY_SIZE (1 << 20)
+#define BENCHMARK_SLAB_HEAP_SIZE (256 * 1024)
+#define BENCHMARK_FRAME_SIZE (4 * 1024 * 1024)
+#define BENCHMARK_FRAME_BATCH 10
+#define BENCHMARK_QUOTE_KEYS 64
+
+template <u32 N>
+struct BlockType
+{
+	u8 Value;
+};
+
+// One cache line, as most records of the shared type pools
+struct SyncRecord
+{
+	i64 Values[8];
+};
+
+// Error paths of InteropLib report through the asynchronous log, mute its sink while measuring them
+class LogSilencer final
+{
+public:
+	LogSilencer()
+	{
+		Interop::Log::SetSink(Discard);
+	}
+
+	~LogSilencer()
+	{
+		// Messages still queued belong to the silenced section
+		Interop::Log::Flush();
+		Interop::Log::SetSink(nullptr);
+	}
+
+private:
+	static void Discard(u8 level, const char* file, u32 line, const char* message, void* userData) {}
+};
+
+template <u32... N>
+void CreateBlocks(std::integer_sequence<u32, N...>)
+{
+	(Interop::Memory::GetOrCreateBlock<BlockType<N>>(), ...);
+}
+
+Bench::Result BenchmarkBlockCreation(const Bench::Config& config)
+{
+	std::vector<f64> samples;
+	samples.reserve(config.Repetitions);
+
+	for (u32 i = 0; i < config.Warmup + config.Repetitions; i++)
+	{
+		Interop::Memory::State* state = nullptr;
+		if (!Interop::Memory::Init(&state)) break;
+
+		u64 begin = Bench::Now();
+		CreateBlocks(std::make_integer_sequence<u32, BENCHMARK_BLOCK_TYPES>());
+		u64 end = Bench::Now();
+
+		Interop::Memory::Destroy(&state);
+
+		if (i >= config.Warmup)
+			samples.push_back(static_cast<f64>(end - begin) / BENCHMARK_BLOCK_TYPES);
+	}
+
+	return Bench::Summarize("Memory::GetOrCreateBlock (create)", BENCHMARK_BLOCK_TYPES, samples);
+}
+
+typedef Interop::Memory::SharedBlock* (*GetOrCreateBlockFn)();
+
+template <u32... N>
+constexpr std::array<GetOrCreateBlockFn, sizeof...(N)> GetBlockCreators(std::integer_sequence<u32, N...>)
+{
+	return { &Interop::Memory::GetOrCreateBlock<BlockType<N>>... };
+}
+
+// Threads race to create the same types in different orders while reserving ranges of their own:
+// every thread must resolve each type to the same block, no two types may share one and no two ranges may overlap
+i32 StressBlockCreation(u32 rounds)
+{
+	static constexpr std::array<GetOrCreateBlockFn, BENCHMARK_STRESS_TYPES> creators = GetBlockCreators(std::make_integer_sequence<u32, BENCHMARK_STRESS_TYPES>());
+
+	struct Range
+	{
+		u32 Begin;
+		u32 End;
+	};
+
+	u32 failures = 0;
+
+	for (u32 round = 0; round < rounds; round++)
+	{
+		Interop::Memory::State* state = nullptr;
+		if (!Interop::Memory::Init(&state, nullptr, BENCHMARK_SHARED_MEMORY_SIZE)) return 1;
+
+		char* base = static_cast<char*>(state->Allocation->BaseAddress);
+
+		std::array<std::array<Interop::Memory::SharedBlock*, BENCHMARK_STRESS_TYPES>, BENCHMARK_STRESS_THREADS> created = {};
+		std::array<std::array<Interop::Memory::SharedBlock*, BENCHMARK_STRESS_TYPES>, BENCHMARK_STRESS_THREADS> resolved = {};
+		std::array<std::vector<Range>, BENCHMARK_STRESS_THREADS> reserved;
+
+		std::atomic<u32> ready = 0;
+		std::vector<std::thread> threads;
+
+		for (u32 t = 0; t < BENCHMARK_STRESS_THREADS; t++)
+		{
+			threads.emplace_back([&, t]()
+			{
+				ready.fetch_add(1, std::memory_order_acq_rel);
+				while (ready.load(std::memory_order_acquire) < BENCHMARK_STRESS_THREADS) std::this_thread::yield();
+
+				for (u32 i = 0; i < BENCHMARK_STRESS_TYPES; i++)
+				{
+					// Odd threads walk the types backwards, every thread starts at its own offset
+					u32 type = (t % 2 == 0 ? i + t * 3 : BENCHMARK_STRESS_TYPES * 4 - i - t * 3) % BENCHMARK_STRESS_TYPES;
+					created[t][type] = creators[type]();
+
+					if (i % 4 == t % 4)
+					{
+						u32 size = 64 + t * 8;
+						char* range = static_cast<char*>(Interop::Memory::Reserve(size));
+
+						if (range != nullptr)
+							reserved[t].push_back({ static_cast<u32>(range - base), static_cast<u32>(range - base) + size });
+					}
+				}
+
+				for (u32 type = 0; type < BENCHMARK_STRESS_TYPES; type++)
+					resolved[t][type] = creators[type]();
+			});
+		}
+
+		for (std::thread& thread : threads) thread.join();
+
+		std::vector<Range> ranges;
+
+		for (u32 type = 0; type < BENCHMARK_STRESS_TYPES; type++)
+		{
+			Interop::Memory::SharedBlock* block = created[0][type];
+
+			for (u32 t = 0; t < BENCHMARK_STRESS_THREADS; t++)
+			{
+				if (block == nullptr || created[t][type] != block || resolved[t][type] != block)
+				{
+					printf("Round %u: thread %u resolved type %u to a different block\n", round, t, type);
+					failures++;
+				}
+			}
+
+			for (u32 other = 0; other < type && block != nullptr; other++)
+			{
+				if (created[0][other] == block)
+				{
+					printf("Round %u: types %u and %u share the same block\n", round, other, type);
+					failures++;
+				}
+			}
+
+			if (block != nullptr) ranges.push_back({ block->Offset, block->Offset + block->Size });
+		}
+
+		for (const std::vector<Range>& threadRanges : reserved)
+			ranges.insert(ranges.end(), threadRanges.begin(), threadRanges.end());
+
+		std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return a.Begin < b.Begin; });
+
+		for (size_t i = 1; i < ranges.size(); i++)
+		{
+			if (ranges[i].Begin < ranges[i - 1].End)
+			{
+				printf("Round %u: range [%u, %u) overlaps [%u, %u)\n", round, ranges[i].Begin, ranges[i].End, ranges[i - 1].Begin, ranges[i - 1].End);
+				failures++;
+			}
+		}
+
+		Interop::Memory::Destroy(&state);
+	}
+
+	printf("Block creation stress: %u rounds, %u threads, %u types, %u failures\n", rounds, BENCHMARK_STRESS_THREADS, BENCHMARK_STRESS_TYPES, failures);
+	return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+	Bench::Config config = {};
+	const char* version = "9.0.0";
+	const char* jsonPath = nullptr;
+	const char* bundlePath = nullptr;
+	u32 prewarmTimeout = 0;
+	u64 noGcBudget = 0;
+	u32 stressRounds = 0;
+
+	for (i32 i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--warmup") == 0) config.Warmup = static_cast<u32>(atoi(argv[i + 1]));
+		else if (strcmp(argv[i], "--repetitions") == 0) config.Repetitions = static_cast<u32>(atoi(argv[i + 1]));
+		else if (strcmp(argv[i], "--batch") == 0) config.BatchSize = static_cast<u32>(atoi(argv[i + 1]));
+		else if (strcmp(argv[i], "--version") == 0) version = argv[i + 1];
+		else if (strcmp(argv[i], "--json") == 0) jsonPath = argv[i + 1];
+		else if (strcmp(argv[i], "--bundle") == 0) bundlePath = argv[i + 1];
+		else if (strcmp(argv[i], "--prewarm") == 0) prewarmTimeout = static_cast<u32>(atoi(argv[i + 1]));
+		else if (strcmp(argv[i], "--no-gc-region") == 0) noGcBudget = strtoull(argv[i + 1], nullptr, 10);
+		else if (strcmp(argv[i], "--stress-blocks") == 0) stressRounds = static_cast<u32>(atoi(argv[i + 1]));
+
+		else
+		{
+			printf("Usage: %s [--warmup N] [--repetitions N] [--batch N] [--version X.Y.Z] [--json PATH] [--bundle PATH] [--prewarm TIMEOUT_MS] [--no-gc-region BYTES] [--stress-blocks ROUNDS]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// Correctness check of concurrent block creation, no runtime needed
+	if (stressRounds > 0)
+		return StressBlockCreation(stressRounds);
+
+	if (config.Repetitions == 0 || config.BatchSize == 0)
+	{
+		printf("%s\n", "Repetitions and batch size must be greater than 0");
+		return 1;
+	}
+
+	std::vector<Bench::Result> results;
+
+	// Startup costs, measured on controllers that are thrown away
+	Bench::Config startupConfig = config;
+	startupConfig.BatchSize = 1;
+
+	results.push_back(Bench::Run("Controller::Init", startupConfig, [version](u32)
+	{
+		Interop::NetCore::Controller controller(version);
+		controller.Init();
+	}));
+
+	results.push_back(BenchmarkBlockCreation(config));
+
+	Interop::NetCore::Controller controller(version);
+	Interop::HostedAssembly interopCore("Interop.Core");
+
+	controller.SetSharedMemorySize(BENCHMARK_SHARED_MEMORY_SIZE);
+	controller.SetAssemblyBundle(bundlePath);
+
+	if (!controller.Init() || Interop::Memory::ReserveSlabHeap(BENCHMARK_SLAB_HEAP_SIZE) == nullptr)
+	{
+		return 1;
+	}
+
+	u64 begin = Bench::Now();
+	b8 success = controller.OpenContext(&interopCore);
+	u64 end = Bench::Now();
+
+	std::vector<f64> startupSample = { static_cast<f64>(end - begin) };
+	results.push_back(Bench::Summarize(bundlePath != nullptr ? "Controller::OpenContext (bundle)" : "Controller::OpenContext (cold)", 1, startupSample));
+
+	if (success) success = controller.LoadAssemblyFunction("Noop", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("NoopWithObject", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("CallNativeNoop", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("CallNativeNoopExport", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("CallNativeNoopSuppressed", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("DelegateRoundabout", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("PassObjectCoTaskMem", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("PassObjectScratch", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("DecodeMarshalled", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("DecodeNativeText", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("SyncAllSlots", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("SyncDirtySlots", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("ReceiveFrameCopy", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("ReceiveFrameBuffer", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("QuotePrice", BENCHMARK_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("InvalidateQuotes", BENCHMARK_CLASS_PATH, &interopCore);
+
+	if (!success) return 1;
+
+	auto Noop = interopCore.GetFunction<NoopFn>("Noop");
+	auto NoopWithObject = interopCore.GetFunction<NoopWithObjectFn>("NoopWithObject");
+	auto CallNativeNoop = interopCore.GetFunction<CallNativeNoopFn>("CallNativeNoop");
+	auto CallNativeNoopExport = interopCore.GetFunction<CallNativeNoopFn>("CallNativeNoopExport");
+	auto CallNativeNoopSuppressed = interopCore.GetFunction<CallNativeNoopFn>("CallNativeNoopSuppressed");
+	auto DelegateRoundabout = interopCore.GetFunction<DelegateRoundaboutFn>("DelegateRoundabout");
+	auto PassObjectCoTaskMem = interopCore.GetFunction<CallNativeNoopFn>("PassObjectCoTaskMem");
+	auto PassObjectScratch = interopCore.GetFunction<CallNativeNoopFn>("PassObjectScratch");
+	auto DecodeMarshalled = interopCore.GetFunction<DecodeObjectFn>("DecodeMarshalled");
+	auto DecodeNativeText = interopCore.GetFunction<DecodeObjectFn>("DecodeNativeText");
+	auto SyncAllSlots = interopCore.GetFunction<SyncAllSlotsFn>("SyncAllSlots");
+	auto SyncDirtySlots = interopCore.GetFunction<SyncDirtySlotsFn>("SyncDirtySlots");
+	auto ReceiveFrameCopy = interopCore.GetFunction<ReceiveFrameCopyFn>("ReceiveFrameCopy");
+	auto ReceiveFrameBuffer = interopCore.GetFunction<ReceiveFrameBufferFn>("ReceiveFrameBuffer");
+	auto QuotePrice = interopCore.GetFunction<QuotePriceFn>("QuotePrice");
+	auto InvalidateQuotes = interopCore.GetFunction<InvalidateQuotesFn>("InvalidateQuotes");
+
+	Interop::NetCore::Api::CustomObject exampleObj = {};
+
+	// First call of an entry point and of its callees, compiled on the calling thread unless pre-warmed
+	if (prewarmTimeout != 0)
+	{
+		const char* callees[] = { "Interop.Core.Native.NativeText.*" };
+		u32 failed = 0;
+
+		if (!controller.StartPrewarm(&interopCore, callees, 1) || !controller.WaitPrewarm(prewarmTimeout, &failed))
+			printf("%s\n", "Pre-warm did not complete in time, the first call is measured anyway");
+
+		else if (failed != 0)
+			printf("Pre-warm completed, %u methods could not be compiled\n", failed);
+	}
+
+	begin = Bench::Now();
+	DecodeNativeText(&exampleObj, 1);
+	end = Bench::Now();
+
+	std::vector<f64> firstCallSample = { static_cast<f64>(end - begin) };
+	results.push_back(Bench::Summarize(prewarmTimeout != 0 ? "First call (pre-warmed)" : "First call (cold)", 1, firstCallSample));
+
+	// Boundary crossings
+	results.push_back(Bench::Run("Native->Managed (no args)", config, [Noop](u32 n)
+	{
+		for (u32 i = 0; i < n; i++) Noop();
+	}));
+
+	results.push_back(Bench::Run("Native->Managed (pointer arg)", config, [NoopWithObject, &exampleObj](u32 n)
+	{
+		for (u32 i = 0; i < n; i++) NoopWithObject(&exampleObj);
+	}));
+
+	results.push_back(Bench::Run("Managed->Native (LibraryImport)", config, [CallNativeNoop](u32 n)
+	{
+		CallNativeNoop(static_cast<i32>(n));
+	}));
+
+	results.push_back(Bench::Run("Managed->Native (export table)", config, [CallNativeNoopExport](u32 n)
+	{
+		CallNativeNoopExport(static_cast<i32>(n));
+	}));
+
+	results.push_back(Bench::Run("Managed->Native (export, no GC)", config, [CallNativeNoopSuppressed](u32 n)
+	{
+		CallNativeNoopSuppressed(static_cast<i32>(n));
+	}));
+
+	results.push_back(Bench::Run("Delegate roundabout", config, [DelegateRoundabout](u32 n)
+	{
+		DelegateRoundabout(static_cast<i32>(n));
+	}));
+
+	// Pure function results cached natively, hits never enter managed code
+	Interop::CachedFunction<QuotePriceFn> CachedQuotePrice(QuotePrice);
+
+	results.push_back(Bench::Run("Pure function (uncached)", config, [QuotePrice](u32 n)
+	{
+		f64 total = 0.0;
+
+		for (u32 i = 0; i < n; i++) total += QuotePrice(static_cast<i32>(i % BENCHMARK_QUOTE_KEYS), 9.99);
+		Bench::DoNotOptimize(&total);
+	}));
+
+	results.push_back(Bench::Run("Pure function (cache hit)", config, [&CachedQuotePrice](u32 n)
+	{
+		f64 total = 0.0;
+
+		for (u32 i = 0; i < n; i++) total += CachedQuotePrice(static_cast<i32>(i % BENCHMARK_QUOTE_KEYS), 9.99);
+		Bench::DoNotOptimize(&total);
+	}));
+
+	// Unique keys, every call pays for the lookup and the insertion on top of the crossing
+	u32 quoteKey = BENCHMARK_QUOTE_KEYS;
+
+	results.push_back(Bench::Run("Pure function (cache miss)", config, [&CachedQuotePrice, &quoteKey](u32 n)
+	{
+		f64 total = 0.0;
+
+		for (u32 i = 0; i < n; i++) total += CachedQuotePrice(static_cast<i32>(quoteKey++), 9.99);
+		Bench::DoNotOptimize(&total);
+	}));
+
+	if (InvalidateQuotes() != 1)
+		printf("%s\n", "The managed invalidation did not reach the QuotePrice cache");
+
+	// Per-call interop temporaries
+	results.push_back(Bench::Run("Pass CustomObject (CoTaskMem)", config, [PassObjectCoTaskMem](u32 n)
+	{
+		PassObjectCoTaskMem(static_cast<i32>(n));
+	}));
+
+	results.push_back(Bench::Run("Pass CustomObject (scratch)", config, [PassObjectScratch](u32 n)
+	{
+		PassObjectScratch(static_cast<i32>(n));
+	}));
+
+	// String-heavy records
+	// Allocates on every call, so collections land in the middle of batches unless a no-GC region keeps them out
+	Interop::NetCore::GcStats gcBefore = {};
+	Interop::NetCore::GcStats gcAfter = {};
+
+	b8 gcRegion = noGcBudget != 0 && controller.EnterGcRegion(&interopCore, noGcBudget, &gcBefore, Interop::NetCore::INTEROP_GC_LATENCY_MODE_NONE);
+	if (!gcRegion) controller.GetGcStats(&interopCore, &gcBefore);
+
+	results.push_back(Bench::Run(gcRegion ? "Decode CustomObject (no GC region)" : "Decode CustomObject (marshalled)", config, [DecodeMarshalled, &exampleObj](u32 n)
+	{
+		DecodeMarshalled(&exampleObj, static_cast<i32>(n));
+	}));
+
+	b8 noCollection = false;
+
+	if (gcRegion)
+	{
+		Interop::NetCore::GcRegionResult exit = controller.ExitGcRegion(&gcAfter);
+
+		// The stats are not filled in when leaving the region failed
+		if (exit == Interop::NetCore::INTEROP_GC_REGION_RESULT_ERROR) controller.GetGcStats(&interopCore, &gcAfter);
+		noCollection = exit == Interop::NetCore::INTEROP_GC_REGION_RESULT_NO_COLLECTION;
+	}
+
+	else
+		noCollection = controller.GetGcStats(&interopCore, &gcAfter) && gcAfter.Collections[0] == gcBefore.Collections[0];
+
+	printf("GC while decoding marshalled objects: %u collections (%u gen2), %.3f ms paused, %llu KB allocated%s\n",
+		gcAfter.Collections[0] - gcBefore.Collections[0], gcAfter.Collections[2] - gcBefore.Collections[2],
+		static_cast<f64>(gcAfter.PauseDuration - gcBefore.PauseDuration) / 1e6,
+		static_cast<unsigned long long>((gcAfter.AllocatedBytes - gcBefore.AllocatedBytes) / 1024), noCollection ? "" : ", the GC ran");
+
+	results.push_back(Bench::Run("Decode CustomObject (NativeText)", config, [DecodeNativeText, &exampleObj](u32 n)
+	{
+		DecodeNativeText(&exampleObj, static_cast<i32>(n));
+	}));
+
+	// Shared memory access
+	using Interop::NetCore::Api::CustomObject;
+
+	u32 capacity = Interop::Memory::GetOrCreateBlock<CustomObject>()->Capacity;
+
+	results.push_back(Bench::Run("Memory::Set (hit)", config, [capacity, &exampleObj](u32 n)
+	{
+		for (u32 i = 0; i < n; i++) Interop::Memory::Set<CustomObject>(i % capacity, exampleObj);
+	}));
+
+	results.push_back(Bench::Run("Memory::Get (hit)", config, [capacity](u32 n)
+	{
+		for (u32 i = 0; i < n; i++) Bench::DoNotOptimize(Interop::Memory::Get<CustomObject>(i % capacity));
+	}));
+
+	{
+		LogSilencer silencer;
+
+		results.push_back(Bench::Run("Memory::Set (out of range)", config, [capacity, &exampleObj](u32 n)
+		{
+			for (u32 i = 0; i < n; i++) Interop::Memory::Set<CustomObject>(capacity + 1, exampleObj);
+		}));
+
+		results.push_back(Bench::Run("Memory::Get (out of range)", config, [capacity](u32 n)
+		{
+			for (u32 i = 0; i < n; i++) Bench::DoNotOptimize(Interop::Memory::Get<CustomObject>(capacity + 1));
+		}));
+	}
+
+	// Variable-size allocations
+	results.push_back(Bench::Run("Memory::Alloc+Free (64 B)", config, [](u32 n)
+	{
+		for (u32 i = 0; i < n; i++)
+		{
+			Interop::Memory::SharedOffset offset = Interop::Memory::Alloc(64);
+			Bench::DoNotOptimize(&offset);
+
+			Interop::Memory::Free(offset);
+		}
+	}));
+
+	results.push_back(Bench::Run("malloc+free (64 B)", config, [](u32 n)
+	{
+		for (u32 i = 0; i < n; i++)
+		{
+			void* address = malloc(64);
+			Bench::DoNotOptimize(address);
+
+			free(address);
+		}
+	}));
+
+	// Uncontended locking, the contended case is measured by InteropLoad
+	Interop::Memory::SharedMutex* sharedMutex = Interop::Memory::ReserveSharedMutex();
+
+	results.push_back(Bench::Run("SharedMutex lock+unlock", config, [&](u32 n)
+	{
+		for (u32 i = 0; i < n; i++)
+		{
+			Interop::Memory::LockSharedMutex(sharedMutex);
+			Interop::Memory::UnlockSharedMutex(sharedMutex);
+		}
+	}));
+
+	std::mutex processMutex;
+
+	results.push_back(Bench::Run("std::mutex lock+unlock", config, [&](u32 n)
+	{
+		for (u32 i = 0; i < n; i++)
+		{
+			processMutex.lock();
+			processMutex.unlock();
+		}
+	}));
+
+	// Incremental synchronization, 1% of the slots change between two ticks
+	std::vector<SyncRecord> slots(BENCHMARK_SYNC_SLOTS, SyncRecord {});
+	std::vector<SyncRecord> mirror(BENCHMARK_SYNC_SLOTS, SyncRecord {});
+	std::vector<u64> dirtyBits(Interop::Memory::GetDirtyWordCount(BENCHMARK_SYNC_SLOTS), 0);
+
+	u32 changeCursor = 0;
+
+	auto ChangeSlots = [&slots, &dirtyBits, &changeCursor]()
+	{
+		for (u32 i = 0; i < BENCHMARK_SYNC_CHANGES; i++)
+		{
+			// Spread over the block with a stride coprime with its size
+			u32 index = (changeCursor += 7919) % BENCHMARK_SYNC_SLOTS;
+
+			slots[index].Values[0]++;
+			Interop::Memory::SetDirty(dirtyBits.data(), index);
+		}
+	};
+
+	// Writers always track their changes, the bits are simply never collected by the full copy
+	results.push_back(Bench::Run("Sync 1% of 16k slots (full copy)", config, [&](u32 n)
+	{
+		for (u32 i = 0; i < n; i++)
+		{
+			ChangeSlots();
+			SyncAllSlots(slots.data(), mirror.data(), BENCHMARK_SYNC_SLOTS, sizeof(SyncRecord));
+		}
+	}));
+
+	results.push_back(Bench::Run("Sync 1% of 16k slots (dirty bitmap)", config, [&](u32 n)
+	{
+		for (u32 i = 0; i < n; i++)
+		{
+			ChangeSlots();
+			SyncDirtySlots(dirtyBits.data(), static_cast<i32>(dirtyBits.size()), slots.data(), mirror.data(), sizeof(SyncRecord));
+		}
+	}));
+
+	// Large payloads, a frame produced by native code and consumed by managed code
+	Interop::Buffers::BufferRef frame(Interop::Buffers::Create(BENCHMARK_FRAME_SIZE));
+	if (!frame) return 1;
+
+	memset(frame->Data, 0x5A, BENCHMARK_FRAME_SIZE);
+
+	Bench::Config frameConfig = config;
+	frameConfig.BatchSize = BENCHMARK_FRAME_BATCH;
+
+	results.push_back(Bench::Run("Pass 4 MB frame (copy)", frameConfig, [ReceiveFrameCopy, &frame](u32 n)
+	{
+		u8 last = 0;
+		for (u32 i = 0; i < n; i++) last ^= ReceiveFrameCopy(frame->Data, BENCHMARK_FRAME_SIZE);
+
+		Bench::DoNotOptimize(&last);
+	}));
+
+	// Each call transfers a reference of its own, released by managed code
+	results.push_back(Bench::Run("Pass 4 MB frame (buffer)", frameConfig, [ReceiveFrameBuffer, &frame](u32 n)
+	{
+		u8 last = 0;
+		for (u32 i = 0; i < n; i++) last ^= ReceiveFrameBuffer(Interop::Buffers::Acquire(frame.Get()));
+
+		Bench::DoNotOptimize(&last);
+	}));
+
+	// Text kernels, on a full CustomObject text field
+	char asciiText[256];
+	u16 wideText[256];
+
+	memset(asciiText, 'a', sizeof(asciiText) - 1);
+	asciiText[sizeof(asciiText) - 1] = '\0';
+
+	results.push_back(Bench::Run("Text::Length (255 B)", config, [&asciiText](u32 n)
+	{
+		u32 length = 0;
+		for (u32 i = 0; i < n; i++) length += Interop::Text::Length(asciiText, sizeof(asciiText));
+
+		Bench::DoNotOptimize(&length);
+	}));
+
+	results.push_back(Bench::Run("Text::Utf8ToUtf16 (255 B ASCII)", config, [&asciiText, &wideText](u32 n)
+	{
+		u32 written = 0;
+		for (u32 i = 0; i < n; i++) Interop::Text::Utf8ToUtf16(asciiText, sizeof(asciiText) - 1, wideText, 256, &written);
+
+		Bench::DoNotOptimize(wideText);
+	}));
+
+	controller.CloseContext();
+
+	Bench::PrintTable(stdout, results);
+
+	if (jsonPath != nullptr && !Bench::WriteJson(jsonPath, results))
+		return 1;
+
+	return 0;
+}
+
+#undef BENCHMARK_QUOTE_KEYS
+#undef BENCHMARK_FRAME_BATCH
+#undef BENCHMARK_FRAME_SIZE
+#undef BENCHMARK_SLAB_HEAP_SIZE
+#undef BENCHMARK_SHARED_MEMORY_SIZE
+#undef BENCHMARK_SYNC_CHANGES
+#undef BENCHMARK_SYNC_SLOTS
+#undef BENCHMARK_STRESS_THREADS
+#undef BENCHMARK_STRESS_TYPES
+#undef BENCHMARK_BLOCK_TYPES
+#undef BENCHMARK_CLASS_PATH
\ No newline at end of file
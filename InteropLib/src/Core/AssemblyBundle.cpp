@@ -0,0 +1,123 @@
+#include "Core/AssemblyBundle.hpp"
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+
+#include "Platform/Platform.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+// Longest header line accepted, a name and four 64-bit decimal numbers fit with room to spare
+#define INTEROP_BUNDLE_MAX_LINE 256
+
+namespace Interop
+{
+
+	// Copies the next header line, null-terminated, returns false past the end of the file or on oversized lines
+	static b8 ReadLine(const char*& cursor, const char* end, char* line)
+	{
+		const char* newline = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+		if (newline == nullptr || newline - cursor >= INTEROP_BUNDLE_MAX_LINE) return false;
+
+		memcpy(line, cursor, newline - cursor);
+		line[newline - cursor] = '\0';
+
+		cursor = newline + 1;
+		return true;
+	}
+
+	static b8 IsInFile(u64 offset, u64 size, u64 fileSize)
+	{
+		return offset <= fileSize && size <= fileSize - offset;
+	}
+
+	AssemblyBundle::~AssemblyBundle()
+	{
+		Close();
+	}
+
+	b8 AssemblyBundle::Open()
+	{
+		if (Address != nullptr)
+		{
+			INTEROP_LOG_WARNING("Assembly bundle \"%s\" is already open", Path);
+			return true;
+		}
+
+		Address = Platform::MapFile(Path, &Size);
+		if (Address == nullptr) return false;
+
+		const char* cursor = static_cast<const char*>(Address);
+		const char* end = cursor + Size;
+
+		char line[INTEROP_BUNDLE_MAX_LINE];
+		char magic[sizeof(INTEROP_BUNDLE_MAGIC)] = {};
+		u32 version = 0;
+		u32 count = 0;
+
+		if (!ReadLine(cursor, end, line) || sscanf(line, "%14s %u %u", magic, &version, &count) != 3 || strcmp(magic, INTEROP_BUNDLE_MAGIC) != 0)
+		{
+			INTEROP_LOG_ERROR("Unable to open assembly bundle \"%s\", it is not a bundle", Path);
+			Close();
+
+			return false;
+		}
+
+		if (version != INTEROP_BUNDLE_VERSION)
+		{
+			INTEROP_LOG_ERROR("Unable to open assembly bundle \"%s\" (version: %u, expected: %u)", Path, version, INTEROP_BUNDLE_VERSION);
+			Close();
+
+			return false;
+		}
+
+		Entries.resize(count);
+
+		for (BundleEntry& entry : Entries)
+		{
+			unsigned long long imageOffset = 0, imageSize = 0, symbolsOffset = 0, symbolsSize = 0;
+
+			b8 valid = ReadLine(cursor, end, line);
+			if (valid) valid = sscanf(line, "%127s %llu %llu %llu %llu", entry.Name, &imageOffset, &imageSize, &symbolsOffset, &symbolsSize) == 5;
+			if (valid) valid = imageSize > 0 && IsInFile(imageOffset, imageSize, Size) && IsInFile(symbolsOffset, symbolsSize, Size);
+
+			if (!valid)
+			{
+				INTEROP_LOG_ERROR("Unable to open assembly bundle \"%s\", entry %u is corrupted", Path, static_cast<u32>(&entry - Entries.data()));
+				Close();
+
+				return false;
+			}
+
+			entry.Image = static_cast<const u8*>(Address) + imageOffset;
+			entry.ImageSize = imageSize;
+			entry.Symbols = symbolsSize > 0 ? static_cast<const u8*>(Address) + symbolsOffset : nullptr;
+			entry.SymbolsSize = symbolsSize;
+		}
+
+		return true;
+	}
+
+	void AssemblyBundle::Close()
+	{
+		Platform::UnmapFile(Address, Size);
+
+		Address = nullptr;
+		Size = 0;
+
+		Entries.clear();
+	}
+
+	const BundleEntry* AssemblyBundle::Find(const char* name) const
+	{
+		for (const BundleEntry& entry : Entries)
+		{
+			if (strcmp(entry.Name, name) == 0) return &entry;
+		}
+
+		return nullptr;
+	}
+
+}
+
+#undef INTEROP_BUNDLE_MAX_LINE
\ No newline at end of file
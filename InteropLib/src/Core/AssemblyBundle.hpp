@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <vector>
+
+// Layout written by cmake/PackAssemblyBundle.cmake: a text header, "INTEROP_BUNDLE <version> <count>",
+// then one "<name> <image offset> <image size> <symbols offset> <symbols size>" line per assembly,
+// padded up to the first image. Offsets are relative to the start of the file.
+#define INTEROP_BUNDLE_MAGIC "INTEROP_BUNDLE"
+#define INTEROP_BUNDLE_VERSION 1
+#define INTEROP_BUNDLE_MAX_NAME 128
+
+namespace Interop
+{
+
+	struct BundleEntry
+	{
+		char Name[INTEROP_BUNDLE_MAX_NAME] = {}; // Simple name of the assembly, without extension
+		const void* Image = nullptr;
+		u64 ImageSize = 0;
+
+		const void* Symbols = nullptr; // nullptr when the bundle was packed without symbols
+		u64 SymbolsSize = 0;
+	};
+
+	// Assemblies packed in a single file, mapped read-only so that loading them costs one sequential read
+	class AssemblyBundle final
+	{
+	public:
+		AssemblyBundle(const char* path) : Path(path) {}
+		AssemblyBundle(AssemblyBundle&) = delete;
+
+		INTEROP_API ~AssemblyBundle();
+
+		const char* Path;
+
+		const void* Address = nullptr;
+		u64 Size = 0;
+
+		std::vector<BundleEntry> Entries = {};
+
+		INTEROP_API b8 Open();
+		INTEROP_API void Close();
+
+		INTEROP_API const BundleEntry* Find(const char* name) const;
+
+		AssemblyBundle& operator=(AssemblyBundle&) = delete;
+
+	private:
+		AssemblyBundle() = default;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "Core/Buffer.hpp"
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+#include "Core/SlabAllocator.hpp"
+
+#include <atomic>
+#include <new>
+
+// Header size of heap buffers, so that their data stays aligned
+#define INTEROP_BUFFER_HEADER_SIZE ((sizeof(Buffer) + INTEROP_BUFFER_ALIGNMENT - 1) & ~static_cast<u64>(INTEROP_BUFFER_ALIGNMENT - 1))
+
+namespace Interop::Buffers
+{
+
+	static std::atomic<u32> s_LiveCount = 0;
+
+	static Buffer* CreateHeader(void* memory, void* data, u64 size, BufferStorage storage)
+	{
+		Buffer* buffer = new (memory) Buffer();
+
+		buffer->Data = data;
+		buffer->Size = size;
+		buffer->References.store(1, std::memory_order_relaxed);
+		buffer->Storage = storage;
+		buffer->Offset = 0;
+		buffer->Callback = nullptr;
+		buffer->Context = nullptr;
+
+		s_LiveCount.fetch_add(1, std::memory_order_relaxed);
+
+		return buffer;
+	}
+
+	Buffer* Create(u64 size)
+	{
+		void* memory = ::operator new(INTEROP_BUFFER_HEADER_SIZE + size, std::align_val_t(INTEROP_BUFFER_ALIGNMENT), std::nothrow);
+
+		if (memory == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to allocate a buffer of %llu bytes", static_cast<unsigned long long>(size));
+			return nullptr;
+		}
+
+		return CreateHeader(memory, static_cast<u8*>(memory) + INTEROP_BUFFER_HEADER_SIZE, size, INTEROP_BUFFER_STORAGE_HEAP);
+	}
+
+	Buffer* CreateShared(u32 size)
+	{
+		// Headers hold addresses of this process, only the data is shared
+		void* memory = ::operator new(sizeof(Buffer), std::nothrow);
+		if (memory == nullptr) [[unlikely]] return nullptr;
+
+		Memory::SharedOffset offset = Memory::Alloc(size);
+
+		if (offset == 0) [[unlikely]]
+		{
+			::operator delete(memory);
+			return nullptr;
+		}
+
+		Buffer* buffer = CreateHeader(memory, Memory::Resolve(offset), size, INTEROP_BUFFER_STORAGE_SHARED);
+		buffer->Offset = offset;
+
+		return buffer;
+	}
+
+	Buffer* Wrap(void* data, u64 size, ReleaseCallbackFn callback, void* context)
+	{
+		void* memory = ::operator new(sizeof(Buffer), std::nothrow);
+		if (memory == nullptr) [[unlikely]] return nullptr;
+
+		Buffer* buffer = CreateHeader(memory, data, size, INTEROP_BUFFER_STORAGE_EXTERNAL);
+		buffer->Callback = callback;
+		buffer->Context = context;
+
+		return buffer;
+	}
+
+	static void Destroy(Buffer* buffer)
+	{
+		s_LiveCount.fetch_sub(1, std::memory_order_relaxed);
+
+		switch (buffer->Storage)
+		{
+			case INTEROP_BUFFER_STORAGE_HEAP:
+				buffer->~Buffer();
+				::operator delete(buffer, std::align_val_t(INTEROP_BUFFER_ALIGNMENT));
+				return;
+
+			case INTEROP_BUFFER_STORAGE_SHARED:
+				Memory::Free(buffer->Offset);
+				break;
+
+			case INTEROP_BUFFER_STORAGE_EXTERNAL:
+				if (buffer->Callback != nullptr) buffer->Callback(buffer->Data, buffer->Size, buffer->Context);
+				break;
+		}
+
+		buffer->~Buffer();
+		::operator delete(buffer);
+	}
+
+	u32 Release(Buffer* buffer)
+	{
+		if (buffer == nullptr) return 0;
+
+		// Acquire-release so that the last owner sees every write made through the other references
+		u32 references = buffer->References.fetch_sub(1, std::memory_order_acq_rel);
+
+		if (references == 0) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Buffer %p released more times than it was acquired", static_cast<void*>(buffer));
+			return 0;
+		}
+
+		if (references == 1) Destroy(buffer);
+
+		return references - 1;
+	}
+
+	u32 GetLiveCount()
+	{
+		return s_LiveCount.load(std::memory_order_relaxed);
+	}
+
+}
+
+#undef INTEROP_BUFFER_HEADER_SIZE
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+#include "Core/SlabAllocator.hpp"
+
+#include <atomic>
+
+// Alignment of the data of heap buffers, enough for any SIMD load
+#define INTEROP_BUFFER_ALIGNMENT 64
+
+namespace Interop::Buffers
+{
+
+	enum BufferStorage
+	{
+		INTEROP_BUFFER_STORAGE_HEAP = 0, // Data follows the header in a single allocation
+		INTEROP_BUFFER_STORAGE_SHARED = 1, // Data lives in the slab heap of the shared memory map
+		INTEROP_BUFFER_STORAGE_EXTERNAL = 2, // Data owned by the release callback provided to Wrap
+	};
+
+	// Called once the last reference of a wrapped buffer is released
+	typedef void (INTEROP_DELEGATE_CALLTYPE* ReleaseCallbackFn)(void* data, u64 size, void* context);
+
+	// Reference-counted memory handed across the boundary by pointer, without copying its data.
+	// Every reference belongs to a single party: a buffer passed to a call either transfers the reference
+	// of the caller, which the receiver releases, or is lent for the duration of the call, in which case
+	// the receiver acquires a reference of its own to keep it.
+	struct Buffer
+	{
+		void* Data;
+		u64 Size;
+
+		std::atomic<u32> References;
+		u32 Storage; // BufferStorage
+
+		Memory::SharedOffset Offset; // Offset of the data in the shared memory map for shared buffers, else 0
+
+		ReleaseCallbackFn Callback;
+		void* Context;
+	};
+
+	// Buffers start with a single reference, owned by the caller. They return nullptr when out of memory.
+	INTEROP_API Buffer* Create(u64 size);
+	INTEROP_API Buffer* CreateShared(u32 size);
+	INTEROP_API Buffer* Wrap(void* data, u64 size, ReleaseCallbackFn callback, void* context);
+
+	INTEROP_INLINE Buffer* Acquire(Buffer* buffer)
+	{
+		buffer->References.fetch_add(1, std::memory_order_relaxed);
+		return buffer;
+	}
+
+	// Returns the number of references left, the buffer is destroyed when it reaches 0
+	INTEROP_API u32 Release(Buffer* buffer);
+
+	INTEROP_API u32 GetLiveCount();
+
+	// Owns one reference of a buffer
+	class BufferRef final
+	{
+	public:
+		BufferRef() = default;
+		explicit BufferRef(Buffer* buffer) : m_Buffer(buffer) {}
+		BufferRef(const BufferRef& other) : m_Buffer(other.m_Buffer != nullptr ? Acquire(other.m_Buffer) : nullptr) {}
+		BufferRef(BufferRef&& other) noexcept : m_Buffer(other.Detach()) {}
+
+		~BufferRef() { Reset(); }
+
+		BufferRef& operator=(BufferRef other) noexcept
+		{
+			Buffer* previous = m_Buffer;
+			m_Buffer = other.m_Buffer;
+			other.m_Buffer = previous;
+
+			return *this;
+		}
+
+		Buffer* Get() const { return m_Buffer; }
+		Buffer* operator->() const { return m_Buffer; }
+		explicit operator bool() const { return m_Buffer != nullptr; }
+
+		// Gives the reference away, to transfer it to a call
+		Buffer* Detach()
+		{
+			Buffer* buffer = m_Buffer;
+			m_Buffer = nullptr;
+
+			return buffer;
+		}
+
+		void Reset()
+		{
+			if (m_Buffer != nullptr) Release(Detach());
+		}
+
+	private:
+		Buffer* m_Buffer = nullptr;
+	};
+
+}
\ No newline at end of file
@@ -74,7 +74,7 @@ typedef bool b8;
 
 #else
 #define INTEROP_API
-#define INTEROP_C_API
+#define INTEROP_C_API extern "C"
 #endif
 #endif
 
@@ -0,0 +1,122 @@
+#include "Core/Definitions.hpp"
+#include "Core/DirtyBitmap.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define INTEROP_DIRTY_X64 1
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define INTEROP_TARGET_AVX2
+#else
+#define INTEROP_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#endif
+#endif
+
+namespace Interop::Memory
+{
+
+	typedef u32 (*CollectDirtyFn)(u64* words, u32 wordCount, u64* destination);
+
+	static INTEROP_INLINE u32 CollectWord(u64* word, u64* destination)
+	{
+		u64 bits = std::atomic_ref<u64>(*word).exchange(0, std::memory_order_acquire);
+		*destination = bits;
+
+		return static_cast<u32>(std::popcount(bits));
+	}
+
+	static INTEROP_INLINE u32 CollectDirtyScalar(u64* words, u32 wordCount, u64* destination)
+	{
+		u32 dirty = 0;
+
+		for (u32 i = 0; i < wordCount; i++)
+		{
+			if (std::atomic_ref<u64>(words[i]).load(std::memory_order_relaxed) == 0)
+			{
+				destination[i] = 0;
+				continue;
+			}
+
+			dirty += CollectWord(&words[i], &destination[i]);
+		}
+
+		return dirty;
+	}
+
+#ifdef INTEROP_DIRTY_X64
+
+	// The vector loads are only a hint racing with writers: a bit set right after a group was seen clean
+	// is left in place for the next collection, exactly as if it had been set after the exchange
+	INTEROP_TARGET_AVX2 static u32 CollectDirtyAvx2(u64* words, u32 wordCount, u64* destination)
+	{
+		u32 dirty = 0;
+		u32 i = 0;
+
+		for (; i + 16 <= wordCount; i += 16)
+		{
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i + 4));
+			__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i + 8));
+			__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i + 12));
+
+			__m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+
+			if (_mm256_testz_si256(any, any))
+			{
+				__m256i zero = _mm256_setzero_si256();
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), zero);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 4), zero);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 8), zero);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 12), zero);
+
+				continue;
+			}
+
+			dirty += CollectDirtyScalar(words + i, 16, destination + i);
+		}
+
+		_mm256_zeroupper();
+
+		return dirty + CollectDirtyScalar(words + i, wordCount - i, destination + i);
+	}
+
+	static b8 SupportsAvx2()
+	{
+#ifdef _MSC_VER
+		i32 info[4];
+
+		__cpuid(info, 1);
+		if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 23)) == 0 || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#endif
+	}
+
+#endif
+
+	static CollectDirtyFn SelectCollectDirty()
+	{
+#ifdef INTEROP_DIRTY_X64
+		if (SupportsAvx2())
+			return &CollectDirtyAvx2;
+#endif
+
+		return &CollectDirtyScalar;
+	}
+
+	static const CollectDirtyFn s_CollectDirty = SelectCollectDirty();
+
+	u32 CollectDirty(u64* words, u32 wordCount, u64* destination)
+	{
+		return s_CollectDirty(words, wordCount, destination);
+	}
+
+}
+
+#undef INTEROP_TARGET_AVX2
+#undef INTEROP_DIRTY_X64
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <atomic>
+#include <bit>
+
+#define INTEROP_DIRTY_BITS_PER_WORD 64
+
+namespace Interop::Memory
+{
+
+	// One bit per slot of a shared block: writers set bits with an atomic or, consumers take and clear
+	// whole words with an atomic exchange, so a change is never lost between two collections
+	INTEROP_INLINE u32 GetDirtyWordCount(u32 capacity)
+	{
+		return (capacity + INTEROP_DIRTY_BITS_PER_WORD - 1) / INTEROP_DIRTY_BITS_PER_WORD;
+	}
+
+	INTEROP_INLINE void SetDirty(u64* words, u32 index)
+	{
+		u64 bit = 1ull << (index % INTEROP_DIRTY_BITS_PER_WORD);
+		std::atomic_ref<u64> word(words[index / INTEROP_DIRTY_BITS_PER_WORD]);
+
+		// Always the locked or: a bit seen set may be taken by a collection right after, and skipping the
+		// release would let that collection miss the data written to the slot before this call
+		word.fetch_or(bit, std::memory_order_release);
+	}
+
+	// Moves every dirty bit to the destination, which receives wordCount words, and clears them in place.
+	// Returns the number of dirty slots. Clean words are skipped with SIMD scans, not with atomic operations.
+	INTEROP_API u32 CollectDirty(u64* words, u32 wordCount, u64* destination);
+
+	// Calls fn(index) for every bit set, in increasing order
+	template <typename Fn>
+	INTEROP_INLINE void ForEachDirty(const u64* words, u32 wordCount, Fn&& fn)
+	{
+		for (u32 i = 0; i < wordCount; i++)
+		{
+			for (u64 bits = words[i]; bits != 0; bits &= bits - 1)
+				fn(i * INTEROP_DIRTY_BITS_PER_WORD + static_cast<u32>(std::countr_zero(bits)));
+		}
+	}
+
+}
\ No newline at end of file
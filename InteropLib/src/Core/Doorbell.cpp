@@ -0,0 +1,106 @@
+#include "Core/Definitions.hpp"
+#include "Core/Doorbell.hpp"
+#include "Core/Log.hpp"
+#include "Core/Memory.hpp"
+
+#include "Platform/Platform.hpp"
+
+#include <new>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define INTEROP_CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define INTEROP_CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#define INTEROP_CPU_RELAX() ((void)0)
+#endif
+
+#define INTEROP_FUTEX_WAKE_ALL 0x7FFFFFFF
+
+namespace Interop::Memory
+{
+
+	Doorbell* CreateDoorbell(void* address, b8 eventFd)
+	{
+		if (address == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to create doorbell, no memory provided");
+			return nullptr;
+		}
+
+		Doorbell* doorbell = static_cast<Doorbell*>(address);
+
+		new (&doorbell->Sequence) std::atomic<u32>(0);
+		new (&doorbell->Waiters) std::atomic<u32>(0);
+
+		doorbell->EventFd = eventFd ? Platform::CreateEventFd() : -1;
+		doorbell->Padding = 0;
+
+		return doorbell;
+	}
+
+	Doorbell* ReserveDoorbell(b8 eventFd)
+	{
+		return CreateDoorbell(Reserve(sizeof(Doorbell)), eventFd);
+	}
+
+	void DestroyDoorbell(Doorbell* doorbell)
+	{
+		Platform::CloseEventFd(doorbell->EventFd);
+		doorbell->EventFd = -1;
+	}
+
+	void RingDoorbell(Doorbell* doorbell)
+	{
+		// Sequentially consistent with the waiter registration in WaitDoorbell: either the waiter
+		// sees the new sequence before sleeping, or we see the waiter and wake it
+		doorbell->Sequence.fetch_add(1, std::memory_order_seq_cst);
+
+		if (doorbell->Waiters.load(std::memory_order_seq_cst) != 0)
+			Platform::FutexWake(reinterpret_cast<u32*>(&doorbell->Sequence), INTEROP_FUTEX_WAKE_ALL);
+
+		if (doorbell->EventFd != -1)
+			Platform::SignalEventFd(doorbell->EventFd);
+	}
+
+	u32 ReadDoorbell(const Doorbell* doorbell)
+	{
+		return doorbell->Sequence.load(std::memory_order_acquire);
+	}
+
+	b8 WaitDoorbell(Doorbell* doorbell, u32 observed, u32 timeout, u32 spinCount)
+	{
+		// On a single core, spinning only delays the producer we are waiting for
+		static const b8 s_CanSpin = std::thread::hardware_concurrency() > 1;
+		if (!s_CanSpin) spinCount = 0;
+
+		for (u32 i = 0; i < spinCount; i++)
+		{
+			if (doorbell->Sequence.load(std::memory_order_acquire) != observed)
+				return true;
+
+			INTEROP_CPU_RELAX();
+		}
+
+		u64 now = Platform::GetMonotonicTime();
+		u64 deadline = now + timeout;
+
+		doorbell->Waiters.fetch_add(1, std::memory_order_seq_cst);
+
+		while (doorbell->Sequence.load(std::memory_order_seq_cst) == observed && now < deadline)
+		{
+			Platform::FutexWait(reinterpret_cast<u32*>(&doorbell->Sequence), observed, static_cast<u32>(deadline - now));
+			now = Platform::GetMonotonicTime();
+		}
+
+		doorbell->Waiters.fetch_sub(1, std::memory_order_release);
+
+		return doorbell->Sequence.load(std::memory_order_acquire) != observed;
+	}
+
+}
+
+#undef INTEROP_CPU_RELAX
+#undef INTEROP_FUTEX_WAKE_ALL
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <atomic>
+
+// Iterations spent polling the sequence before a waiter falls asleep on it
+#define INTEROP_DOORBELL_SPIN_COUNT 2048
+
+namespace Interop::Memory
+{
+
+	// Notification primitive living inside the shared memory map. Consumers read the sequence,
+	// check for data and wait for the sequence to move; producers publish data then ring.
+	struct Doorbell
+	{
+		std::atomic<u32> Sequence;
+		std::atomic<u32> Waiters; // Sleeping waiters, rings skip the futex syscall when there are none
+
+		// Optional eventfd signaled on every ring so that consumers can register it with epoll. Its value is
+		// a descriptor of the creating process, only usable there and in the worker processes it forks.
+		i32 EventFd;
+		u32 Padding;
+	};
+
+	static_assert(sizeof(std::atomic<u32>) == sizeof(u32), "Doorbells wait on the address of their sequence");
+
+	INTEROP_API Doorbell* CreateDoorbell(void* address, b8 eventFd = false);
+	INTEROP_API Doorbell* ReserveDoorbell(b8 eventFd = false);
+	INTEROP_API void DestroyDoorbell(Doorbell* doorbell);
+
+	INTEROP_API void RingDoorbell(Doorbell* doorbell);
+	INTEROP_API u32 ReadDoorbell(const Doorbell* doorbell);
+
+	// Spins, then sleeps until the sequence moves away from the observed value or the timeout (ms) expires.
+	// Returns true if the doorbell rang since observed was read.
+	INTEROP_API b8 WaitDoorbell(Doorbell* doorbell, u32 observed, u32 timeout, u32 spinCount = INTEROP_DOORBELL_SPIN_COUNT);
+
+}
\ No newline at end of file
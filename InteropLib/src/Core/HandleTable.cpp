@@ -0,0 +1,265 @@
+#include "Core/Definitions.hpp"
+#include "Core/HandleTable.hpp"
+#include "Core/Log.hpp"
+
+#include <mutex>
+
+// Released GCHandles are handed to managed code in batches of this size, outside the table lock
+#define INTEROP_HANDLE_RELEASE_BATCH 256
+
+#define INTEROP_HANDLE_FREE_LIST_END 0xFFFFFFFFu
+
+namespace Interop::Handles
+{
+
+	struct HandleTable
+	{
+		std::mutex Lock;
+
+		// Pages are never freed nor moved, so readers only need an acquire load to reach a slot
+		std::atomic<HandleSlot*> Pages[INTEROP_HANDLE_MAX_PAGES] = {};
+
+		u32 SlotCount = 0;
+		u32 FreeHead = INTEROP_HANDLE_FREE_LIST_END;
+
+		std::atomic<u32> LiveCount = 0;
+		std::atomic<ReleaseCallbackFn> ReleaseCallback = nullptr;
+	};
+
+	static HandleTable s_Table;
+
+	static INTEROP_INLINE Handle MakeHandle(u32 index, u32 generation)
+	{
+		return (static_cast<u64>(generation) << INTEROP_HANDLE_GENERATION_SHIFT) | (index + 1);
+	}
+
+	static INTEROP_INLINE HandleSlot* FindSlot(Handle handle)
+	{
+		u32 index = static_cast<u32>(handle & INTEROP_HANDLE_INDEX_MASK) - 1;
+		u32 page = index / INTEROP_HANDLE_PAGE_SIZE;
+
+		if (handle == INTEROP_INVALID_HANDLE || page >= INTEROP_HANDLE_MAX_PAGES) [[unlikely]]
+			return nullptr;
+
+		HandleSlot* slots = s_Table.Pages[page].load(std::memory_order_acquire);
+		if (slots == nullptr) [[unlikely]] return nullptr;
+
+		return &slots[index % INTEROP_HANDLE_PAGE_SIZE];
+	}
+
+	// Must only be called for indices already handed out, whose page is allocated
+	static INTEROP_INLINE HandleSlot* SlotAt(u32 index)
+	{
+		return &s_Table.Pages[index / INTEROP_HANDLE_PAGE_SIZE].load(std::memory_order_relaxed)[index % INTEROP_HANDLE_PAGE_SIZE];
+	}
+
+	static INTEROP_INLINE b8 MatchesGeneration(Handle handle, u32 generation)
+	{
+		return generation == static_cast<u32>(handle >> INTEROP_HANDLE_GENERATION_SHIFT);
+	}
+
+	// Must be called with the table lock held
+	static b8 PopFreeSlot(u32* index)
+	{
+		if (s_Table.FreeHead != INTEROP_HANDLE_FREE_LIST_END)
+		{
+			*index = s_Table.FreeHead;
+
+			s_Table.FreeHead = SlotAt(*index)->NextFree;
+
+			return true;
+		}
+
+		u32 page = s_Table.SlotCount / INTEROP_HANDLE_PAGE_SIZE;
+		if (page >= INTEROP_HANDLE_MAX_PAGES) return false;
+
+		if (s_Table.Pages[page].load(std::memory_order_relaxed) == nullptr)
+		{
+			HandleSlot* slots = new HandleSlot[INTEROP_HANDLE_PAGE_SIZE];
+
+			for (u32 i = 0; i < INTEROP_HANDLE_PAGE_SIZE; i++)
+			{
+				slots[i].Generation.store(0, std::memory_order_relaxed);
+				slots[i].NextFree = INTEROP_HANDLE_FREE_LIST_END;
+				slots[i].GCHandle.store(0, std::memory_order_relaxed);
+				slots[i].Address.store(nullptr, std::memory_order_relaxed);
+			}
+
+			s_Table.Pages[page].store(slots, std::memory_order_release);
+		}
+
+		*index = s_Table.SlotCount++;
+
+		return true;
+	}
+
+	// Must be called with the table lock held
+	static void PushFreeSlot(u32 index, HandleSlot* slot)
+	{
+		slot->NextFree = s_Table.FreeHead;
+		s_Table.FreeHead = index;
+	}
+
+	u32 Allocate(const HandleTarget* targets, u32 count, Handle* handles)
+	{
+		if (count == 0) return 0;
+
+		std::lock_guard<std::mutex> lock(s_Table.Lock);
+
+		for (u32 i = 0; i < count; i++)
+		{
+			u32 index = 0;
+
+			if (!PopFreeSlot(&index)) [[unlikely]]
+			{
+				INTEROP_LOG_ERROR("Unable to allocate %u handles, the handle table is full", count);
+
+				// Roll back the handles already taken so that the batch fails as a whole
+				for (u32 j = 0; j < i; j++)
+				{
+					u32 taken = static_cast<u32>(handles[j] & INTEROP_HANDLE_INDEX_MASK) - 1;
+					HandleSlot* slot = SlotAt(taken);
+
+					slot->GCHandle.store(0, std::memory_order_relaxed);
+					slot->Address.store(nullptr, std::memory_order_relaxed);
+					slot->Generation.fetch_add(1, std::memory_order_release);
+
+					PushFreeSlot(taken, slot);
+					handles[j] = INTEROP_INVALID_HANDLE;
+				}
+
+				return 0;
+			}
+
+			HandleSlot* slot = SlotAt(index);
+
+			slot->Address.store(targets[i].Address, std::memory_order_relaxed);
+			slot->GCHandle.store(targets[i].GCHandle, std::memory_order_release);
+
+			handles[i] = MakeHandle(index, slot->Generation.load(std::memory_order_relaxed));
+		}
+
+		s_Table.LiveCount.fetch_add(count, std::memory_order_relaxed);
+
+		return count;
+	}
+
+	u32 Release(const Handle* handles, u32 count)
+	{
+		intptr_t batch[INTEROP_HANDLE_RELEASE_BATCH];
+		u32 released = 0;
+		u32 i = 0;
+
+		while (i < count)
+		{
+			u32 batchSize = 0;
+
+			{
+				std::lock_guard<std::mutex> lock(s_Table.Lock);
+
+				for (; i < count && batchSize < INTEROP_HANDLE_RELEASE_BATCH; i++)
+				{
+					HandleSlot* slot = FindSlot(handles[i]);
+					if (slot == nullptr) continue;
+
+					u32 generation = slot->Generation.load(std::memory_order_relaxed);
+					intptr_t gcHandle = slot->GCHandle.load(std::memory_order_relaxed);
+
+					if (!MatchesGeneration(handles[i], generation) || gcHandle == 0)
+					{
+						INTEROP_LOG_WARNING("Skipping release of stale or invalid handle 0x%016llx", handles[i]);
+						continue;
+					}
+
+					// Bumping the generation first makes concurrent readers reject the slot
+					slot->Generation.store(generation + 1, std::memory_order_release);
+					slot->GCHandle.store(0, std::memory_order_relaxed);
+					slot->Address.store(nullptr, std::memory_order_relaxed);
+
+					PushFreeSlot(static_cast<u32>(handles[i] & INTEROP_HANDLE_INDEX_MASK) - 1, slot);
+					batch[batchSize++] = gcHandle;
+				}
+			}
+
+			if (batchSize == 0) continue;
+
+			s_Table.LiveCount.fetch_sub(batchSize, std::memory_order_relaxed);
+			released += batchSize;
+
+			ReleaseCallbackFn callback = s_Table.ReleaseCallback.load(std::memory_order_acquire);
+
+			if (callback == nullptr) [[unlikely]]
+			{
+				INTEROP_LOG_WARNING("No release callback registered, leaking %u GCHandles", batchSize);
+				continue;
+			}
+
+			callback(batch, batchSize);
+		}
+
+		return released;
+	}
+
+	intptr_t Resolve(Handle handle)
+	{
+		HandleSlot* slot = FindSlot(handle);
+		if (slot == nullptr) [[unlikely]] return 0;
+
+		u32 generation = slot->Generation.load(std::memory_order_acquire);
+		intptr_t gcHandle = slot->GCHandle.load(std::memory_order_acquire);
+
+		// A release racing with the reads above is caught by the generation changing under us
+		if (!MatchesGeneration(handle, generation) || slot->Generation.load(std::memory_order_acquire) != generation) [[unlikely]]
+			return 0;
+
+		return gcHandle;
+	}
+
+	void* GetAddress(Handle handle)
+	{
+		HandleSlot* slot = FindSlot(handle);
+		if (slot == nullptr) [[unlikely]] return nullptr;
+
+		u32 generation = slot->Generation.load(std::memory_order_acquire);
+		void* address = slot->Address.load(std::memory_order_acquire);
+
+		if (!MatchesGeneration(handle, generation) || slot->Generation.load(std::memory_order_acquire) != generation) [[unlikely]]
+			return nullptr;
+
+		return address;
+	}
+
+	CompactHandle Compact(Handle handle)
+	{
+		if (handle == INTEROP_INVALID_HANDLE) return INTEROP_INVALID_HANDLE;
+
+		u32 generation = static_cast<u32>(handle >> INTEROP_HANDLE_GENERATION_SHIFT);
+		return ((generation & 0xFFu) << INTEROP_COMPACT_HANDLE_INDEX_BITS) | static_cast<u32>(handle & INTEROP_HANDLE_INDEX_MASK);
+	}
+
+	Handle Expand(CompactHandle handle)
+	{
+		HandleSlot* slot = FindSlot(handle & INTEROP_COMPACT_HANDLE_INDEX_MASK);
+		if (slot == nullptr) [[unlikely]] return INTEROP_INVALID_HANDLE;
+
+		// A release after this load bumps the generation, which the full handle then no longer matches
+		u32 generation = slot->Generation.load(std::memory_order_acquire);
+		if ((generation & 0xFFu) != handle >> INTEROP_COMPACT_HANDLE_INDEX_BITS) return INTEROP_INVALID_HANDLE;
+
+		return MakeHandle((handle & INTEROP_COMPACT_HANDLE_INDEX_MASK) - 1, generation);
+	}
+
+	void SetReleaseCallback(ReleaseCallbackFn callback)
+	{
+		s_Table.ReleaseCallback.store(callback, std::memory_order_release);
+	}
+
+	u32 GetLiveCount()
+	{
+		return s_Table.LiveCount.load(std::memory_order_relaxed);
+	}
+
+}
+
+#undef INTEROP_HANDLE_RELEASE_BATCH
+#undef INTEROP_HANDLE_FREE_LIST_END
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+// Handles are (generation << 32) | (slot index + 1), so 0 is never a valid handle.
+// A full 32-bit generation keeps a stale handle from matching a reused slot before 2^32 releases of it
+#define INTEROP_INVALID_HANDLE 0
+#define INTEROP_HANDLE_GENERATION_SHIFT 32
+#define INTEROP_HANDLE_INDEX_MASK 0xFFFFFFFFull
+
+// Compact handles of the version 2 exports are (low 8 bits of the generation << 24) | (slot index + 1)
+#define INTEROP_COMPACT_HANDLE_INDEX_BITS 24
+#define INTEROP_COMPACT_HANDLE_INDEX_MASK ((1u << INTEROP_COMPACT_HANDLE_INDEX_BITS) - 1)
+
+#define INTEROP_HANDLE_PAGE_SIZE 4096
+#define INTEROP_HANDLE_MAX_SLOTS INTEROP_COMPACT_HANDLE_INDEX_MASK // Slot indexes plus one fit in compact handles
+#define INTEROP_HANDLE_MAX_PAGES (INTEROP_HANDLE_MAX_SLOTS / INTEROP_HANDLE_PAGE_SIZE)
+
+namespace Interop::Handles
+{
+
+	// Reference to a managed object, owned by the .NET GCHandle stored in its slot
+	typedef u64 Handle;
+	typedef u32 CompactHandle;
+
+	// Called with the GCHandles of released slots, which only managed code is able to free
+	typedef void (INTEROP_DELEGATE_CALLTYPE* ReleaseCallbackFn)(const intptr_t* gcHandles, u32 count);
+
+	struct HandleTarget
+	{
+		intptr_t GCHandle = 0;
+		void* Address = nullptr; // Address of the object data for pinned handles, else nullptr
+	};
+
+	struct HandleSlot
+	{
+		std::atomic<u32> Generation;
+		u32 NextFree;
+
+		std::atomic<intptr_t> GCHandle;
+		std::atomic<void*> Address;
+	};
+
+	// Allocates a handle for each target, returns the number allocated (all or nothing)
+	INTEROP_API u32 Allocate(const HandleTarget* targets, u32 count, Handle* handles);
+
+	// Releases every live handle provided and hands their GCHandles to the release callback,
+	// returns the number of handles actually released (stale or invalid handles are skipped)
+	INTEROP_API u32 Release(const Handle* handles, u32 count);
+
+	// Lock-free, returns 0 or nullptr when the handle is stale or invalid.
+	// Only a release that happened before the call is detected: the GCHandle returned is freed by the
+	// release callback as soon as the handle is released, so whoever releases a handle must own it,
+	// and no other thread may still be resolving it or using the result
+	INTEROP_API intptr_t Resolve(Handle handle);
+	INTEROP_API void* GetAddress(Handle handle);
+
+	// Compact handles only keep 8 bits of the generation, so a stale one matches again after 256 releases of its
+	// slot. Expanding returns the handle of the current generation of the slot, or INTEROP_INVALID_HANDLE.
+	INTEROP_API CompactHandle Compact(Handle handle);
+	INTEROP_API Handle Expand(CompactHandle handle);
+
+	INTEROP_API void SetReleaseCallback(ReleaseCallbackFn callback);
+	INTEROP_API u32 GetLiveCount();
+
+}
\ No newline at end of file
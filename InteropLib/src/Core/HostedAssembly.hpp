@@ -1,12 +1,48 @@
 #pragma once
 
 #include "Core/Definitions.hpp"
+#include "Core/Recorder.hpp"
+#include "Core/Stats.hpp"
+#include "Core/Trace.hpp"
 
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace Interop
 {
 
+	// Function pointer bound from a hosted assembly, invoking it counts the call in the statistics page, records
+	// a trace event while a trace session is running and the call itself while a recording is. It converts back
+	// to the raw pointer when needed.
+	template <typename T>
+	class HostedFunction final
+	{
+	public:
+		HostedFunction(const char* name, T function, Stats::FunctionStats* usage, const char* qualifiedName = nullptr)
+			: Name(name), QualifiedName(qualifiedName != nullptr ? qualifiedName : name), Function(function), Usage(usage) {}
+
+		const char* Name;
+		const char* QualifiedName; // "<class path>.<name>" in full, the name of statistics entries may be cut
+		T Function;
+		Stats::FunctionStats* Usage;
+
+		template <typename... Args>
+		INTEROP_INLINE auto operator()(Args&&... args) const
+		{
+			INTEROP_TRACE_SCOPE(Name, "managed");
+			Stats::AddCall(Usage);
+
+			if (Recorder::IsEnabled()) [[unlikely]]
+				Recorder::RecordCall<T>(Usage, Usage->Name, Recorder::INTEROP_RECORD_KIND_MANAGED, args...);
+
+			return Function(std::forward<Args>(args)...);
+		}
+
+		INTEROP_INLINE operator T() const { return Function; }
+	};
+
 	class HostedAssembly final
 	{
 	public:
@@ -19,11 +55,13 @@ namespace Interop
 		const char* Path;
 
 		std::unordered_map<const char*, void*> Functions = {};
+		std::unordered_map<const char*, std::string> BoundMethods = {}; // "<class path>.<name>" of every function loaded, to pre-warm them
+		std::unordered_map<const char*, Stats::FunctionStats*> FunctionStats = {};
 
 		HostedAssembly& operator=(HostedAssembly&) = delete;
 
 		template <typename T>
-		INTEROP_INLINE T GetFunction(const char* name) const;
+		INTEROP_INLINE HostedFunction<T> GetFunction(const char* name) const;
 
 	private:
 		HostedAssembly() = default;
@@ -35,9 +73,15 @@ namespace Interop
 {
 
 	template <typename T>
-	INTEROP_INLINE T HostedAssembly::GetFunction(const char* name) const
+	INTEROP_INLINE HostedFunction<T> HostedAssembly::GetFunction(const char* name) const
 	{
-		return reinterpret_cast<T>(Functions.at(name));
+		auto usage = FunctionStats.find(name);
+		auto method = BoundMethods.find(name);
+
+		// Functions added to the table by hand are counted under the assembly name
+		return HostedFunction<T>(name, reinterpret_cast<T>(Functions.at(name)),
+			usage != FunctionStats.end() ? usage->second : Stats::RegisterFunction(Name, name),
+			method != BoundMethods.end() ? method->second.c_str() : nullptr);
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,373 @@
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+
+#include "Platform/Platform.hpp"
+
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#ifdef INTEROP_PLATFORM_UNIX
+#include <pthread.h>
+#endif
+
+#define INTEROP_LOG_QUEUE_CAPACITY 1024
+
+namespace Interop::Log
+{
+
+	struct Slot
+	{
+		std::atomic<u32> Sequence;
+		Record Value;
+	};
+
+	// Multi-producer/single-consumer ring feeding the sink thread
+	struct Queue
+	{
+		alignas(64) std::atomic<u32> EnqueuePosition = 0;
+		alignas(64) std::atomic<u32> DequeuePosition = 0;
+		alignas(64) std::atomic<u32> Dropped = 0;
+
+		Slot Slots[INTEROP_LOG_QUEUE_CAPACITY];
+	};
+
+	void DefaultSink(u8 level, const char* file, u32 line, const char* message, void* userData)
+	{
+		printf("%s\n", message);
+	}
+
+	static Queue* s_Queue = nullptr;
+	static std::thread* s_Consumer = nullptr;
+	static std::atomic<b8> s_Running = false;
+	static std::mutex s_StartMutex;
+
+	// The consumer parks on s_Signal when the queue is empty, producers only bump it when it is parked
+	static std::atomic<u32> s_Signal = 0;
+	static std::atomic<b8> s_Parked = false;
+
+	static std::atomic<SinkFn> s_Sink = DefaultSink;
+	static std::atomic<void*> s_SinkUserData = nullptr;
+
+	void ResetQueue()
+	{
+		s_Queue->EnqueuePosition.store(0, std::memory_order_relaxed);
+		s_Queue->DequeuePosition.store(0, std::memory_order_relaxed);
+		s_Queue->Dropped.store(0, std::memory_order_relaxed);
+
+		for (u32 i = 0; i < INTEROP_LOG_QUEUE_CAPACITY; i++)
+			s_Queue->Slots[i].Sequence.store(i, std::memory_order_relaxed);
+	}
+
+	b8 IsReady()
+	{
+		u32 position = s_Queue->DequeuePosition.load(std::memory_order_relaxed);
+		return s_Queue->Slots[position % INTEROP_LOG_QUEUE_CAPACITY].Sequence.load(std::memory_order_acquire) == position + 1;
+	}
+
+	void Wake()
+	{
+		s_Signal.fetch_add(1, std::memory_order_release);
+		s_Signal.notify_one();
+	}
+
+	b8 Dequeue(Record* record)
+	{
+		u32 position = s_Queue->DequeuePosition.load(std::memory_order_relaxed);
+		Slot& slot = s_Queue->Slots[position % INTEROP_LOG_QUEUE_CAPACITY];
+
+		if (slot.Sequence.load(std::memory_order_acquire) != position + 1)
+			return false;
+
+		*record = slot.Value;
+
+		slot.Sequence.store(position + INTEROP_LOG_QUEUE_CAPACITY, std::memory_order_release);
+		s_Queue->DequeuePosition.store(position + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	void Dispatch(const Record& record)
+	{
+		char message[INTEROP_LOG_MESSAGE_CAPACITY];
+		FormatRecord(record, message, INTEROP_LOG_MESSAGE_CAPACITY);
+
+		s_Sink.load(std::memory_order_acquire)(record.Level, record.File, record.Line, message, s_SinkUserData.load(std::memory_order_acquire));
+	}
+
+	void Consume()
+	{
+		Record record;
+
+		while (true)
+		{
+			b8 running = s_Running.load(std::memory_order_acquire);
+			b8 consumed = false;
+
+			while (Dequeue(&record))
+			{
+				Dispatch(record);
+				consumed = true;
+			}
+
+			u32 dropped = s_Queue->Dropped.exchange(0, std::memory_order_relaxed);
+
+			if (dropped > 0)
+			{
+				Record notice;
+				notice.Format = "%u log messages dropped, the log queue was full";
+				notice.Level = INTEROP_LOG_LEVEL_WARNING;
+				Capture(notice, dropped);
+
+				Dispatch(notice);
+			}
+
+			if (!running) break;
+			if (consumed) continue;
+
+			// Paired with the fence in Enqueue: either the producer sees the consumer parked,
+			// or the consumer sees the published slot
+			u32 signal = s_Signal.load(std::memory_order_acquire);
+			s_Parked.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (!IsReady() && s_Running.load(std::memory_order_relaxed))
+				s_Signal.wait(signal, std::memory_order_acquire);
+
+			s_Parked.store(false, std::memory_order_relaxed);
+		}
+	}
+
+#ifdef INTEROP_PLATFORM_UNIX
+	void OnForkChild()
+	{
+		// The consumer thread does not survive fork, and neither do the producers
+		// that were half-way through an enqueue: start from a clean queue
+		s_Consumer = nullptr;
+		s_Running.store(false, std::memory_order_relaxed);
+		s_Parked.store(false, std::memory_order_relaxed);
+
+		new (&s_StartMutex) std::mutex();
+
+		if (s_Queue != nullptr)
+			ResetQueue();
+	}
+#endif
+
+	void Stop()
+	{
+		std::lock_guard<std::mutex> lock(s_StartMutex);
+
+		if (s_Consumer == nullptr)
+			return;
+
+		s_Running.store(false, std::memory_order_release);
+		Wake();
+
+		s_Consumer->join();
+
+		delete s_Consumer;
+		s_Consumer = nullptr;
+	}
+
+	struct Lifetime
+	{
+		~Lifetime() { Stop(); }
+	};
+
+	static Lifetime s_Lifetime;
+
+	INTEROP_NOINLINE void StartConsumer()
+	{
+		std::lock_guard<std::mutex> lock(s_StartMutex);
+
+		if (s_Running.load(std::memory_order_relaxed))
+			return;
+
+		if (s_Queue == nullptr)
+		{
+			s_Queue = new Queue();
+			ResetQueue();
+
+#ifdef INTEROP_PLATFORM_UNIX
+			pthread_atfork(nullptr, nullptr, OnForkChild);
+#endif
+		}
+
+		s_Running.store(true, std::memory_order_release);
+		s_Consumer = new std::thread(Consume);
+	}
+
+	void Enqueue(const Record& record)
+	{
+		if (!s_Running.load(std::memory_order_acquire)) [[unlikely]]
+			StartConsumer();
+
+		u32 position = s_Queue->EnqueuePosition.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			Slot& slot = s_Queue->Slots[position % INTEROP_LOG_QUEUE_CAPACITY];
+			i32 diff = static_cast<i32>(slot.Sequence.load(std::memory_order_acquire) - position);
+
+			if (diff == 0)
+			{
+				if (s_Queue->EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					slot.Value = record;
+					slot.Sequence.store(position + 1, std::memory_order_release);
+
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (s_Parked.load(std::memory_order_relaxed)) Wake();
+
+					return;
+				}
+			}
+
+			else if (diff < 0)
+			{
+				s_Queue->Dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			else
+				position = s_Queue->EnqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	void SetSink(SinkFn sink, void* userData)
+	{
+		Flush();
+
+		s_SinkUserData.store(userData, std::memory_order_release);
+		s_Sink.store(sink != nullptr ? sink : DefaultSink, std::memory_order_release);
+	}
+
+	void Flush()
+	{
+		if (!s_Running.load(std::memory_order_acquire))
+			return;
+
+		u32 target = s_Queue->EnqueuePosition.load(std::memory_order_acquire);
+
+		while (static_cast<i32>(s_Queue->DequeuePosition.load(std::memory_order_acquire) - target) < 0)
+		{
+			if (!s_Running.load(std::memory_order_acquire)) break;
+			Platform::SleepFor(1);
+		}
+	}
+
+	u32 FormatArgument(char* buffer, u32 size, const char* spec, char conversion, const Record& record, const Argument& argument)
+	{
+		char format[32];
+
+		switch (conversion)
+		{
+		case 'd': case 'i':
+		{
+			snprintf(format, sizeof(format), "%sll%c", spec, conversion);
+			i64 value = argument.Type == INTEROP_LOG_ARGUMENT_FLOAT ? static_cast<i64>(argument.Float) : argument.Int;
+
+			return static_cast<u32>(snprintf(buffer, size, format, value));
+		}
+
+		case 'u': case 'o': case 'x': case 'X':
+		{
+			snprintf(format, sizeof(format), "%sll%c", spec, conversion);
+			u64 value = argument.Type == INTEROP_LOG_ARGUMENT_FLOAT ? static_cast<u64>(argument.Float) : argument.UInt;
+
+			return static_cast<u32>(snprintf(buffer, size, format, value));
+		}
+
+		case 'c':
+		{
+			snprintf(format, sizeof(format), "%sc", spec);
+			return static_cast<u32>(snprintf(buffer, size, format, static_cast<i32>(argument.Int)));
+		}
+
+		case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+		{
+			snprintf(format, sizeof(format), "%s%c", spec, conversion);
+			f64 value = argument.Type == INTEROP_LOG_ARGUMENT_FLOAT ? argument.Float
+				: argument.Type == INTEROP_LOG_ARGUMENT_INT ? static_cast<f64>(argument.Int) : static_cast<f64>(argument.UInt);
+
+			return static_cast<u32>(snprintf(buffer, size, format, value));
+		}
+
+		case 's':
+		{
+			snprintf(format, sizeof(format), "%ss", spec);
+			const char* value = argument.Type == INTEROP_LOG_ARGUMENT_STRING ? record.Strings + argument.StringOffset : "(invalid)";
+
+			return static_cast<u32>(snprintf(buffer, size, format, value));
+		}
+
+		case 'p':
+		{
+			snprintf(format, sizeof(format), "%sp", spec);
+			return static_cast<u32>(snprintf(buffer, size, format, argument.Pointer));
+		}
+
+		default:
+			return 0;
+		}
+	}
+
+	void FormatRecord(const Record& record, char* buffer, u32 size)
+	{
+		u32 length = 0;
+		u8 argumentIndex = 0;
+
+		auto append = [&](u32 written)
+		{
+			length = written >= size - length ? size - 1 : length + written;
+		};
+
+		for (const char* c = record.Format; c != nullptr && *c != '\0' && length + 1 < size; c++)
+		{
+			if (*c != '%')
+			{
+				buffer[length++] = *c;
+				continue;
+			}
+
+			if (c[1] == '%')
+			{
+				buffer[length++] = '%';
+				c++;
+
+				continue;
+			}
+
+			// Flags, width and precision are kept, length modifiers are replaced by the captured type
+			char spec[24] = "%";
+			u32 specLength = 1;
+
+			const char* s = c + 1;
+
+			while (*s != '\0' && strchr("-+ #0123456789.", *s) != nullptr)
+			{
+				if (specLength + 1 < sizeof(spec)) spec[specLength++] = *s;
+				s++;
+			}
+
+			spec[specLength] = '\0';
+
+			while (*s != '\0' && strchr("hljztL", *s) != nullptr) s++;
+			if (*s == '\0') break;
+
+			if (argumentIndex < record.ArgumentCount)
+				append(FormatArgument(buffer + length, size - length, spec, *s, record, record.Arguments[argumentIndex++]));
+
+			c = s;
+		}
+
+		if (record.Suppressed > 0 && length + 1 < size)
+			append(static_cast<u32>(snprintf(buffer + length, size - length, " (%u similar messages suppressed)", record.Suppressed)));
+
+		buffer[length] = '\0';
+	}
+
+}
+
+#undef INTEROP_LOG_QUEUE_CAPACITY
\ No newline at end of file
@@ -0,0 +1,245 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+
+#define INTEROP_LOG_LEVEL_TRACE 0
+#define INTEROP_LOG_LEVEL_DEBUG 1
+#define INTEROP_LOG_LEVEL_INFO 2
+#define INTEROP_LOG_LEVEL_WARNING 3
+#define INTEROP_LOG_LEVEL_ERROR 4
+#define INTEROP_LOG_LEVEL_NONE 5
+
+// Messages below this level are stripped at compile time
+#ifndef INTEROP_LOG_MIN_LEVEL
+#ifdef INTEROP_DEBUG
+#define INTEROP_LOG_MIN_LEVEL INTEROP_LOG_LEVEL_DEBUG
+
+#else
+#define INTEROP_LOG_MIN_LEVEL INTEROP_LOG_LEVEL_INFO
+#endif
+#endif
+
+// Messages allowed per call site in each rate limiting window (in milliseconds)
+#ifndef INTEROP_LOG_RATE_LIMIT
+#define INTEROP_LOG_RATE_LIMIT 10
+#endif
+
+#ifndef INTEROP_LOG_RATE_WINDOW
+#define INTEROP_LOG_RATE_WINDOW 1000
+#endif
+
+#define INTEROP_LOG_MAX_ARGUMENTS 8
+#define INTEROP_LOG_STRING_CAPACITY 192
+#define INTEROP_LOG_MESSAGE_CAPACITY 1024
+
+namespace Interop::Log
+{
+
+	enum ArgumentType : u8
+	{
+		INTEROP_LOG_ARGUMENT_INT = 0,
+		INTEROP_LOG_ARGUMENT_UINT = 1,
+		INTEROP_LOG_ARGUMENT_FLOAT = 2,
+		INTEROP_LOG_ARGUMENT_POINTER = 3,
+		INTEROP_LOG_ARGUMENT_STRING = 4,
+	};
+
+	struct Argument
+	{
+		ArgumentType Type;
+
+		union
+		{
+			i64 Int;
+			u64 UInt;
+			f64 Float;
+			const void* Pointer;
+			u16 StringOffset;
+		};
+	};
+
+	// Everything the consumer thread needs to format a message later on:
+	// the format string is stored by pointer, so it must be a literal
+	struct Record
+	{
+		const char* Format = nullptr;
+		const char* File = nullptr;
+		u32 Line = 0;
+		u32 Suppressed = 0;
+		u8 Level = 0;
+		u8 ArgumentCount = 0;
+		u16 StringSize = 0;
+
+		Argument Arguments[INTEROP_LOG_MAX_ARGUMENTS];
+		char Strings[INTEROP_LOG_STRING_CAPACITY];
+	};
+
+	typedef void (*SinkFn)(u8 level, const char* file, u32 line, const char* message, void* userData);
+
+	INTEROP_API void SetSink(SinkFn sink, void* userData = nullptr);
+	INTEROP_API void Flush();
+
+	INTEROP_API void Enqueue(const Record& record);
+	INTEROP_API void FormatRecord(const Record& record, char* buffer, u32 size);
+
+	class RateLimiter final
+	{
+	public:
+		constexpr RateLimiter() = default;
+
+		INTEROP_INLINE b8 Allow(u32* suppressed)
+		{
+			u64 now = static_cast<u64>(std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+
+			u64 windowStart = m_WindowStart.load(std::memory_order_relaxed);
+
+			if (now - windowStart >= INTEROP_LOG_RATE_WINDOW)
+			{
+				if (m_WindowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed))
+					m_Count.store(0, std::memory_order_relaxed);
+			}
+
+			if (m_Count.fetch_add(1, std::memory_order_relaxed) < INTEROP_LOG_RATE_LIMIT)
+			{
+				*suppressed = m_Suppressed.exchange(0, std::memory_order_relaxed);
+				return true;
+			}
+
+			m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+	private:
+		std::atomic<u64> m_WindowStart{ 0 };
+		std::atomic<u32> m_Count{ 0 };
+		std::atomic<u32> m_Suppressed{ 0 };
+	};
+
+	INTEROP_INLINE void CaptureString(Record& record, Argument& argument, const char* value)
+	{
+		argument.Type = INTEROP_LOG_ARGUMENT_STRING;
+		argument.StringOffset = record.StringSize;
+
+		u16 available = static_cast<u16>(INTEROP_LOG_STRING_CAPACITY - record.StringSize);
+		if (available == 0) return;
+
+		if (value == nullptr) value = "(null)";
+
+		u16 length = 0;
+		while (length + 1 < available && value[length] != '\0') length++;
+
+		memcpy(record.Strings + record.StringSize, value, length);
+		record.Strings[record.StringSize + length] = '\0';
+		record.StringSize = static_cast<u16>(record.StringSize + length + 1);
+	}
+
+	template <typename T>
+	INTEROP_INLINE void Capture(Record& record, const T& value)
+	{
+		using Decayed = std::decay_t<T>;
+		Argument& argument = record.Arguments[record.ArgumentCount++];
+
+		if constexpr (std::is_same_v<Decayed, char*> || std::is_same_v<Decayed, const char*>)
+		{
+			CaptureString(record, argument, value);
+		}
+
+		else if constexpr (std::is_floating_point_v<Decayed>)
+		{
+			argument.Type = INTEROP_LOG_ARGUMENT_FLOAT;
+			argument.Float = static_cast<f64>(value);
+		}
+
+		else if constexpr (std::is_integral_v<Decayed> || std::is_enum_v<Decayed>)
+		{
+			if constexpr (std::is_signed_v<Decayed> || std::is_enum_v<Decayed>)
+			{
+				argument.Type = INTEROP_LOG_ARGUMENT_INT;
+				argument.Int = static_cast<i64>(value);
+			}
+
+			else
+			{
+				argument.Type = INTEROP_LOG_ARGUMENT_UINT;
+				argument.UInt = static_cast<u64>(value);
+			}
+		}
+
+		else
+		{
+			static_assert(std::is_pointer_v<Decayed>, "Unsupported log argument type");
+
+			argument.Type = INTEROP_LOG_ARGUMENT_POINTER;
+			argument.Pointer = static_cast<const void*>(value);
+		}
+	}
+
+	// Captures the arguments on the calling thread, formatting happens on the consumer thread
+	template <typename... Args>
+	INTEROP_NOINLINE void Write(u8 level, const char* file, u32 line, u32 suppressed, const char* format, const Args&... args)
+	{
+		static_assert(sizeof...(Args) <= INTEROP_LOG_MAX_ARGUMENTS, "Too many log arguments");
+
+		Record record;
+		record.Format = format;
+		record.File = file;
+		record.Line = line;
+		record.Suppressed = suppressed;
+		record.Level = level;
+
+		(Capture(record, args), ...);
+
+		Enqueue(record);
+	}
+
+}
+
+#define INTEROP_LOG(level, format, ...) \
+	do \
+	{ \
+		static ::Interop::Log::RateLimiter s_LogRateLimiter; \
+		u32 logSuppressed = 0; \
+		if (s_LogRateLimiter.Allow(&logSuppressed)) \
+			::Interop::Log::Write(level, __FILE__, __LINE__, logSuppressed, format, ##__VA_ARGS__); \
+	} while (0)
+
+#if INTEROP_LOG_MIN_LEVEL <= INTEROP_LOG_LEVEL_TRACE
+#define INTEROP_LOG_TRACE(format, ...) INTEROP_LOG(INTEROP_LOG_LEVEL_TRACE, format, ##__VA_ARGS__)
+
+#else
+#define INTEROP_LOG_TRACE(format, ...) do {} while (0)
+#endif
+
+#if INTEROP_LOG_MIN_LEVEL <= INTEROP_LOG_LEVEL_DEBUG
+#define INTEROP_LOG_DEBUG(format, ...) INTEROP_LOG(INTEROP_LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+
+#else
+#define INTEROP_LOG_DEBUG(format, ...) do {} while (0)
+#endif
+
+#if INTEROP_LOG_MIN_LEVEL <= INTEROP_LOG_LEVEL_INFO
+#define INTEROP_LOG_INFO(format, ...) INTEROP_LOG(INTEROP_LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+
+#else
+#define INTEROP_LOG_INFO(format, ...) do {} while (0)
+#endif
+
+#if INTEROP_LOG_MIN_LEVEL <= INTEROP_LOG_LEVEL_WARNING
+#define INTEROP_LOG_WARNING(format, ...) INTEROP_LOG(INTEROP_LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+
+#else
+#define INTEROP_LOG_WARNING(format, ...) do {} while (0)
+#endif
+
+#if INTEROP_LOG_MIN_LEVEL <= INTEROP_LOG_LEVEL_ERROR
+#define INTEROP_LOG_ERROR(format, ...) INTEROP_LOG(INTEROP_LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+
+#else
+#define INTEROP_LOG_ERROR(format, ...) do {} while (0)
+#endif
\ No newline at end of file
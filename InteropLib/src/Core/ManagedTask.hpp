@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#define INTEROP_TASK_ERROR_SIZE 128
+
+namespace Interop::Tasks
+{
+
+	enum TaskStatus
+	{
+		INTEROP_TASK_STATUS_PENDING = 0,
+		INTEROP_TASK_STATUS_SUCCEEDED = 1,
+		INTEROP_TASK_STATUS_FAILED = 2,
+		INTEROP_TASK_STATUS_CANCELED = 3,
+	};
+
+	// Called by managed code (Interop.Core.Native.TaskBridge) once the Task finishes, from any thread
+	typedef void (INTEROP_DELEGATE_CALLTYPE* CompletionFn)(void* state, i32 status, const void* result, u32 resultSize, const char* error);
+
+	// Signature of the managed async entry points: start the Task, hand it to TaskBridge and return
+	typedef void (INTEROP_DELEGATE_CALLTYPE* AsyncEntryFn)(void* state, CompletionFn completion, const void* argument);
+
+	// Posts a suspended coroutine back to an event loop instead of resuming it on the completing thread
+	typedef void (*ResumeFn)(std::coroutine_handle<> handle, void* userData);
+
+	// Result of managed Tasks without a result
+	struct Unit {};
+
+	template <typename T>
+	struct TaskResult
+	{
+		TaskStatus Status = INTEROP_TASK_STATUS_PENDING;
+		T Value = {};
+		char Error[INTEROP_TASK_ERROR_SIZE] = {};
+
+		b8 Succeeded() const { return Status == INTEROP_TASK_STATUS_SUCCEEDED; }
+	};
+
+	// Awaitable starting a managed async method and resuming the awaiting coroutine when its Task completes.
+	// Everything lives in the awaiter, hence in the coroutine frame: nothing is allocated per operation.
+	template <typename T = Unit>
+	class ManagedTask final
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Managed Task results must be blittable");
+
+	public:
+		ManagedTask(AsyncEntryFn entry, const void* argument = nullptr, ResumeFn resume = nullptr, void* userData = nullptr)
+			: m_Entry(entry), m_Argument(argument), m_Resume(resume), m_UserData(userData) {}
+
+		ManagedTask(const ManagedTask&) = delete;
+		ManagedTask& operator=(const ManagedTask&) = delete;
+
+		bool await_ready() const noexcept { return false; }
+
+		bool await_suspend(std::coroutine_handle<> handle) noexcept
+		{
+			m_Handle = handle;
+			m_Entry(this, &ManagedTask::OnCompleted, m_Argument);
+
+			// Whoever comes second resumes: the completion callback if we get here first, else us, synchronously
+			return m_Rendezvous.exchange(true, std::memory_order_acq_rel) == false;
+		}
+
+		TaskResult<T> await_resume() noexcept
+		{
+			return m_Result;
+		}
+
+	private:
+		static void INTEROP_DELEGATE_CALLTYPE OnCompleted(void* state, i32 status, const void* result, u32 resultSize, const char* error)
+		{
+			ManagedTask* task = static_cast<ManagedTask*>(state);
+			TaskResult<T>& output = task->m_Result;
+
+			output.Status = static_cast<TaskStatus>(status);
+
+			if (status == INTEROP_TASK_STATUS_SUCCEEDED)
+			{
+				if (resultSize == sizeof(T) && result != nullptr)
+					memcpy(&output.Value, result, sizeof(T));
+
+				else if (!(std::is_empty_v<T> && resultSize == 0)) [[unlikely]]
+				{
+					output.Status = INTEROP_TASK_STATUS_FAILED;
+					snprintf(output.Error, INTEROP_TASK_ERROR_SIZE, "Managed result size (%u) does not match the native one (%u)", resultSize, static_cast<u32>(sizeof(T)));
+				}
+			}
+
+			else if (error != nullptr)
+			{
+				strncpy(output.Error, error, INTEROP_TASK_ERROR_SIZE - 1);
+			}
+
+			if (task->m_Rendezvous.exchange(true, std::memory_order_acq_rel) == false)
+				return;
+
+			if (task->m_Resume != nullptr)
+				task->m_Resume(task->m_Handle, task->m_UserData);
+
+			else
+				task->m_Handle.resume();
+		}
+
+		AsyncEntryFn m_Entry;
+		const void* m_Argument;
+		ResumeFn m_Resume;
+		void* m_UserData;
+
+		std::coroutine_handle<> m_Handle = {};
+		std::atomic<b8> m_Rendezvous = false;
+
+		TaskResult<T> m_Result = {};
+	};
+
+}
\ No newline at end of file
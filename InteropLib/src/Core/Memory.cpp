@@ -1,18 +1,103 @@
 #include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
 #include "Core/Memory.hpp"
+#include "Core/Stats.hpp"
 
 #include "Platform/Platform.hpp"
 
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#define INTEROP_CHECKSUM_SEED 0xCBF29CE484222325ull
+#define INTEROP_CHECKSUM_PRIME 0x100000001B3ull
+
 namespace Interop::Memory
 {
 
 	State* State::s_Instance = nullptr;
 
-	b8 Init(State** state)
+	static u64 HashBytes(u64 hash, const void* data, u64 size)
+	{
+		const u8* bytes = static_cast<const u8*>(data);
+		u64 i = 0;
+
+		// FNV-1a over 8-byte words, byte-wise on the tail
+		for (; i + sizeof(u64) <= size; i += sizeof(u64))
+		{
+			u64 word;
+			memcpy(&word, bytes + i, sizeof(u64));
+
+			hash = (hash ^ word) * INTEROP_CHECKSUM_PRIME;
+		}
+
+		for (; i < size; i++)
+			hash = (hash ^ bytes[i]) * INTEROP_CHECKSUM_PRIME;
+
+		return hash;
+	}
+
+	u64 HashTypeName(const char* typeName)
+	{
+		return HashBytes(INTEROP_CHECKSUM_SEED, typeName, strlen(typeName));
+	}
+
+	static u64 ComputeChecksum(const PersistentHeader* header, const void* data)
+	{
+		u64 hash = HashBytes(INTEROP_CHECKSUM_SEED, header, offsetof(PersistentHeader, Checksum));
+		hash = HashBytes(hash, &header->BlockCount, sizeof(PersistentHeader) - offsetof(PersistentHeader, BlockCount));
+
+		return HashBytes(hash, data, header->ReservedSize);
+	}
+
+	static b8 AttachPersistentRegion(State* state)
+	{
+		SharedBuffer* alloc = state->Allocation;
+		PersistentHeader* header = reinterpret_cast<PersistentHeader*>((char*)alloc->BaseAddress + alloc->Size);
+
+		state->Persistent = header;
+
+		b8 valid = header->Magic == INTEROP_PERSISTENT_MAGIC
+			&& header->LayoutVersion == INTEROP_PERSISTENT_LAYOUT_VERSION
+			&& header->RegionSize == alloc->Size
+			&& header->ReservedSize <= alloc->Size
+			&& header->BlockCount <= INTEROP_PERSISTENT_MAX_BLOCKS;
+
+		if (valid && header->Checksum == ComputeChecksum(header, alloc->BaseAddress))
+		{
+			alloc->ReservedSize.store(header->ReservedSize, std::memory_order_relaxed);
+
+			INTEROP_LOG_INFO("Restored persistent shared memory \"%s\" (blocks: %u, checkpoints: %llu)", alloc->Path, header->BlockCount, header->Checkpoints);
+			return true;
+		}
+
+		// The checksum only matches at checkpoints, the content of a region in use elsewhere is live data
+		if (!alloc->Exclusive)
+		{
+			INTEROP_LOG_ERROR("Unable to attach persistent shared memory \"%s\", its layout or checksum does not match and another process is using it", alloc->Path);
+			return false;
+		}
+
+		if (header->Magic != 0)
+		{
+			INTEROP_LOG_WARNING("Discarding persistent shared memory \"%s\", its layout or checksum does not match", alloc->Path);
+		}
+
+		memset(alloc->BaseAddress, 0, alloc->MappedSize);
+		new (header) PersistentHeader();
+
+		header->Magic = INTEROP_PERSISTENT_MAGIC;
+		header->LayoutVersion = INTEROP_PERSISTENT_LAYOUT_VERSION;
+		header->RegionSize = alloc->Size;
+
+		return true;
+	}
+
+	b8 Init(State** state, const char* persistentPath, u32 size)
 	{
 		if (State::s_Instance != nullptr) [[unlikely]]
 		{
-			printf("%s\n", "Trying to re-initialize existing Shared Memory System Aborting.");
+			INTEROP_LOG_WARNING("Trying to re-initialize existing Shared Memory System Aborting.");
 			return false;
 		}
 
@@ -21,13 +106,19 @@ namespace Interop::Memory
 
 		State::s_Instance->Allocation = new SharedBuffer();
 		State::s_Instance->Allocation->Name = "Controller";
-		State::s_Instance->Allocation->Size = 8192;
+		State::s_Instance->Allocation->Size = static_cast<u32>(INTEROP_ALIGNED_SIZE(size)); // As mapped by the platform layer
+
+		if (persistentPath != nullptr)
+		{
+			State::s_Instance->Allocation->Path = persistentPath;
+			State::s_Instance->Allocation->MappedSize = State::s_Instance->Allocation->Size + sizeof(PersistentHeader);
+		}
 
 		b8 success = Platform::OpenOrCreateMemoryMap(State::s_Instance->Allocation);
 
 		if (!success)
 		{
-			printf("%s\n", "Unable to create shared memory area for inter-process operability");
+			INTEROP_LOG_ERROR("Unable to create shared memory area for inter-process operability");
 
 			delete State::s_Instance->Allocation;
 			delete State::s_Instance;
@@ -38,6 +129,27 @@ namespace Interop::Memory
 			return false;
 		}
 
+		if (persistentPath != nullptr)
+		{
+			b8 attached = AttachPersistentRegion(State::s_Instance);
+			Platform::EndExclusiveAccess(State::s_Instance->Allocation);
+
+			if (!attached)
+			{
+				Platform::CloseMemoryMap(State::s_Instance->Allocation);
+
+				delete State::s_Instance->Allocation;
+				delete State::s_Instance;
+
+				State::s_Instance = nullptr;
+				*state = nullptr;
+
+				return false;
+			}
+		}
+
+		Stats::RecordReserved(State::s_Instance->Allocation->ReservedSize, State::s_Instance->Allocation->Size);
+
 		return true;
 	}
 
@@ -45,7 +157,7 @@ namespace Interop::Memory
 	{
 		if (State::s_Instance != *state) [[unlikely]]
 		{
-			printf("%s\n", "Trying to destroy a different Shared Memory System than the one initialized");
+			INTEROP_LOG_WARNING("Trying to destroy a different Shared Memory System than the one initialized");
 			delete *state;
 		}
 
@@ -53,25 +165,26 @@ namespace Interop::Memory
 		{
 			if (State::s_Instance->Allocation->State == INTEROP_MEMORY_MAP_STATE_OPEN)
 			{
+				if (State::s_Instance->Persistent != nullptr && !Checkpoint())
+				{
+					INTEROP_LOG_ERROR("Unable to checkpoint persistent shared memory before closing it, it will be discarded on the next attach");
+				}
+
 				b8 success = Platform::CloseMemoryMap(State::s_Instance->Allocation);
 
 				if (!success)
 				{
-					printf("%s\n", "Unable to close properly shared memory area between controller and hosted libraries");
+					INTEROP_LOG_ERROR("Unable to close properly shared memory area between controller and hosted libraries");
 				}
 			}
 
 			delete State::s_Instance->Allocation;
 		}
 
-		if (!State::s_Instance->TypePools.empty())
+		for (TypeSlot& slot : State::s_Instance->TypePools)
 		{
-			for (auto it = State::s_Instance->TypePools.begin(); it != State::s_Instance->TypePools.end(); it++)
-			{
-				delete it->second;
-			}
-
-			State::s_Instance->TypePools.clear();
+			if (slot.Key.load(std::memory_order_relaxed) != 0)
+				delete slot.Block;
 		}
 
 		delete State::s_Instance;
@@ -80,4 +193,227 @@ namespace Interop::Memory
 		*state = nullptr;
 	}
 
-}
\ No newline at end of file
+	// Bumps the reserved offset with a CAS loop rather than a plain fetch_add, so that aligned
+	// requests do not waste space and a failed one leaves the offset untouched for smaller ones.
+	// Requests past the end are clamped to what is left, if that still holds minSize bytes.
+	static b8 ReserveRange(SharedBuffer* alloc, u32* size, u32 alignment, u32 minSize, u32* offset)
+	{
+		u32 reserved = alloc->ReservedSize.load(std::memory_order_relaxed);
+		u32 start = 0;
+		u32 length = 0;
+
+		do
+		{
+			start = (reserved + alignment - 1) & ~(alignment - 1);
+			length = *size;
+
+			if (start >= alloc->Size) return false;
+
+			if (length > alloc->Size - start)
+			{
+				if (alloc->Size - start < minSize) return false;
+				length = alloc->Size - start;
+			}
+		} while (!alloc->ReservedSize.compare_exchange_weak(reserved, start + length, std::memory_order_relaxed));
+
+		Stats::RecordReserved(alloc->ReservedSize, alloc->Size);
+
+		*offset = start;
+		*size = length;
+
+		return true;
+	}
+
+	void* Reserve(u32 size, u32 alignment)
+	{
+		if (State::s_Instance == nullptr || State::s_Instance->Allocation->State == INTEROP_MEMORY_MAP_STATE_CLOSED) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to use shared memory as it has not been opened");
+			return nullptr;
+		}
+
+		SharedBuffer* alloc = State::s_Instance->Allocation;
+		u32 offset = 0;
+
+		if (size == 0 || !ReserveRange(alloc, &size, alignment, size, &offset))
+		{
+			Stats::RecordReservationFailure();
+			INTEROP_LOG_ERROR("Unable to reserve %u bytes of shared memory (%u bytes left)", size, alloc->Size - alloc->ReservedSize.load(std::memory_order_relaxed));
+			return nullptr;
+		}
+
+		return (void*)((char*)alloc->BaseAddress + offset);
+	}
+
+	b8 Unreserve(void* address, u32 size)
+	{
+		if (State::s_Instance == nullptr || State::s_Instance->Allocation->State == INTEROP_MEMORY_MAP_STATE_CLOSED) [[unlikely]]
+			return false;
+
+		SharedBuffer* alloc = State::s_Instance->Allocation;
+		u32 offset = static_cast<u32>((char*)address - (char*)alloc->BaseAddress);
+		u32 end = offset + size;
+
+		if (!alloc->ReservedSize.compare_exchange_strong(end, offset, std::memory_order_relaxed))
+			return false;
+
+		Stats::RecordReserved(alloc->ReservedSize, alloc->Size);
+		return true;
+	}
+
+	b8 EnableDirtyTracking(SharedBlock* block)
+	{
+		State* state = State::s_Instance;
+		std::lock_guard<std::mutex> lock(state->CreationLock);
+
+		if (block->DirtyBits.load(std::memory_order_relaxed) != nullptr)
+			return true;
+
+		u32 wordCount = GetDirtyWordCount(block->Capacity);
+		u64* bits = static_cast<u64*>(Reserve(wordCount * sizeof(u64)));
+
+		if (bits == nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to reserve the dirty bitmap of a shared memory block (%u slots)", block->Capacity);
+			return false;
+		}
+
+		memset(bits, 0, wordCount * sizeof(u64));
+
+		block->DirtyWordCount = wordCount;
+		block->DirtyBits.store(bits, std::memory_order_release);
+
+		return true;
+	}
+
+	b8 Checkpoint()
+	{
+		if (State::s_Instance == nullptr || State::s_Instance->Persistent == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to checkpoint shared memory, no persistent region is open");
+			return false;
+		}
+
+		SharedBuffer* alloc = State::s_Instance->Allocation;
+		PersistentHeader* header = State::s_Instance->Persistent;
+
+		header->ReservedSize = alloc->ReservedSize.load(std::memory_order_relaxed);
+		header->Checkpoints++;
+		header->Checksum = ComputeChecksum(header, alloc->BaseAddress);
+
+		return Platform::FlushMemoryMap(alloc);
+	}
+
+	static SharedBlock* RestoreBlock(const char* typeName, u32 elementSize)
+	{
+		PersistentHeader* header = State::s_Instance->Persistent;
+		if (header == nullptr) return nullptr;
+
+		u64 typeHash = HashTypeName(typeName);
+
+		for (u32 i = 0; i < header->BlockCount; i++)
+		{
+			const PersistentBlock& entry = header->Blocks[i];
+			if (entry.TypeHash != typeHash) continue;
+
+			if (entry.ElementSize != elementSize)
+			{
+				INTEROP_LOG_WARNING("Unable to restore persistent block of type \"%s\", its size changed (%u -> %u)", typeName, entry.ElementSize, elementSize);
+				return nullptr;
+			}
+
+			SharedBlock* block = new SharedBlock();
+
+			block->BaseAddress = (void*)((char*)State::s_Instance->Allocation->BaseAddress + entry.Offset);
+			block->Offset = entry.Offset;
+			block->Capacity = entry.Capacity;
+			block->Size = entry.Size;
+			block->Used.store(entry.Capacity, std::memory_order_relaxed);
+
+			return block;
+		}
+
+		return nullptr;
+	}
+
+	static void RecordBlock(const char* typeName, u32 elementSize, const SharedBlock* block)
+	{
+		PersistentHeader* header = State::s_Instance->Persistent;
+		if (header == nullptr) return;
+
+		if (header->BlockCount == INTEROP_PERSISTENT_MAX_BLOCKS)
+		{
+			INTEROP_LOG_WARNING("Unable to record block of type \"%s\" in the persistent directory, it will not be restored", typeName);
+			return;
+		}
+
+		PersistentBlock& entry = header->Blocks[header->BlockCount++];
+
+		entry.TypeHash = HashTypeName(typeName);
+		entry.ElementSize = elementSize;
+		entry.Offset = block->Offset;
+		entry.Capacity = block->Capacity;
+		entry.Size = block->Size;
+	}
+
+	SharedBlock* CreateBlock(u64 key, const char* typeName, u32 elementSize)
+	{
+		State* state = State::s_Instance;
+		std::lock_guard<std::mutex> lock(state->CreationLock);
+
+		// Another thread may have published the block while we were waiting for the lock
+		SharedBlock* block = FindBlock(state, key);
+		if (block != nullptr) return block;
+
+		// Writers are serialized by the lock, so the first free slot of the probe sequence stays free
+		u32 index = static_cast<u32>(key) & (INTEROP_MEMORY_MAX_TYPES - 1);
+		u32 probe = 0;
+
+		for (; probe < INTEROP_MEMORY_MAX_TYPES && state->TypePools[index].Key.load(std::memory_order_relaxed) != 0; probe++)
+			index = (index + 1) & (INTEROP_MEMORY_MAX_TYPES - 1);
+
+		if (probe == INTEROP_MEMORY_MAX_TYPES) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to register shared memory block of type \"%s\", the type registry is full (%u types)", typeName, INTEROP_MEMORY_MAX_TYPES);
+			return nullptr;
+		}
+
+		block = RestoreBlock(typeName, elementSize);
+
+		if (block == nullptr)
+		{
+			u32 blockSize = INTEROP_ALIGNED_SIZE(1000 * elementSize);
+			u32 offset = 0;
+
+			// Cache-aligned, so that parallel passes split blocks on line boundaries.
+			// Clamped to what is left of the map, as long as one element still fits.
+			if (!ReserveRange(state->Allocation, &blockSize, 64, elementSize, &offset))
+			{
+				Stats::RecordReservationFailure();
+				return nullptr;
+			}
+
+			block = new SharedBlock();
+
+			block->BaseAddress = (void*)((char*)state->Allocation->BaseAddress + offset);
+			block->Offset = offset;
+			block->Capacity = blockSize / elementSize;
+			block->Size = blockSize;
+
+			RecordBlock(typeName, elementSize, block);
+		}
+
+		block->Usage = Stats::RegisterBlock(typeName, elementSize, block->Capacity);
+
+		TypeSlot& slot = state->TypePools[index];
+
+		slot.Block = block;
+		slot.Key.store(key, std::memory_order_release);
+
+		return block;
+	}
+
+}
+
+#undef INTEROP_CHECKSUM_SEED
+#undef INTEROP_CHECKSUM_PRIME
\ No newline at end of file
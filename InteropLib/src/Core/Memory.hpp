@@ -1,9 +1,28 @@
 #pragma once
 
 #include "Core/Definitions.hpp"
+#include "Core/DirtyBitmap.hpp"
+#include "Core/Log.hpp"
+#include "Core/Parallel.hpp"
+#include "Core/Stats.hpp"
+#include "Core/Trace.hpp"
 
-#include <typeindex>
-#include <unordered_map>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <typeinfo>
+
+#define INTEROP_MEMORY_DEFAULT_SIZE 8192
+
+// Size of the open-addressed type registry, must be a power of two
+#define INTEROP_MEMORY_MAX_TYPES 256
+
+#define INTEROP_PERSISTENT_MAGIC 0x504F5249 // "IROP"
+#define INTEROP_PERSISTENT_LAYOUT_VERSION 1
+#define INTEROP_PERSISTENT_MAX_BLOCKS 64
 
 namespace Interop::Memory
 {
@@ -20,7 +39,11 @@ namespace Interop::Memory
 		const char* Name;
 
 		u32 Size = 0;
-		u32 ReservedSize = 0;
+		std::atomic<u32> ReservedSize = 0; // Bumped without locks, see Reserve
+		u32 MappedSize = 0; // Size plus the persistent header, if any
+
+		const char* Path = nullptr; // Backing file of persistent maps, never unlinked on close
+		b8 Exclusive = false; // No other process had the persistent map open, until Platform::EndExclusiveAccess
 
 		void* NativeHandle = nullptr;
 		void* BaseAddress = nullptr;
@@ -32,57 +55,174 @@ namespace Interop::Memory
 		u32 Offset = 0;
 		u32 Capacity = 0;
 		u32 Size = 0;
+
+		// Dirty bitmap in the shared area, published once EnableDirtyTracking succeeded
+		std::atomic<u64*> DirtyBits = nullptr;
+		u32 DirtyWordCount = 0;
+
+		Stats::BlockStats* Usage = nullptr; // Entry of the statistics page, never null once published
+
+		// Highest slot handed out by Get or written through Set or MarkDirty, plus one.
+		// Restored blocks start with their whole capacity in use.
+		std::atomic<u32> Used = 0;
+	};
+
+	struct PersistentBlock
+	{
+		u64 TypeHash = 0;
+		u32 ElementSize = 0;
+		u32 Offset = 0;
+		u32 Capacity = 0;
+		u32 Size = 0;
 	};
 
+	// Stored right after the usable area of persistent maps, so that block offsets are the same in both modes.
+	// The checksum covers the header and the reserved area as of the last checkpoint: a region modified
+	// after its last checkpoint (e.g. by a crashed process) is discarded on the next attach.
+	struct PersistentHeader
+	{
+		u32 Magic = 0;
+		u32 LayoutVersion = 0;
+		u32 RegionSize = 0;
+		u32 ReservedSize = 0;
+
+		u64 Checksum = 0;
+		u64 Checkpoints = 0;
+
+		u32 BlockCount = 0;
+		u32 Padding = 0;
+
+		PersistentBlock Blocks[INTEROP_PERSISTENT_MAX_BLOCKS];
+	};
+
+	// Entry of the type registry: the block is written before the key is published,
+	// and neither changes afterwards, so readers only need an acquire load of the key
+	struct TypeSlot
+	{
+		std::atomic<u64> Key;
+		SharedBlock* Block;
+	};
+
+	struct SlabHeap;
+
 	struct State
 	{
 		SharedBuffer* Allocation = nullptr;
-		std::unordered_map<std::type_index, SharedBlock*> TypePools = {};
+		PersistentHeader* Persistent = nullptr;
+		SlabHeap* Slabs = nullptr; // See ReserveSlabHeap
+
+		TypeSlot TypePools[INTEROP_MEMORY_MAX_TYPES] = {};
+		std::mutex CreationLock; // Serializes one-time setups: blocks, dirty bitmaps and the slab heap
 
 		INTEROP_API static State* s_Instance;
 	};
 
-	INTEROP_API b8 Init(State** state);
+	// A persistent path keeps the region and its type pools across restarts, see PersistentHeader
+	INTEROP_API b8 Init(State** state, const char* persistentPath = nullptr, u32 size = INTEROP_MEMORY_DEFAULT_SIZE);
 	INTEROP_API void Destroy(State** state);
 
+	// Flushes a persistent region to its backing file, writers should be quiescent while it runs
+	INTEROP_API b8 Checkpoint();
+
+	// Ranges returned by Reserve are not part of the block directory, so they are not restored
+	INTEROP_API void* Reserve(u32 size, u32 alignment = 64);
+
+	// Gives a range back to the shared buffer, which only works while it is the last range reserved:
+	// ranges are bump-allocated. Returns false when it is not, the range then stays reserved.
+	INTEROP_API b8 Unreserve(void* address, u32 size);
+
+	INTEROP_API u64 HashTypeName(const char* typeName);
+
+	// Slow path of GetOrCreateBlock, restores or reserves the block of a type and publishes it once
+	INTEROP_API SharedBlock* CreateBlock(u64 key, const char* typeName, u32 elementSize);
+
 	template <typename T>
-	INTEROP_API SharedBlock* GetOrCreateBlock()
+	INTEROP_INLINE u64 GetTypeKey()
+	{
+		// Hashing the name rather than using the type_info address keeps keys identical across modules,
+		// the low bit is forced so that a key is never 0, which marks free registry slots
+		static const u64 key = HashTypeName(typeid(T).name()) | 1;
+		return key;
+	}
+
+	INTEROP_INLINE SharedBlock* FindBlock(const State* state, u64 key)
 	{
-		auto& alloc = State::s_Instance->Allocation;
+		u32 index = static_cast<u32>(key) & (INTEROP_MEMORY_MAX_TYPES - 1);
 
-		if (alloc->State == INTEROP_MEMORY_MAP_STATE_CLOSED) [[unlikely]]
+		for (u32 probe = 0; probe < INTEROP_MEMORY_MAX_TYPES; probe++)
 		{
-			printf("%s\n", "Unable to use shared memory as it has not been opened");
-			return nullptr;
+			const TypeSlot& slot = state->TypePools[index];
+			u64 slotKey = slot.Key.load(std::memory_order_acquire);
+
+			if (slotKey == key) return slot.Block;
+			if (slotKey == 0) return nullptr;
+
+			index = (index + 1) & (INTEROP_MEMORY_MAX_TYPES - 1);
 		}
 
-		auto& pools = State::s_Instance->TypePools;
+		return nullptr;
+	}
+
+	// Safe to call from any thread: once a type has its block, resolving it takes no lock
+	template <typename T>
+	INTEROP_API SharedBlock* GetOrCreateBlock()
+	{
+		State* state = State::s_Instance;
 
-		if (pools.find(typeid(T)) != pools.end())
-			return pools[typeid(T)];
+		if (state->Allocation->State == INTEROP_MEMORY_MAP_STATE_CLOSED) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to use shared memory as it has not been opened");
+			return nullptr;
+		}
 
-		u32 blockSize = INTEROP_ALIGNED_SIZE(1000 * sizeof(T));
+		SharedBlock* block = FindBlock(state, GetTypeKey<T>());
 
-		if (alloc->ReservedSize + blockSize > alloc->Size)
+		if (block == nullptr) [[unlikely]]
 		{
-			blockSize = alloc->Size - alloc->ReservedSize;
-			if (blockSize == 0) return nullptr;
+			INTEROP_TRACE_SCOPE(typeid(T).name(), "memory");
+			block = CreateBlock(GetTypeKey<T>(), typeid(T).name(), sizeof(T));
 		}
 
-		void* baseAddress = (void*)((char*)alloc->BaseAddress + alloc->ReservedSize);
-		u32 capacity = static_cast<u32>(floor(blockSize / sizeof(T)));
+		return block;
+	}
 
-		SharedBlock* block = new SharedBlock();
+	// Reserves a dirty bitmap for the block, after which Set<T> and MarkDirty flag the slots they touch.
+	// Like other reserved ranges the bitmap is not part of the persistent directory.
+	INTEROP_API b8 EnableDirtyTracking(SharedBlock* block);
 
-		block->BaseAddress = baseAddress;
-		block->Offset = alloc->ReservedSize;
-		block->Capacity = capacity;
-		block->Size = blockSize;
+	template <typename T>
+	INTEROP_API b8 EnableDirtyTracking()
+	{
+		SharedBlock* block = GetOrCreateBlock<T>();
+		return block != nullptr && EnableDirtyTracking(block);
+	}
 
-		pools[typeid(T)] = block;
-		alloc->ReservedSize += blockSize;
+	// Released after the slot was written, so that readers bounded by Used see it
+	INTEROP_INLINE void RecordUsed(SharedBlock* block, u32 index)
+	{
+		u32 used = block->Used.load(std::memory_order_relaxed);
 
-		return block;
+		while (index >= used && !block->Used.compare_exchange_weak(used, index + 1, std::memory_order_release, std::memory_order_relaxed)) {}
+	}
+
+	INTEROP_INLINE void MarkDirty(SharedBlock* block, u32 index)
+	{
+		u64* bits = block->DirtyBits.load(std::memory_order_acquire);
+		if (bits != nullptr) SetDirty(bits, index);
+	}
+
+	// For slots written through the pointer returned by Get<T>
+	template <typename T>
+	INTEROP_API void MarkDirty(u32 index)
+	{
+		SharedBlock* block = GetOrCreateBlock<T>();
+
+		if (block != nullptr && index < block->Capacity)
+		{
+			MarkDirty(block, index);
+			RecordUsed(block, index);
+			Stats::RecordSlot(block->Usage, index);
+		}
 	}
 
 	template <typename T>
@@ -92,16 +232,19 @@ namespace Interop::Memory
 
 		if (block == nullptr)
 		{
-			printf("%s\n", "Unable to retrieve a shared memory block related to the specified type");
+			INTEROP_LOG_ERROR("Unable to retrieve a shared memory block related to the specified type");
 			return nullptr;
 		}
 
-		if (index > block->Capacity)
+		if (index >= block->Capacity)
 		{
-			printf("%s\n", "The index provided is outside the range of the related shared memory block");
+			INTEROP_LOG_ERROR("The index provided is outside the range of the related shared memory block");
 			return nullptr;
 		}
 
+		// The caller may write through the pointer
+		RecordUsed(block, index);
+
 		T* buffer = static_cast<T*>(block->BaseAddress);
 		return &buffer[index];
 	}
@@ -113,18 +256,150 @@ namespace Interop::Memory
 
 		if (block == nullptr)
 		{
-			printf("%s\n", "Unable to retrieve a shared memory block related to the specified type");
+			INTEROP_LOG_ERROR("Unable to retrieve a shared memory block related to the specified type");
 			return;
 		}
 
-		if (index > block->Capacity)
+		if (index >= block->Capacity)
 		{
-			printf("%s\n", "The index provided is outside the range of the related shared memory block");
+			INTEROP_LOG_ERROR("The index provided is outside the range of the related shared memory block");
 			return;
 		}
 
 		T* buffer = reinterpret_cast<T*>(block->BaseAddress);
 		memcpy(&buffer[index], &value, sizeof(T));
+
+		MarkDirty(block, index);
+		RecordUsed(block, index);
+		Stats::RecordSlot(block->Usage, index);
+		Stats::AddBytesCopied(sizeof(T));
+	}
+
+	// Whole cache lines per chunk, so that two threads never write the same line of a block
+	template <typename T>
+	INTEROP_INLINE u32 GetChunkSize()
+	{
+		constexpr u32 lineElements = 64 / std::gcd(static_cast<u32>(sizeof(T)), 64u);
+		constexpr u32 chunkElements = INTEROP_PARALLEL_CHUNK_SIZE / sizeof(T) / lineElements * lineElements;
+
+		return chunkElements > lineElements ? chunkElements : lineElements;
+	}
+
+	// Calls fn(T& value, u32 index) on every slot of the block of a type, in parallel. Slots written this way
+	// are not flagged in the dirty bitmap, see Transform.
+	template <typename T, typename Fn>
+	INTEROP_API b8 ForEach(Fn&& fn)
+	{
+		SharedBlock* block = GetOrCreateBlock<T>();
+
+		if (block == nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to retrieve a shared memory block related to the specified type");
+			return false;
+		}
+
+		T* values = static_cast<T*>(block->BaseAddress);
+
+		Parallel::For(block->Capacity, GetChunkSize<T>(), [&](u32, u32 begin, u32 end)
+		{
+			for (u32 i = begin; i < end; i++)
+				fn(values[i], i);
+		});
+
+		return true;
+	}
+
+	// Replaces every slot with fn(const T& value, u32 index), in parallel. With dirty tracking enabled,
+	// only the slots whose bytes changed are flagged.
+	template <typename T, typename Fn>
+	INTEROP_API b8 Transform(Fn&& fn)
+	{
+		SharedBlock* block = GetOrCreateBlock<T>();
+
+		if (block == nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to retrieve a shared memory block related to the specified type");
+			return false;
+		}
+
+		T* values = static_cast<T*>(block->BaseAddress);
+		u64* dirtyBits = block->DirtyBits.load(std::memory_order_acquire);
+
+		Parallel::For(block->Capacity, GetChunkSize<T>(), [&](u32, u32 begin, u32 end)
+		{
+			u64 copied = 0;
+
+			for (u32 i = begin; i < end; i++)
+			{
+				T value = fn(static_cast<const T&>(values[i]), i);
+
+				if (dirtyBits != nullptr)
+				{
+					if (memcmp(&values[i], &value, sizeof(T)) == 0) continue;
+					SetDirty(dirtyBits, i);
+				}
+
+				memcpy(&values[i], &value, sizeof(T));
+				copied += sizeof(T);
+			}
+
+			Stats::AddBytesCopied(copied);
+		});
+
+		return true;
+	}
+
+	// Folds map(const T& value, u32 index) over the slots in use with combine(R, R), in parallel. Chunks are folded
+	// from the identity then combined in slot order, so the result does not depend on scheduling.
+	template <typename T, typename R, typename Map, typename Combine>
+	INTEROP_API R Reduce(R identity, Map&& map, Combine&& combine)
+	{
+		SharedBlock* block = GetOrCreateBlock<T>();
+
+		if (block == nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to retrieve a shared memory block related to the specified type");
+			return identity;
+		}
+
+		// One cache line per chunk: workers finishing together neither share lines nor, for bool, bytes.
+		// Raw storage, so that R needs no default constructor.
+		struct alignas(64) Partial
+		{
+			alignas(R) u8 Storage[sizeof(R)];
+
+			R* Get() { return std::launder(reinterpret_cast<R*>(Storage)); }
+		};
+
+		const T* values = static_cast<const T*>(block->BaseAddress);
+		u32 used = block->Used.load(std::memory_order_acquire);
+		u32 count = used < block->Capacity ? used : block->Capacity;
+
+		u32 chunkCount = Parallel::GetChunkCount(count, GetChunkSize<T>());
+		std::unique_ptr<Partial[]> partials(new Partial[chunkCount]);
+
+		for (u32 i = 0; i < chunkCount; i++)
+			new (partials[i].Storage) R(identity);
+
+		Parallel::For(count, GetChunkSize<T>(), [&](u32 chunk, u32 begin, u32 end)
+		{
+			R partial = identity;
+
+			for (u32 i = begin; i < end; i++)
+				partial = combine(partial, map(values[i], i));
+
+			*partials[chunk].Get() = partial;
+		});
+
+		R result = identity;
+
+		for (u32 i = 0; i < chunkCount; i++)
+		{
+			result = combine(result, *partials[i].Get());
+			partials[i].Get()->~R();
+		}
+
+		return result;
 	}
 
 }
\ No newline at end of file
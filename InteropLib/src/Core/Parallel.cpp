@@ -0,0 +1,209 @@
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+#include "Core/Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef INTEROP_PLATFORM_UNIX
+#include <pthread.h>
+#endif
+
+namespace Interop::Parallel
+{
+
+	struct Job
+	{
+		ChunkFn Fn;
+		void* Context;
+
+		u32 Count;
+		u32 ChunkSize;
+		u32 ChunkCount;
+
+		alignas(64) std::atomic<u32> NextChunk;
+	};
+
+	static std::vector<std::thread*> s_Workers;
+	static u32 s_WorkerCount = 0; // 0 until set or the pool starts
+
+	static std::mutex s_SubmitMutex; // Held by the thread running the current job
+	static std::mutex s_Mutex;
+	static std::condition_variable s_WorkAvailable;
+	static std::condition_variable s_WorkerLeft;
+
+	// Guarded by s_Mutex
+	static Job* s_Job = nullptr;
+	static u64 s_Generation = 0;
+	static u32 s_Attached = 0; // Workers that may still touch s_Job
+	static b8 s_Stopping = false;
+
+	static thread_local b8 t_InChunk = false;
+
+	static void RunChunks(Job* job)
+	{
+		b8 wasInChunk = t_InChunk;
+		t_InChunk = true;
+
+		for (u32 chunk = job->NextChunk.fetch_add(1, std::memory_order_relaxed); chunk < job->ChunkCount; chunk = job->NextChunk.fetch_add(1, std::memory_order_relaxed))
+		{
+			u32 begin = chunk * job->ChunkSize;
+			u32 end = job->Count - begin > job->ChunkSize ? begin + job->ChunkSize : job->Count;
+
+			job->Fn(job->Context, chunk, begin, end);
+		}
+
+		t_InChunk = wasInChunk;
+	}
+
+	static void Work()
+	{
+		u64 generation = 0;
+		std::unique_lock<std::mutex> lock(s_Mutex);
+
+		while (true)
+		{
+			s_WorkAvailable.wait(lock, [&] { return s_Stopping || (s_Job != nullptr && s_Generation != generation); });
+			if (s_Stopping) return;
+
+			Job* job = s_Job;
+			generation = s_Generation;
+			s_Attached++;
+
+			lock.unlock();
+			RunChunks(job);
+			lock.lock();
+
+			if (--s_Attached == 0)
+				s_WorkerLeft.notify_all();
+		}
+	}
+
+	// Threads do not survive fork: the child starts over with a pool of its own
+	static void OnForkChild()
+	{
+		s_Workers.clear();
+		s_Job = nullptr;
+		s_Attached = 0;
+		s_Stopping = false;
+
+		new (&s_SubmitMutex) std::mutex();
+		new (&s_Mutex) std::mutex();
+		new (&s_WorkAvailable) std::condition_variable();
+		new (&s_WorkerLeft) std::condition_variable();
+	}
+
+	// Joined at exit so that no worker runs while the statics above are destroyed
+	struct PoolGuard
+	{
+		~PoolGuard()
+		{
+			{
+				std::lock_guard<std::mutex> lock(s_Mutex);
+				s_Stopping = true;
+			}
+
+			s_WorkAvailable.notify_all();
+
+			for (std::thread* worker : s_Workers)
+			{
+				worker->join();
+				delete worker;
+			}
+
+			s_Workers.clear();
+		}
+	};
+
+	static void StartWorkers()
+	{
+		static PoolGuard s_Guard;
+
+#ifdef INTEROP_PLATFORM_UNIX
+		static const i32 s_AtFork = pthread_atfork(nullptr, nullptr, OnForkChild);
+		(void)s_AtFork;
+#endif
+
+		if (s_WorkerCount == 0)
+			s_WorkerCount = std::max(1u, std::thread::hardware_concurrency());
+
+		for (u32 i = 1; i < s_WorkerCount; i++)
+			s_Workers.push_back(new std::thread(Work));
+	}
+
+	void SetWorkerCount(u32 count)
+	{
+		std::lock_guard<std::mutex> lock(s_SubmitMutex);
+
+		if (!s_Workers.empty())
+		{
+			INTEROP_LOG_WARNING("Unable to change the number of parallel workers, the pool has already started");
+			return;
+		}
+
+		s_WorkerCount = count;
+	}
+
+	u32 GetWorkerCount()
+	{
+		return s_WorkerCount != 0 ? s_WorkerCount : std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	void Run(u32 count, u32 chunkSize, ChunkFn fn, void* context)
+	{
+		if (count == 0) return;
+
+		if (chunkSize == 0) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to run a parallel job with empty chunks");
+			return;
+		}
+
+		Job job = {};
+		job.Fn = fn;
+		job.Context = context;
+		job.Count = count;
+		job.ChunkSize = chunkSize;
+		job.ChunkCount = GetChunkCount(count, chunkSize);
+
+		// A single chunk, a nested job or a busy pool: waking workers would cost more than it saves
+		std::unique_lock<std::mutex> submit(s_SubmitMutex, std::defer_lock);
+
+		if (job.ChunkCount == 1 || t_InChunk || !submit.try_lock())
+		{
+			RunChunks(&job);
+			return;
+		}
+
+		if (s_Workers.empty() && GetWorkerCount() > 1)
+			StartWorkers();
+
+		if (s_Workers.empty())
+		{
+			RunChunks(&job);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+
+			s_Job = &job;
+			s_Generation++;
+		}
+
+		s_WorkAvailable.notify_all();
+		RunChunks(&job);
+
+		// Every chunk has been claimed, and claimed chunks run to completion before their worker detaches
+		std::unique_lock<std::mutex> lock(s_Mutex);
+
+		s_Job = nullptr;
+		s_WorkerLeft.wait(lock, [] { return s_Attached == 0; });
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <type_traits>
+
+// Bytes of shared memory processed per chunk: large enough to amortize claiming it, small enough to balance
+#define INTEROP_PARALLEL_CHUNK_SIZE 16384
+
+namespace Interop::Parallel
+{
+
+	// Runs the elements [begin, end) of the chunk-th chunk of a job
+	typedef void (*ChunkFn)(void* context, u32 chunk, u32 begin, u32 end);
+
+	// Sets the number of pool threads, including the one submitting jobs. Only effective before the first job,
+	// defaults to the number of CPUs.
+	INTEROP_API void SetWorkerCount(u32 count);
+	INTEROP_API u32 GetWorkerCount();
+
+	INTEROP_INLINE u32 GetChunkCount(u32 count, u32 chunkSize)
+	{
+		return (count + chunkSize - 1) / chunkSize;
+	}
+
+	// Splits [0, count) into chunks claimed one at a time by the pool workers and the calling thread, returns
+	// once every chunk ran. Jobs submitted from a chunk or while another job runs are run by the calling thread.
+	INTEROP_API void Run(u32 count, u32 chunkSize, ChunkFn fn, void* context);
+
+	// fn(chunk, begin, end)
+	template <typename Fn>
+	INTEROP_INLINE void For(u32 count, u32 chunkSize, Fn&& fn)
+	{
+		typedef std::remove_reference_t<Fn> Function;
+
+		Run(count, chunkSize, [](void* context, u32 chunk, u32 begin, u32 end)
+		{
+			(*static_cast<Function*>(context))(chunk, begin, end);
+		}, const_cast<void*>(static_cast<const void*>(&fn)));
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,322 @@
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+#include "Core/Recorder.hpp"
+#include "Core/Trace.hpp"
+
+#include "Platform/Platform.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+
+namespace Interop::Recorder
+{
+
+	std::atomic<b8> State::s_Enabled = false;
+
+	// Written only by its owning thread, read by Stop once the owner published the size. Calls are a
+	// CallHeader followed by the arguments, the timestamp in ticks until Stop converts it.
+	struct ThreadBuffer
+	{
+		ThreadBuffer* Next = nullptr;
+		u8* Data = nullptr;
+
+		u32 ThreadId = 0;
+		u32 Capacity = 0;
+
+		std::atomic<u32> Epoch = 0;
+		std::atomic<u32> Size = 0;
+		std::atomic<u32> Dropped = 0;
+
+		u32 Pending = 0; // Offset of the call being recorded, published by EndCall
+	};
+
+	static std::atomic<ThreadBuffer*> s_Buffers = nullptr;
+	static std::atomic<u32> s_Epoch = 0;
+	static std::atomic<u32> s_Capacity = 0;
+
+	static u64 s_StartTicks = 0;
+	static u64 s_StartNanoseconds = 0;
+
+	// Names are interned for the lifetime of the process, so that indices stay valid across sessions
+	static std::mutex s_NamesMutex;
+	static std::vector<RecordedName> s_Names;
+
+	static thread_local ThreadBuffer* t_Buffer = nullptr;
+	static thread_local std::unordered_map<const void*, u16>* t_NameIndices = nullptr;
+
+	static u64 Nanoseconds()
+	{
+		return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	static ThreadBuffer* AcquireBuffer()
+	{
+		ThreadBuffer* buffer = t_Buffer;
+		u32 epoch = s_Epoch.load(std::memory_order_acquire);
+
+		if (buffer == nullptr) [[unlikely]]
+		{
+			buffer = new ThreadBuffer();
+			buffer->Capacity = s_Capacity.load(std::memory_order_relaxed);
+			buffer->Data = new u8[buffer->Capacity];
+			buffer->ThreadId = static_cast<u32>(Platform::GetCurrentThreadId());
+			buffer->Epoch.store(epoch, std::memory_order_relaxed);
+
+			ThreadBuffer* head = s_Buffers.load(std::memory_order_relaxed);
+
+			do buffer->Next = head;
+			while (!s_Buffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+
+			t_Buffer = buffer;
+		}
+
+		else if (buffer->Epoch.load(std::memory_order_relaxed) != epoch)
+		{
+			// First call of a new session on this thread, discard the previous one
+			buffer->Size.store(0, std::memory_order_relaxed);
+			buffer->Dropped.store(0, std::memory_order_relaxed);
+			buffer->Epoch.store(epoch, std::memory_order_release);
+		}
+
+		return buffer;
+	}
+
+	static u16 InternName(const void* key, const char* name, RecordKind kind)
+	{
+		if (t_NameIndices == nullptr) [[unlikely]]
+			t_NameIndices = new std::unordered_map<const void*, u16>();
+
+		auto cached = t_NameIndices->find(key);
+		if (cached != t_NameIndices->end()) return cached->second;
+
+		std::lock_guard<std::mutex> lock(s_NamesMutex);
+		u16 index = 0;
+
+		while (index < s_Names.size() && (s_Names[index].Kind != kind || s_Names[index].Name != name))
+			index++;
+
+		if (index == s_Names.size())
+		{
+			if (s_Names.size() == 0xFFFF) [[unlikely]]
+			{
+				INTEROP_LOG_ERROR("Unable to record calls of \"%s\", the recorder already knows %u functions", name, 0xFFFF);
+				return 0xFFFF;
+			}
+
+			s_Names.push_back({ kind, std::string(name) });
+		}
+
+		(*t_NameIndices)[key] = index;
+		return index;
+	}
+
+	u8* BeginCall(const void* key, const char* name, RecordKind kind, u32 maxArgumentsSize)
+	{
+		ThreadBuffer* buffer = AcquireBuffer();
+		u32 size = buffer->Size.load(std::memory_order_relaxed);
+
+		u16 function = InternName(key, name, kind);
+
+		if (function == 0xFFFF || buffer->Capacity - size < sizeof(CallHeader) + maxArgumentsSize) [[unlikely]]
+		{
+			buffer->Dropped.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		CallHeader header = { Trace::Timestamp(), buffer->ThreadId, function, 0 };
+		memcpy(buffer->Data + size, &header, sizeof(CallHeader));
+
+		buffer->Pending = size;
+		return buffer->Data + size + sizeof(CallHeader);
+	}
+
+	void EndCall(u32 argumentsSize)
+	{
+		ThreadBuffer* buffer = t_Buffer;
+		u16 size = static_cast<u16>(argumentsSize);
+
+		memcpy(buffer->Data + buffer->Pending + offsetof(CallHeader, ArgumentsSize), &size, sizeof(u16));
+		buffer->Size.store(buffer->Pending + sizeof(CallHeader) + argumentsSize, std::memory_order_release);
+	}
+
+	b8 Start(u32 bytesPerThread)
+	{
+		if (IsEnabled()) [[unlikely]]
+		{
+			INTEROP_LOG_WARNING("A recording is already running");
+			return false;
+		}
+
+		if (bytesPerThread < sizeof(CallHeader))
+		{
+			INTEROP_LOG_ERROR("Unable to start a recording with a per-thread capacity of %u bytes", bytesPerThread);
+			return false;
+		}
+
+		// Buffers are never reallocated, threads that already recorded keep their first capacity
+		u32 expected = 0;
+		s_Capacity.compare_exchange_strong(expected, bytesPerThread, std::memory_order_relaxed);
+
+		s_StartNanoseconds = Nanoseconds();
+		s_StartTicks = Trace::Timestamp();
+
+		s_Epoch.fetch_add(1, std::memory_order_release);
+		State::s_Enabled.store(true, std::memory_order_release);
+
+		return true;
+	}
+
+	b8 Stop(const char* path)
+	{
+		if (!IsEnabled()) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("No recording is running");
+			return false;
+		}
+
+		State::s_Enabled.store(false, std::memory_order_release);
+
+		u64 stopTicks = Trace::Timestamp();
+		u64 stopNanoseconds = Nanoseconds();
+
+		f64 elapsed = static_cast<f64>(stopNanoseconds - s_StartNanoseconds);
+		f64 ticksPerNanosecond = elapsed > 0.0 ? static_cast<f64>(stopTicks - s_StartTicks) / elapsed : 1.0;
+
+		struct PendingCall
+		{
+			u64 Timestamp;
+			const u8* Data;
+		};
+
+		std::vector<PendingCall> calls;
+		u32 epoch = s_Epoch.load(std::memory_order_acquire);
+
+		RecordingHeader header = {};
+		header.Magic = INTEROP_RECORDING_MAGIC;
+		header.Version = INTEROP_RECORDING_VERSION;
+		header.Duration = stopNanoseconds - s_StartNanoseconds;
+
+		for (ThreadBuffer* buffer = s_Buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next)
+		{
+			if (buffer->Epoch.load(std::memory_order_acquire) != epoch)
+				continue;
+
+			u32 size = buffer->Size.load(std::memory_order_acquire);
+			header.Dropped += buffer->Dropped.load(std::memory_order_relaxed);
+
+			for (u32 offset = 0; offset < size;)
+			{
+				CallHeader call;
+				memcpy(&call, buffer->Data + offset, sizeof(CallHeader));
+
+				u64 ticks = call.Timestamp > s_StartTicks ? call.Timestamp - s_StartTicks : 0;
+				calls.push_back({ static_cast<u64>(static_cast<f64>(ticks) / ticksPerNanosecond), buffer->Data + offset });
+
+				offset += sizeof(CallHeader) + call.ArgumentsSize;
+			}
+		}
+
+		// Threads are merged in call order
+		std::stable_sort(calls.begin(), calls.end(), [](const PendingCall& a, const PendingCall& b) { return a.Timestamp < b.Timestamp; });
+
+		FILE* file = fopen(path, "wb");
+
+		if (file == nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to open \"%s\" to write the recording", path);
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(s_NamesMutex);
+
+		header.NameCount = static_cast<u32>(s_Names.size());
+		header.CallCount = static_cast<u32>(calls.size());
+
+		b8 success = fwrite(&header, sizeof(header), 1, file) == 1;
+
+		for (const RecordedName& name : s_Names)
+		{
+			u8 prefix[2] = { name.Kind, static_cast<u8>(std::min<size_t>(name.Name.size(), 0xFF)) };
+
+			if (success) success = fwrite(prefix, sizeof(prefix), 1, file) == 1;
+			if (success) success = fwrite(name.Name.data(), 1, prefix[1], file) == prefix[1];
+		}
+
+		for (const PendingCall& call : calls)
+		{
+			CallHeader callHeader;
+			memcpy(&callHeader, call.Data, sizeof(CallHeader));
+			callHeader.Timestamp = call.Timestamp;
+
+			if (success) success = fwrite(&callHeader, sizeof(CallHeader), 1, file) == 1;
+			if (success && callHeader.ArgumentsSize != 0) success = fwrite(call.Data + sizeof(CallHeader), callHeader.ArgumentsSize, 1, file) == 1;
+		}
+
+		success = fclose(file) == 0 && success;
+
+		if (!success)
+		{
+			INTEROP_LOG_ERROR("Unable to write the recording to \"%s\"", path);
+			return false;
+		}
+
+		if (header.Dropped > 0)
+		{
+			INTEROP_LOG_WARNING("Recording written to \"%s\", %llu calls dropped because of full thread buffers", path, header.Dropped);
+		}
+
+		return true;
+	}
+
+	b8 LoadRecording(const char* path, Recording* recording)
+	{
+		FILE* file = fopen(path, "rb");
+
+		if (file == nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to open recording \"%s\"", path);
+			return false;
+		}
+
+		b8 success = fread(&recording->Header, sizeof(RecordingHeader), 1, file) == 1
+			&& recording->Header.Magic == INTEROP_RECORDING_MAGIC
+			&& recording->Header.Version == INTEROP_RECORDING_VERSION;
+
+		recording->Names.clear();
+		recording->Calls.clear();
+
+		for (u32 i = 0; success && i < recording->Header.NameCount; i++)
+		{
+			u8 prefix[2];
+			success = fread(prefix, sizeof(prefix), 1, file) == 1;
+
+			RecordedName name = { static_cast<RecordKind>(prefix[0]), std::string(prefix[1], '\0') };
+			if (success) success = fread(name.Name.data(), 1, prefix[1], file) == prefix[1];
+
+			recording->Names.push_back(std::move(name));
+		}
+
+		// The calls are kept as they are in the file, see ForEachCall
+		u8 chunk[65536];
+		size_t read = 0;
+
+		while (success && (read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+			recording->Calls.insert(recording->Calls.end(), chunk, chunk + read);
+
+		fclose(file);
+
+		if (!success)
+		{
+			INTEROP_LOG_ERROR("Unable to load recording \"%s\", it is truncated or was written by another version", path);
+			return false;
+		}
+
+		return true;
+	}
+
+}
\ No newline at end of file
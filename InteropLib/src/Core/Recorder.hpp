@@ -0,0 +1,342 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define INTEROP_RECORDING_MAGIC 0x43455249 // "IREC"
+#define INTEROP_RECORDING_VERSION 1
+
+// Bytes of calls buffered per thread, a call takes 16 bytes plus 3 per argument and the bytes pointed to
+#define INTEROP_RECORDER_DEFAULT_CAPACITY (16u << 20)
+
+// Records a call of an exported function from its body, with the arguments as the export received them
+#define INTEROP_RECORD_EXPORT(function, ...) do \
+	{ \
+		if (::Interop::Recorder::IsEnabled()) [[unlikely]] \
+			::Interop::Recorder::RecordCall<decltype(&function)>(#function, #function, ::Interop::Recorder::INTEROP_RECORD_KIND_EXPORT, __VA_ARGS__); \
+	} while (false)
+
+namespace Interop::Recorder
+{
+
+	enum RecordKind : u8
+	{
+		INTEROP_RECORD_KIND_MANAGED = 0, // Function bound from a hosted assembly, named "<class path>.<name>"
+		INTEROP_RECORD_KIND_EXPORT = 1, // Native export called by managed code
+	};
+
+	// Arguments are stored as a kind, a 16-bit size and that many bytes, unaligned
+	enum ArgumentKind : u8
+	{
+		INTEROP_ARGUMENT_KIND_VALUE = 0,
+		INTEROP_ARGUMENT_KIND_POINTER = 1, // Copy of the value pointed to, replayed from a copy of its own
+		INTEROP_ARGUMENT_KIND_NULL = 2,
+		INTEROP_ARGUMENT_KIND_OPAQUE = 3, // Address of something of unknown size, callbacks are replayed as no-ops
+	};
+
+	// A recording is this header, NameCount names (kind, length and characters, no terminator),
+	// then CallCount calls ordered by timestamp, each a CallHeader followed by its arguments
+	struct RecordingHeader
+	{
+		u32 Magic;
+		u32 Version;
+		u32 NameCount;
+		u32 CallCount;
+		u64 Duration; // Nanoseconds between Start and Stop
+		u64 Dropped; // Calls that did not fit in the buffer of their thread
+	};
+
+	struct CallHeader
+	{
+		u64 Timestamp; // Nanoseconds since Start
+		u32 ThreadId;
+		u16 Function; // Index in the name table
+		u16 ArgumentsSize;
+	};
+
+	struct RecordedName
+	{
+		RecordKind Kind;
+		std::string Name;
+	};
+
+	struct Recording
+	{
+		RecordingHeader Header = {};
+		std::vector<RecordedName> Names = {};
+		std::vector<u8> Calls = {};
+	};
+
+	struct State
+	{
+		INTEROP_API static std::atomic<b8> s_Enabled;
+	};
+
+	// Opt-in: records every call made through HostedFunction and every call of exports using
+	// INTEROP_RECORD_EXPORT until Stop, which writes the calls of all threads to the file provided
+	INTEROP_API b8 Start(u32 bytesPerThread = INTEROP_RECORDER_DEFAULT_CAPACITY);
+	INTEROP_API b8 Stop(const char* path);
+
+	INTEROP_API b8 LoadRecording(const char* path, Recording* recording);
+
+	// Returns where to write the arguments of a call, nullptr when the buffer of the thread is full.
+	// The key identifies the function, its name is only read the first time a thread records it.
+	INTEROP_API u8* BeginCall(const void* key, const char* name, RecordKind kind, u32 maxArgumentsSize);
+	INTEROP_API void EndCall(u32 argumentsSize);
+
+	INTEROP_INLINE b8 IsEnabled()
+	{
+		return State::s_Enabled.load(std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	struct FunctionTraits;
+
+	template <typename R, typename... P>
+	struct FunctionTraits<R (INTEROP_DELEGATE_CALLTYPE*)(P...)>
+	{
+		typedef R Result;
+		typedef std::tuple<P...> Parameters;
+	};
+
+	template <typename T>
+	struct NoopCallback;
+
+	template <typename R, typename... P>
+	struct NoopCallback<R (INTEROP_DELEGATE_CALLTYPE*)(P...)>
+	{
+		static R INTEROP_DELEGATE_CALLTYPE Invoke(P...)
+		{
+			if constexpr (!std::is_void_v<R>) return R();
+		}
+	};
+
+	// Pointers are followed when what they point to has a known size and can be copied
+	template <typename A>
+	constexpr b8 IsRecordablePointer()
+	{
+		if constexpr (std::is_pointer_v<A>)
+		{
+			typedef std::remove_cv_t<std::remove_pointer_t<A>> Pointee;
+
+			if constexpr (!std::is_void_v<Pointee> && !std::is_function_v<Pointee>)
+				return std::is_trivially_copyable_v<Pointee> && sizeof(Pointee) <= 0xFFFF;
+		}
+
+		return false;
+	}
+
+	// Parameter P of the function, argument A as given by the caller: a typed pointer passed as void* is still followed
+	template <typename P, typename A>
+	constexpr u32 GetMaxArgumentSize()
+	{
+		typedef std::decay_t<A> Argument;
+
+		if constexpr (std::is_pointer_v<P> && IsRecordablePointer<Argument>())
+			return 3 + sizeof(std::remove_pointer_t<Argument>);
+
+		else if constexpr (!std::is_pointer_v<P> && std::is_trivially_copyable_v<P>)
+			return 3 + sizeof(P);
+
+		else return 3;
+	}
+
+	INTEROP_INLINE u8* WriteArgument(u8* cursor, ArgumentKind kind, const void* data, u16 size)
+	{
+		cursor[0] = kind;
+		memcpy(cursor + 1, &size, sizeof(u16));
+		if (size != 0) memcpy(cursor + 3, data, size);
+
+		return cursor + 3 + size;
+	}
+
+	template <typename P, typename A>
+	INTEROP_INLINE u8* EncodeArgument(u8* cursor, const A& argument)
+	{
+		typedef std::decay_t<A> Argument;
+
+		if constexpr (std::is_pointer_v<P>)
+		{
+			if constexpr (std::is_null_pointer_v<Argument>)
+				return WriteArgument(cursor, INTEROP_ARGUMENT_KIND_NULL, nullptr, 0);
+
+			else
+			{
+				if (argument == nullptr) return WriteArgument(cursor, INTEROP_ARGUMENT_KIND_NULL, nullptr, 0);
+
+				if constexpr (IsRecordablePointer<Argument>())
+					return WriteArgument(cursor, INTEROP_ARGUMENT_KIND_POINTER, argument, sizeof(*argument));
+
+				else return WriteArgument(cursor, INTEROP_ARGUMENT_KIND_OPAQUE, nullptr, 0);
+			}
+		}
+
+		else if constexpr (std::is_trivially_copyable_v<P>)
+		{
+			P value = static_cast<P>(argument);
+			return WriteArgument(cursor, INTEROP_ARGUMENT_KIND_VALUE, &value, sizeof(P));
+		}
+
+		else return WriteArgument(cursor, INTEROP_ARGUMENT_KIND_OPAQUE, nullptr, 0);
+	}
+
+	template <typename Parameters, size_t... I, typename... Args>
+	INTEROP_INLINE void RecordArguments(const void* key, const char* name, RecordKind kind, std::index_sequence<I...>, const Args&... args)
+	{
+		constexpr u32 maxSize = (0u + ... + GetMaxArgumentSize<std::tuple_element_t<I, Parameters>, Args>());
+		static_assert(maxSize <= 0xFFFF, "The arguments of a recorded call must fit in 64 KB");
+
+		u8* begin = BeginCall(key, name, kind, maxSize);
+		if (begin == nullptr) return;
+
+		u8* cursor = begin;
+		((cursor = EncodeArgument<std::tuple_element_t<I, Parameters>>(cursor, args)), ...);
+
+		EndCall(static_cast<u32>(cursor - begin));
+	}
+
+	// T is the function pointer type called, Args the arguments as given by the caller
+	template <typename T, typename... Args>
+	INTEROP_INLINE void RecordCall(const void* key, const char* name, RecordKind kind, const Args&... args)
+	{
+		typedef typename FunctionTraits<T>::Parameters Parameters;
+		static_assert(std::tuple_size_v<Parameters> == sizeof...(Args), "Recorded calls must pass every parameter");
+
+		RecordArguments<Parameters>(key, name, kind, std::index_sequence_for<Args...>(), args...);
+	}
+
+	// Reads the kind and bytes of the next argument, false past the end of the call
+	INTEROP_INLINE b8 ReadArgument(const u8*& cursor, const u8* end, ArgumentKind* kind, const u8** data, u16* size)
+	{
+		if (end - cursor < 3) return false;
+
+		*kind = static_cast<ArgumentKind>(cursor[0]);
+		memcpy(size, cursor + 1, sizeof(u16));
+
+		if (end - cursor - 3 < *size) return false;
+
+		*data = cursor + 3;
+		cursor += 3 + *size;
+
+		return true;
+	}
+
+	INTEROP_INLINE u32 AlignScratch(u32 size)
+	{
+		return (size + 15) & ~15u;
+	}
+
+	// Pointed-to values are copied to 16-byte aligned scratch space, so that callees may write them
+	template <typename P>
+	INTEROP_INLINE b8 DecodeArgument(const u8*& cursor, const u8* end, u8*& scratch, P* value)
+	{
+		ArgumentKind kind;
+		const u8* data = nullptr;
+		u16 size = 0;
+
+		if (!ReadArgument(cursor, end, &kind, &data, &size)) return false;
+
+		if constexpr (std::is_pointer_v<P>)
+		{
+			if (kind == INTEROP_ARGUMENT_KIND_NULL)
+			{
+				*value = nullptr;
+				return true;
+			}
+
+			if (kind == INTEROP_ARGUMENT_KIND_POINTER)
+			{
+				memcpy(scratch, data, size);
+				*value = reinterpret_cast<P>(scratch);
+				scratch += AlignScratch(size);
+
+				return true;
+			}
+
+			if constexpr (std::is_function_v<std::remove_pointer_t<P>>)
+			{
+				if (kind == INTEROP_ARGUMENT_KIND_OPAQUE)
+				{
+					*value = &NoopCallback<P>::Invoke;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		else
+		{
+			if (kind != INTEROP_ARGUMENT_KIND_VALUE || size != sizeof(P)) return false;
+
+			memcpy(value, data, sizeof(P));
+			return true;
+		}
+	}
+
+	// Calls fn(const CallHeader& call, const u8* arguments) for every call, false if the recording is truncated
+	template <typename Fn>
+	INTEROP_INLINE b8 ForEachCall(const Recording& recording, Fn&& fn)
+	{
+		const u8* cursor = recording.Calls.data();
+		const u8* end = cursor + recording.Calls.size();
+
+		for (u32 i = 0; i < recording.Header.CallCount; i++)
+		{
+			CallHeader call;
+
+			if (end - cursor < static_cast<std::ptrdiff_t>(sizeof(CallHeader))) return false;
+			memcpy(&call, cursor, sizeof(CallHeader));
+
+			if (end - cursor - static_cast<std::ptrdiff_t>(sizeof(CallHeader)) < call.ArgumentsSize) return false;
+
+			fn(call, cursor + sizeof(CallHeader));
+			cursor += sizeof(CallHeader) + call.ArgumentsSize;
+		}
+
+		return true;
+	}
+
+	// Re-issues a recorded call, false when its arguments cannot be replayed (opaque data pointers)
+	typedef b8 (*ReplayFn)(void* function, const u8* arguments, u32 size);
+
+	template <typename T>
+	b8 Replay(void* function, const u8* arguments, u32 size)
+	{
+		typedef typename FunctionTraits<T>::Parameters Parameters;
+
+		const u8* end = arguments + size;
+		u32 scratchSize = 0;
+
+		ArgumentKind kind;
+		const u8* data = nullptr;
+		u16 length = 0;
+
+		for (const u8* cursor = arguments; ReadArgument(cursor, end, &kind, &data, &length);)
+			scratchSize += kind == INTEROP_ARGUMENT_KIND_POINTER ? AlignScratch(length) : 0;
+
+		static thread_local std::vector<u64> s_Scratch;
+		s_Scratch.resize(scratchSize / sizeof(u64) + 2);
+
+		u8* scratch = reinterpret_cast<u8*>((reinterpret_cast<uintptr_t>(s_Scratch.data()) + 15) & ~static_cast<uintptr_t>(15));
+		const u8* cursor = arguments;
+
+		Parameters values = {};
+		b8 decoded = std::apply([&](auto&... value) { return (DecodeArgument(cursor, end, scratch, &value) && ...); }, values);
+
+		if (!decoded) return false;
+
+		std::apply(reinterpret_cast<T>(function), values);
+		return true;
+	}
+
+}
\ No newline at end of file
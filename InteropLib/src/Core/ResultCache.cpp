@@ -0,0 +1,85 @@
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+#include "Core/ResultCache.hpp"
+#include "Core/Stats.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace Interop::Cache
+{
+
+	// Caches alive in the process, for invalidations coming from managed code
+	static std::mutex s_RegistryMutex;
+	static std::vector<CacheBase*> s_Caches;
+
+	static u32 RoundUpToPowerOfTwo(u32 value)
+	{
+		u32 result = 1;
+		while (result < value && result < (1u << 31)) result <<= 1;
+
+		return result;
+	}
+
+	CacheBase::CacheBase(const char* name, const CacheDesc& desc) : m_Name(name)
+	{
+		u32 setCount = std::max(RoundUpToPowerOfTwo(desc.Capacity) / INTEROP_CACHE_WAYS, 1u);
+		u32 shardCount = std::min(RoundUpToPowerOfTwo(desc.Shards), setCount);
+
+		m_SetMask = setCount - 1;
+		m_ShardMask = shardCount - 1;
+		m_TimeToLive = static_cast<u64>(desc.TimeToLive) * 1000000;
+
+		m_Shards = new Shard[shardCount];
+		m_Hands = new u8[setCount]();
+
+		m_Usage = Stats::RegisterCache(name);
+
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+		s_Caches.push_back(this);
+	}
+
+	CacheBase::~CacheBase()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_RegistryMutex);
+			s_Caches.erase(std::remove(s_Caches.begin(), s_Caches.end(), this), s_Caches.end());
+		}
+
+		u64 pending = 0;
+		for (u32 i = 0; i <= m_ShardMask; i++) pending += m_Shards[i].Hits.load(std::memory_order_relaxed) % INTEROP_CACHE_HIT_BATCH;
+
+		Stats::Add(m_Usage->Hits, pending);
+
+		delete[] m_Shards;
+		delete[] m_Hands;
+	}
+
+	void CacheBase::Invalidate()
+	{
+		m_Generation.fetch_add(1, std::memory_order_acq_rel);
+		m_Usage->Invalidations.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	u32 Invalidate(const char* name)
+	{
+		std::lock_guard<std::mutex> lock(s_RegistryMutex);
+		u32 count = 0;
+
+		for (CacheBase* cache : s_Caches)
+		{
+			if (name != nullptr && cache->GetName() != name) continue;
+
+			cache->Invalidate();
+			count++;
+		}
+
+		if (name != nullptr && count == 0)
+			INTEROP_LOG_WARNING("No result cache named \"%s\" to invalidate", name);
+
+		return count;
+	}
+
+}
\ No newline at end of file
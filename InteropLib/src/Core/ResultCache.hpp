@@ -0,0 +1,355 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+#include "Core/HostedAssembly.hpp"
+#include "Core/Recorder.hpp"
+#include "Core/Stats.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Entries of a set: a key can only live in the set its hash selects, lookups read at most this many entries
+#define INTEROP_CACHE_WAYS 8
+
+// Keys and results are stored inline, so that an entry stays within two cache lines
+#define INTEROP_CACHE_MAX_KEY_SIZE 64
+#define INTEROP_CACHE_MAX_RESULT_SIZE 64
+
+// Hits a stripe counts before adding them to the statistics page, which therefore lags by less than this per stripe
+#define INTEROP_CACHE_HIT_BATCH 1024
+
+namespace Interop::Cache
+{
+
+	struct CacheDesc
+	{
+		u32 Capacity = 4096; // Entries, rounded up to a power of two
+		u32 Shards = 16; // Locks serializing insertions, rounded up to a power of two
+		u32 TimeToLive = 0; // Milliseconds, 0 for entries that only leave when evicted or invalidated
+	};
+
+	// Untyped part of a cache, registered by name so that managed code can invalidate it. The name is kept in
+	// full: the statistics entry may cut it, or be shared with every cache dropped once the page is full.
+	class CacheBase
+	{
+	public:
+		INTEROP_API CacheBase(const char* name, const CacheDesc& desc);
+		CacheBase(CacheBase&) = delete;
+
+		// Adds the hits still counted in the stripes
+		INTEROP_API ~CacheBase();
+
+		// Drops every entry at once: entries of an older generation read as missing and are replaced over time.
+		// Values computed while the cache is invalidated are not stored.
+		INTEROP_API void Invalidate();
+
+		INTEROP_INLINE u32 GetGeneration() const { return m_Generation.load(std::memory_order_acquire); }
+		INTEROP_INLINE const std::string& GetName() const { return m_Name; }
+
+		CacheBase& operator=(CacheBase&) = delete;
+
+	protected:
+		// Shards double as the stripes counting hits: the counter of the calling thread is bumped rather than the
+		// one of the statistics page, which every thread hitting the cache would share
+		struct alignas(64) Shard
+		{
+			std::mutex Lock;
+			alignas(64) std::atomic<u64> Hits;
+		};
+
+		std::string m_Name;
+		Stats::CacheStats* m_Usage;
+
+		u32 m_SetMask = 0;
+		u32 m_ShardMask = 0;
+		u64 m_TimeToLive = 0; // Nanoseconds
+
+		Shard* m_Shards = nullptr;
+		u8* m_Hands = nullptr; // CLOCK hand of every set, guarded by the lock of its shard
+
+	private:
+		std::atomic<u32> m_Generation = 0;
+	};
+
+	// Invalidates the caches in front of a function ("<class path>.<name>"), every cache for nullptr.
+	// Returns the number of caches invalidated, a name matching none is logged as a warning.
+	INTEROP_API u32 Invalidate(const char* name);
+
+	INTEROP_INLINE u64 GetTime()
+	{
+		return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	// Word-wise multiply-xor with a murmur3 finalizer, so that the low bits selecting the set depend on every byte
+	INTEROP_INLINE u64 HashKey(const u64* words, u32 count)
+	{
+		u64 hash = 0x9E3779B97F4A7C15ull;
+
+		for (u32 i = 0; i < count; i++)
+			hash = (hash ^ words[i]) * 0xFF51AFD7ED558CCDull;
+
+		hash ^= hash >> 33;
+		hash *= 0xC4CEB9FE1A85EC53ull;
+		hash ^= hash >> 33;
+
+		return hash;
+	}
+
+	// Set-associative CLOCK cache of fixed-size keys and results. Lookups take no lock: every entry is a seqlock,
+	// readers copy it and drop the copy if a writer touched the entry meanwhile. Insertions lock the shard of
+	// their set, refresh the entry of the key or take a dead one, and evict with the CLOCK hand of the set otherwise.
+	template <u32 KeySize, u32 ResultSize>
+	class ResultCache final : public CacheBase
+	{
+	public:
+		static constexpr u32 KeyWords = KeySize == 0 ? 1 : (KeySize + 7) / 8;
+		static constexpr u32 ResultWords = (ResultSize + 7) / 8;
+
+		ResultCache(const char* name, const CacheDesc& desc) : CacheBase(name, desc)
+		{
+			m_Entries = new Entry[(m_SetMask + 1) * INTEROP_CACHE_WAYS];
+		}
+
+		~ResultCache()
+		{
+			delete[] m_Entries;
+		}
+
+		// Copies the result stored for the key, false when it is missing, expired or being written
+		INTEROP_INLINE b8 Lookup(u64 hash, const u64* key, void* result)
+		{
+			u32 generation = GetGeneration();
+			u64 now = m_TimeToLive != 0 ? GetTime() : 0;
+
+			Entry* set = m_Entries + (static_cast<u32>(hash) & m_SetMask) * INTEROP_CACHE_WAYS;
+
+			for (u32 way = 0; way < INTEROP_CACHE_WAYS; way++)
+			{
+				Entry& entry = set[way];
+				u32 sequence = entry.Sequence.load(std::memory_order_acquire);
+
+				// Never written, or being written
+				if (sequence == 0 || (sequence & 1) != 0) continue;
+
+				if (entry.Hash.load(std::memory_order_relaxed) != hash || entry.Generation.load(std::memory_order_relaxed) != generation)
+					continue;
+
+				if (now != 0 && now >= entry.Expiry.load(std::memory_order_relaxed))
+					continue;
+
+				b8 match = true;
+				u64 words[ResultWords];
+
+				for (u32 i = 0; i < KeyWords; i++) match &= entry.Key[i].load(std::memory_order_relaxed) == key[i];
+				for (u32 i = 0; i < ResultWords; i++) words[i] = entry.Result[i].load(std::memory_order_relaxed);
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				if (!match || entry.Sequence.load(std::memory_order_relaxed) != sequence)
+					continue;
+
+				// Only stores when the bit changes, so that hot entries read a shared line without bouncing it
+				if (!entry.Referenced.load(std::memory_order_relaxed))
+					entry.Referenced.store(true, std::memory_order_relaxed);
+
+				memcpy(result, words, ResultSize);
+
+				if ((m_Shards[Stats::GetStripe() & m_ShardMask].Hits.fetch_add(1, std::memory_order_relaxed) + 1) % INTEROP_CACHE_HIT_BATCH == 0)
+					Stats::Add(m_Usage->Hits, INTEROP_CACHE_HIT_BATCH);
+
+				return true;
+			}
+
+			// Misses go on to call into managed code, next to which the shared counter is cheap
+			Stats::Add(m_Usage->Misses, 1);
+			return false;
+		}
+
+		// Stores the result of a key, computed while the cache was at the generation provided
+		void Insert(u64 hash, const u64* key, const void* result, u32 generation)
+		{
+			u32 setIndex = static_cast<u32>(hash) & m_SetMask;
+			Entry* set = m_Entries + setIndex * INTEROP_CACHE_WAYS;
+
+			std::lock_guard<std::mutex> lock(m_Shards[setIndex & m_ShardMask].Lock);
+
+			if (generation != GetGeneration()) return;
+
+			u64 now = m_TimeToLive != 0 ? GetTime() : 0;
+			Entry* target = nullptr;
+			Entry* dead = nullptr;
+
+			// Entries only change under the lock of their shard, which is held
+			for (u32 way = 0; way < INTEROP_CACHE_WAYS && target == nullptr; way++)
+			{
+				Entry& entry = set[way];
+
+				b8 live = entry.Sequence.load(std::memory_order_relaxed) != 0
+					&& entry.Generation.load(std::memory_order_relaxed) == generation
+					&& (now == 0 || now < entry.Expiry.load(std::memory_order_relaxed));
+
+				if (!live)
+				{
+					if (dead == nullptr) dead = &entry;
+					continue;
+				}
+
+				// Inserted by another thread that missed at the same time
+				if (entry.Hash.load(std::memory_order_relaxed) == hash && MatchKey(entry, key))
+					target = &entry;
+			}
+
+			if (target == nullptr) target = dead;
+
+			if (target == nullptr)
+			{
+				u8& hand = m_Hands[setIndex];
+
+				// Second chance: referenced entries are skipped once, a full turn clears every bit
+				while (set[hand].Referenced.load(std::memory_order_relaxed))
+				{
+					set[hand].Referenced.store(false, std::memory_order_relaxed);
+					hand = (hand + 1) % INTEROP_CACHE_WAYS;
+				}
+
+				target = &set[hand];
+				hand = (hand + 1) % INTEROP_CACHE_WAYS;
+
+				Stats::Add(m_Usage->Evictions, 1);
+			}
+
+			u64 words[ResultWords] = {};
+			memcpy(words, result, ResultSize);
+
+			u32 sequence = target->Sequence.load(std::memory_order_relaxed);
+			target->Sequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			target->Hash.store(hash, std::memory_order_relaxed);
+			target->Generation.store(generation, std::memory_order_relaxed);
+			target->Expiry.store(now + m_TimeToLive, std::memory_order_relaxed);
+			target->Referenced.store(false, std::memory_order_relaxed);
+
+			for (u32 i = 0; i < KeyWords; i++) target->Key[i].store(key[i], std::memory_order_relaxed);
+			for (u32 i = 0; i < ResultWords; i++) target->Result[i].store(words[i], std::memory_order_relaxed);
+
+			target->Sequence.store(sequence + 2, std::memory_order_release);
+		}
+
+	private:
+		struct alignas(64) Entry
+		{
+			std::atomic<u32> Sequence; // Odd while written, 0 until first written
+			std::atomic<u32> Generation;
+			std::atomic<u64> Hash;
+			std::atomic<u64> Expiry; // Nanoseconds, GetTime clock
+			std::atomic<b8> Referenced;
+
+			std::atomic<u64> Key[KeyWords];
+			std::atomic<u64> Result[ResultWords];
+		};
+
+		Entry* m_Entries = nullptr;
+
+		static INTEROP_INLINE b8 MatchKey(const Entry& entry, const u64* key)
+		{
+			for (u32 i = 0; i < KeyWords; i++)
+			{
+				if (entry.Key[i].load(std::memory_order_relaxed) != key[i]) return false;
+			}
+
+			return true;
+		}
+	};
+
+	template <typename Parameters>
+	struct KeyLayout;
+
+	// Arguments are packed back to back by their bytes: values only, pointers would key on addresses
+	template <typename... P>
+	struct KeyLayout<std::tuple<P...>>
+	{
+		static constexpr u32 Size = (0u + ... + static_cast<u32>(sizeof(P)));
+		static constexpr b8 Blittable = (true && ... && (std::is_trivially_copyable_v<P> && !std::is_pointer_v<P>));
+	};
+
+	template <typename P, typename A>
+	INTEROP_INLINE void PackArgument(u8*& cursor, const A& argument)
+	{
+		P value = static_cast<P>(argument);
+		memcpy(cursor, &value, sizeof(P));
+
+		cursor += sizeof(P);
+	}
+
+}
+
+namespace Interop
+{
+
+	// Opt-in result cache in front of a pure function bound from a hosted assembly. Hits return the stored result
+	// without entering managed code, so they are neither traced, recorded nor counted as calls; hit and miss rates
+	// go to the statistics page. Keys are the bytes of the arguments, including the padding of structures passed
+	// by value. Managed code invalidates the cache through the InvalidateResultCache export.
+	template <typename T>
+	class CachedFunction final
+	{
+		typedef typename Recorder::FunctionTraits<T>::Result Result;
+		typedef typename Recorder::FunctionTraits<T>::Parameters Parameters;
+		typedef Cache::KeyLayout<Parameters> Layout;
+		typedef Cache::ResultCache<Layout::Size, sizeof(Result)> Storage;
+
+		static_assert(!std::is_void_v<Result> && std::is_trivially_copyable_v<Result>, "Cached functions must return a blittable value");
+		static_assert(Layout::Blittable, "Cached functions must take blittable values, not pointers");
+		static_assert(Layout::Size <= INTEROP_CACHE_MAX_KEY_SIZE && sizeof(Result) <= INTEROP_CACHE_MAX_RESULT_SIZE, "Cached keys and results must fit in an entry");
+
+	public:
+		CachedFunction(const HostedFunction<T>& function, const Cache::CacheDesc& desc = {})
+			: Function(function), m_Cache(function.QualifiedName, desc) {}
+
+		CachedFunction(CachedFunction&) = delete;
+
+		HostedFunction<T> Function;
+
+		template <typename... Args>
+		INTEROP_INLINE Result operator()(Args&&... args)
+		{
+			static_assert(std::tuple_size_v<Parameters> == sizeof...(Args), "Cached calls must pass every parameter");
+
+			u64 key[Storage::KeyWords] = {};
+			u8* cursor = reinterpret_cast<u8*>(key);
+
+			PackKey(cursor, std::index_sequence_for<Args...>(), args...);
+			u64 hash = Cache::HashKey(key, Storage::KeyWords);
+
+			Result result;
+			if (m_Cache.Lookup(hash, key, &result)) return result;
+
+			u32 generation = m_Cache.GetGeneration();
+			result = Function(std::forward<Args>(args)...);
+
+			m_Cache.Insert(hash, key, &result, generation);
+			return result;
+		}
+
+		INTEROP_INLINE void Invalidate() { m_Cache.Invalidate(); }
+
+		CachedFunction& operator=(CachedFunction&) = delete;
+
+	private:
+		Storage m_Cache;
+
+		template <size_t... I, typename... Args>
+		static INTEROP_INLINE void PackKey(u8*& cursor, std::index_sequence<I...>, const Args&... args)
+		{
+			(Cache::PackArgument<std::tuple_element_t<I, Parameters>>(cursor, args), ...);
+		}
+	};
+
+}
\ No newline at end of file
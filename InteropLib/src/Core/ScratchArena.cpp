@@ -0,0 +1,219 @@
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+#include "Core/ScratchArena.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace Interop::Scratch
+{
+
+	// Header of a chunk, its data follows right after
+	struct alignas(64) Chunk
+	{
+		Chunk* Previous = nullptr;
+		u64 Start = 0; // Arena position of the first data byte
+		u64 Capacity = 0;
+	};
+
+	struct Arena
+	{
+		Chunk* Current = nullptr;
+		Chunk* Spare = nullptr; // Last regular chunk released, kept to avoid heap churn around a chunk boundary
+		u64 Offset = 0;
+
+		ScratchStats Stats = {};
+
+		~Arena();
+	};
+
+	static thread_local Arena t_Arena;
+	static std::atomic<u64> s_PeakHighWater = 0;
+
+	static INTEROP_INLINE u8* GetData(Chunk* chunk)
+	{
+		return reinterpret_cast<u8*>(chunk + 1);
+	}
+
+	static INTEROP_INLINE void Poison(void* address, u64 size)
+	{
+#ifdef INTEROP_DEBUG
+		memset(address, INTEROP_SCRATCH_POISON, size);
+#else
+		(void)address;
+		(void)size;
+#endif
+	}
+
+	static void FreeChunk(Arena& arena, Chunk* chunk)
+	{
+		arena.Stats.Reserved -= chunk->Capacity;
+
+		chunk->~Chunk();
+		::operator delete(chunk, std::align_val_t(alignof(Chunk)));
+	}
+
+	Arena::~Arena()
+	{
+		while (Current != nullptr)
+		{
+			Chunk* previous = Current->Previous;
+
+			FreeChunk(*this, Current);
+			Current = previous;
+		}
+
+		if (Spare != nullptr)
+			FreeChunk(*this, Spare);
+	}
+
+	static Chunk* AcquireChunk(Arena& arena, u64 minimum)
+	{
+		if (arena.Spare != nullptr && arena.Spare->Capacity >= minimum)
+		{
+			Chunk* spare = arena.Spare;
+			arena.Spare = nullptr;
+
+			return spare;
+		}
+
+		u64 capacity = minimum > INTEROP_SCRATCH_CHUNK_SIZE ? minimum : INTEROP_SCRATCH_CHUNK_SIZE;
+		void* memory = ::operator new(sizeof(Chunk) + capacity, std::align_val_t(alignof(Chunk)), std::nothrow);
+
+		if (memory == nullptr) [[unlikely]]
+			return nullptr;
+
+		Chunk* chunk = new (memory) Chunk();
+		chunk->Capacity = capacity;
+
+		Poison(GetData(chunk), capacity);
+
+		arena.Stats.Reserved += capacity;
+		arena.Stats.ChunkAllocations++;
+
+		return chunk;
+	}
+
+	static void ReleaseChunk(Arena& arena, Chunk* chunk)
+	{
+		// Oversized chunks only serve the allocation they were made for
+		if (arena.Spare != nullptr || chunk->Capacity > INTEROP_SCRATCH_CHUNK_SIZE)
+		{
+			FreeChunk(arena, chunk);
+			return;
+		}
+
+		Poison(GetData(chunk), chunk->Capacity);
+		arena.Spare = chunk;
+	}
+
+	static INTEROP_INLINE void* BumpAllocate(Arena& arena, u32 size, u32 alignment)
+	{
+		Chunk* chunk = arena.Current;
+		if (chunk == nullptr) return nullptr;
+
+		// Aligning the address rather than the offset supports alignments above the one of the chunk
+		uintptr_t base = reinterpret_cast<uintptr_t>(GetData(chunk));
+		u64 offset = ((base + arena.Offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1)) - base;
+
+		if (offset + size > chunk->Capacity)
+			return nullptr;
+
+		arena.Offset = offset + size;
+		arena.Stats.Allocations++;
+
+		u64 position = chunk->Start + arena.Offset;
+
+		if (position > arena.Stats.HighWater) [[unlikely]]
+		{
+			arena.Stats.HighWater = position;
+
+			u64 peak = s_PeakHighWater.load(std::memory_order_relaxed);
+			while (peak < position && !s_PeakHighWater.compare_exchange_weak(peak, position, std::memory_order_relaxed));
+		}
+
+		return GetData(chunk) + offset;
+	}
+
+	void* Allocate(u32 size, u32 alignment)
+	{
+		if (alignment == 0 || (alignment & (alignment - 1)) != 0) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to allocate scratch memory, the alignment %u is not a power of two", alignment);
+			return nullptr;
+		}
+
+		Arena& arena = t_Arena;
+
+		void* address = BumpAllocate(arena, size, alignment);
+		if (address != nullptr) return address;
+
+		Chunk* chunk = AcquireChunk(arena, static_cast<u64>(size) + alignment);
+
+		if (chunk == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to allocate a scratch chunk for %u bytes", size);
+			return nullptr;
+		}
+
+		// The tail of the previous chunk is skipped, positions keep growing across chunks
+		chunk->Previous = arena.Current;
+		chunk->Start = arena.Current != nullptr ? arena.Current->Start + arena.Current->Capacity : 0;
+
+		arena.Current = chunk;
+		arena.Offset = 0;
+
+		return BumpAllocate(arena, size, alignment);
+	}
+
+	Mark GetMark()
+	{
+		Arena& arena = t_Arena;
+		return arena.Current != nullptr ? arena.Current->Start + arena.Offset : 0;
+	}
+
+	void Reset(Mark mark)
+	{
+		Arena& arena = t_Arena;
+
+		if (mark > GetMark()) [[unlikely]]
+		{
+			INTEROP_LOG_WARNING("Ignoring scratch reset to a mark ahead of the current position (%llu)", static_cast<unsigned long long>(mark));
+			return;
+		}
+
+		u64 end = arena.Offset;
+
+		while (arena.Current != nullptr && arena.Current->Start > mark)
+		{
+			Chunk* chunk = arena.Current;
+			arena.Current = chunk->Previous;
+
+			ReleaseChunk(arena, chunk);
+			end = arena.Current != nullptr ? arena.Current->Capacity : 0;
+		}
+
+		if (arena.Current == nullptr)
+		{
+			arena.Offset = 0;
+			return;
+		}
+
+		u64 offset = mark - arena.Current->Start;
+
+		Poison(GetData(arena.Current) + offset, end - offset);
+		arena.Offset = offset;
+	}
+
+	void GetStats(ScratchStats* stats)
+	{
+		Arena& arena = t_Arena;
+
+		*stats = arena.Stats;
+		stats->Used = GetMark();
+		stats->PeakHighWater = s_PeakHighWater.load(std::memory_order_relaxed);
+	}
+
+}
\ No newline at end of file
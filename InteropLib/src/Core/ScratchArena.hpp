@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+// Size of the chunks backing each thread arena, larger allocations get a chunk of their own
+#define INTEROP_SCRATCH_CHUNK_SIZE (64 * 1024)
+#define INTEROP_SCRATCH_DEFAULT_ALIGNMENT 16
+
+// Written over released scratch memory in debug builds, so that use-after-reset is easy to spot
+#define INTEROP_SCRATCH_POISON 0xDD
+
+namespace Interop::Scratch
+{
+
+	// Position of a thread arena, as returned by GetMark: resetting to it releases
+	// everything allocated on the same thread since, in LIFO order
+	typedef u64 Mark;
+
+	struct ScratchStats
+	{
+		u64 Used = 0; // Current position of the arena, in bytes
+		u64 HighWater = 0; // Highest position reached by this thread
+		u64 Reserved = 0; // Bytes held in chunks, including the spare one
+		u64 Allocations = 0;
+		u64 ChunkAllocations = 0; // Allocations that had to reach the heap
+
+		u64 PeakHighWater = 0; // Highest position reached by any thread of the process
+	};
+
+	// Bump allocation from the arena of the calling thread, nullptr only when the heap is exhausted.
+	// Alignment must be a power of two, the memory stays valid until the thread resets to an earlier mark.
+	INTEROP_API void* Allocate(u32 size, u32 alignment = INTEROP_SCRATCH_DEFAULT_ALIGNMENT);
+
+	INTEROP_API Mark GetMark();
+	INTEROP_API void Reset(Mark mark);
+
+	// Statistics of the arena of the calling thread
+	INTEROP_API void GetStats(ScratchStats* stats);
+
+	// Releases everything with a mark on construction and a reset on destruction
+	class Scope final
+	{
+	public:
+		Scope() : m_Mark(GetMark()) {}
+		Scope(Scope&) = delete;
+
+		~Scope() { Reset(m_Mark); }
+
+		template <typename T>
+		T* Allocate(u32 count = 1)
+		{
+			return static_cast<T*>(Scratch::Allocate(static_cast<u32>(count * sizeof(T)), alignof(T) > INTEROP_SCRATCH_DEFAULT_ALIGNMENT ? alignof(T) : INTEROP_SCRATCH_DEFAULT_ALIGNMENT));
+		}
+
+		Scope& operator=(Scope&) = delete;
+
+	private:
+		Mark m_Mark;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,530 @@
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+#include "Core/Memory.hpp"
+#include "Core/SharedLock.hpp"
+
+#include "Platform/Platform.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define INTEROP_CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define INTEROP_CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#define INTEROP_CPU_RELAX() ((void)0)
+#endif
+
+#define INTEROP_FUTEX_WAKE_ALL 0x7FFFFFFF
+
+// Longest sleep between two checks of the owner, which also bounds waits on platforms
+// where futexes do not wake other processes
+#define INTEROP_SHARED_LOCK_PROBE_INTERVAL 50
+
+#define INTEROP_LOCK_WAITERS 0x80000000u
+#define INTEROP_LOCK_OWNER_MASK 0x7FFFFFFFu
+#define INTEROP_LOCK_WRITER 0x40000000u
+#define INTEROP_LOCK_READER_MASK 0x3FFFFFFFu
+
+namespace Interop::Memory
+{
+
+	// On a single core, spinning only delays the owner we are waiting for
+	static INTEROP_INLINE u32 GetSpinCount(u32 spinCount)
+	{
+		static const b8 s_CanSpin = std::thread::hardware_concurrency() > 1;
+		return s_CanSpin ? spinCount : 0;
+	}
+
+	static INTEROP_INLINE u64 GetDeadline(u64 now, u32 timeout)
+	{
+		return timeout == INTEROP_SHARED_LOCK_INFINITE ? std::numeric_limits<u64>::max() : now + timeout;
+	}
+
+	static INTEROP_INLINE u32 GetSleepTime(u64 now, u64 deadline, u64 probe)
+	{
+		return static_cast<u32>(std::min(deadline, probe) - now);
+	}
+
+	// Sets the waiters flag on a state seen held, returns false if the state changed in between
+	static INTEROP_INLINE b8 MarkWaiters(std::atomic<u32>& state, u32& value)
+	{
+		if ((value & INTEROP_LOCK_WAITERS) != 0) return true;
+
+		if (!state.compare_exchange_weak(value, value | INTEROP_LOCK_WAITERS, std::memory_order_relaxed, std::memory_order_relaxed))
+			return false;
+
+		value |= INTEROP_LOCK_WAITERS;
+		return true;
+	}
+
+	static INTEROP_INLINE u32 GetMutexOwner()
+	{
+		return static_cast<u32>(Platform::GetCurrentThreadId()) & INTEROP_LOCK_OWNER_MASK;
+	}
+
+	SharedMutex* CreateSharedMutex(void* address)
+	{
+		if (address == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to create shared mutex, no memory provided");
+			return nullptr;
+		}
+
+		SharedMutex* mutex = static_cast<SharedMutex*>(address);
+
+		new (&mutex->State) std::atomic<u32>(0);
+		mutex->Padding = 0;
+
+		return mutex;
+	}
+
+	SharedMutex* ReserveSharedMutex()
+	{
+		return CreateSharedMutex(Reserve(sizeof(SharedMutex)));
+	}
+
+	LockResult TryLockSharedMutex(SharedMutex* mutex)
+	{
+		u32 expected = 0;
+
+		if (mutex->State.compare_exchange_strong(expected, GetMutexOwner(), std::memory_order_acquire, std::memory_order_relaxed))
+			return INTEROP_LOCK_RESULT_ACQUIRED;
+
+		return INTEROP_LOCK_RESULT_TIMEOUT;
+	}
+
+	LockResult LockSharedMutex(SharedMutex* mutex, u32 timeout, u32 spinCount)
+	{
+		std::atomic<u32>& state = mutex->State;
+		u32 self = GetMutexOwner();
+		u32 value = 0;
+
+		if (state.compare_exchange_strong(value, self, std::memory_order_acquire, std::memory_order_relaxed))
+			return INTEROP_LOCK_RESULT_ACQUIRED;
+
+		if ((value & INTEROP_LOCK_OWNER_MASK) == self) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to lock shared mutex, it is already held by this thread");
+			return INTEROP_LOCK_RESULT_TIMEOUT;
+		}
+
+		spinCount = GetSpinCount(spinCount);
+
+		for (u32 i = 0; i < spinCount; i++)
+		{
+			value = state.load(std::memory_order_relaxed);
+
+			if (value == 0 && state.compare_exchange_weak(value, self, std::memory_order_acquire, std::memory_order_relaxed))
+				return INTEROP_LOCK_RESULT_ACQUIRED;
+
+			INTEROP_CPU_RELAX();
+		}
+
+		u64 now = Platform::GetMonotonicTime();
+		u64 deadline = GetDeadline(now, timeout);
+		u64 probe = now + INTEROP_SHARED_LOCK_PROBE_INTERVAL;
+
+		value = state.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			// Other waiters may be asleep, keep the flag so that our unlock wakes one of them
+			if (value == 0)
+			{
+				if (state.compare_exchange_weak(value, self | INTEROP_LOCK_WAITERS, std::memory_order_acquire, std::memory_order_relaxed))
+					return INTEROP_LOCK_RESULT_ACQUIRED;
+
+				continue;
+			}
+
+			if (!MarkWaiters(state, value)) continue;
+
+			if (now >= probe)
+			{
+				// A dead owner never changes the state, so the exchange only succeeds if it still holds it
+				if (!Platform::IsThreadAlive(value & INTEROP_LOCK_OWNER_MASK))
+				{
+					if (state.compare_exchange_strong(value, self | INTEROP_LOCK_WAITERS, std::memory_order_acquire, std::memory_order_relaxed))
+					{
+						INTEROP_LOG_WARNING("Recovered shared mutex from thread %u, which died holding it", value & INTEROP_LOCK_OWNER_MASK);
+						return INTEROP_LOCK_RESULT_OWNER_DIED;
+					}
+
+					continue;
+				}
+
+				probe = now + INTEROP_SHARED_LOCK_PROBE_INTERVAL;
+			}
+
+			if (now >= deadline) return INTEROP_LOCK_RESULT_TIMEOUT;
+
+			Platform::FutexWait(reinterpret_cast<u32*>(&state), value, GetSleepTime(now, deadline, probe));
+
+			now = Platform::GetMonotonicTime();
+			value = state.load(std::memory_order_relaxed);
+		}
+	}
+
+	void UnlockSharedMutex(SharedMutex* mutex)
+	{
+		if ((mutex->State.exchange(0, std::memory_order_release) & INTEROP_LOCK_WAITERS) != 0)
+			Platform::FutexWake(reinterpret_cast<u32*>(&mutex->State), 1);
+	}
+
+	SharedRwLock* CreateSharedRwLock(void* address)
+	{
+		if (address == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to create shared reader/writer lock, no memory provided");
+			return nullptr;
+		}
+
+		SharedRwLock* lock = static_cast<SharedRwLock*>(address);
+
+		new (&lock->State) std::atomic<u32>(0);
+		lock->Padding = 0;
+
+		new (&lock->Writer) std::atomic<u64>(0);
+
+		for (u32 i = 0; i < INTEROP_SHARED_RWLOCK_READER_SLOTS; i++)
+			new (&lock->Readers[i]) std::atomic<u64>(0);
+
+		return lock;
+	}
+
+	SharedRwLock* ReserveSharedRwLock()
+	{
+		return CreateSharedRwLock(Reserve(sizeof(SharedRwLock)));
+	}
+
+	static void TrackReader(SharedRwLock* lock, u64 self)
+	{
+		for (u32 i = 0; i < INTEROP_SHARED_RWLOCK_READER_SLOTS; i++)
+		{
+			std::atomic<u64>& slot = lock->Readers[(self + i) % INTEROP_SHARED_RWLOCK_READER_SLOTS];
+			u64 expected = 0;
+
+			if (slot.load(std::memory_order_relaxed) == 0 && slot.compare_exchange_strong(expected, self, std::memory_order_relaxed))
+				return;
+		}
+	}
+
+	static void UntrackReader(SharedRwLock* lock, u64 self)
+	{
+		for (u32 i = 0; i < INTEROP_SHARED_RWLOCK_READER_SLOTS; i++)
+		{
+			std::atomic<u64>& slot = lock->Readers[(self + i) % INTEROP_SHARED_RWLOCK_READER_SLOTS];
+			u64 expected = self;
+
+			if (slot.load(std::memory_order_relaxed) == self && slot.compare_exchange_strong(expected, 0, std::memory_order_relaxed))
+				return;
+		}
+	}
+
+	// Drops the readers that died holding the lock, only called by the writer waiting for them to leave
+	static void RecoverReaders(SharedRwLock* lock)
+	{
+		for (u32 i = 0; i < INTEROP_SHARED_RWLOCK_READER_SLOTS; i++)
+		{
+			u64 reader = lock->Readers[i].load(std::memory_order_relaxed);
+
+			if (reader == 0 || Platform::IsThreadAlive(reader)) continue;
+
+			if (lock->Readers[i].compare_exchange_strong(reader, 0, std::memory_order_relaxed))
+			{
+				INTEROP_LOG_WARNING("Recovered shared reader/writer lock from reader thread %llu, which died holding it", reader);
+				lock->State.fetch_sub(1, std::memory_order_acq_rel);
+			}
+		}
+	}
+
+	// Takes the lock over from a writer that died, keeping it for this thread or releasing it. Returns true if this
+	// thread did it.
+	static b8 RecoverWriter(SharedRwLock* lock, u64 self, b8 keep)
+	{
+		u64 writer = lock->Writer.load(std::memory_order_relaxed);
+
+		if (writer == 0 || Platform::IsThreadAlive(writer)) return false;
+
+		// Every waiter may probe the same dead writer, only one of them wins the exchange. The field stays claimed
+		// while the flag is cleared, so that no new writer sets the flag for this thread to clear.
+		if (!lock->Writer.compare_exchange_strong(writer, self, std::memory_order_acquire, std::memory_order_relaxed)) return false;
+
+		INTEROP_LOG_WARNING("Recovered shared reader/writer lock from writer thread %llu, which died holding it", writer);
+
+		if (!keep) UnlockSharedWrite(lock);
+		return true;
+	}
+
+	static INTEROP_INLINE b8 TryAddReader(std::atomic<u32>& state, u32& value)
+	{
+		if ((value & INTEROP_LOCK_READER_MASK) == INTEROP_LOCK_READER_MASK) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to lock shared reader/writer lock, too many readers");
+			return false;
+		}
+
+		return state.compare_exchange_weak(value, value + 1, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	LockResult TryLockSharedRead(SharedRwLock* lock)
+	{
+		u32 value = lock->State.load(std::memory_order_relaxed);
+
+		while ((value & INTEROP_LOCK_WRITER) == 0)
+		{
+			if (TryAddReader(lock->State, value))
+			{
+				TrackReader(lock, Platform::GetCurrentThreadId());
+				return INTEROP_LOCK_RESULT_ACQUIRED;
+			}
+
+			if ((value & INTEROP_LOCK_READER_MASK) == INTEROP_LOCK_READER_MASK) [[unlikely]]
+				break;
+		}
+
+		return INTEROP_LOCK_RESULT_TIMEOUT;
+	}
+
+	LockResult LockSharedRead(SharedRwLock* lock, u32 timeout, u32 spinCount)
+	{
+		std::atomic<u32>& state = lock->State;
+		LockResult result = INTEROP_LOCK_RESULT_ACQUIRED;
+
+		spinCount = GetSpinCount(spinCount);
+
+		u64 now = 0;
+		u64 deadline = 0;
+		u64 probe = 0;
+
+		u32 value = state.load(std::memory_order_relaxed);
+
+		for (u32 i = 0; true; i++)
+		{
+			if ((value & INTEROP_LOCK_WRITER) == 0)
+			{
+				if (TryAddReader(state, value)) break;
+				if ((value & INTEROP_LOCK_READER_MASK) == INTEROP_LOCK_READER_MASK) [[unlikely]] return INTEROP_LOCK_RESULT_TIMEOUT;
+
+				continue;
+			}
+
+			if (i < spinCount)
+			{
+				INTEROP_CPU_RELAX();
+				value = state.load(std::memory_order_relaxed);
+
+				continue;
+			}
+
+			if (deadline == 0)
+			{
+				now = Platform::GetMonotonicTime();
+				deadline = GetDeadline(now, timeout);
+				probe = now + INTEROP_SHARED_LOCK_PROBE_INTERVAL;
+			}
+
+			if (!MarkWaiters(state, value)) continue;
+
+			if (now >= probe)
+			{
+				if (RecoverWriter(lock, Platform::GetCurrentThreadId(), false))
+				{
+					result = INTEROP_LOCK_RESULT_OWNER_DIED;
+					value = state.load(std::memory_order_relaxed);
+
+					continue;
+				}
+
+				probe = now + INTEROP_SHARED_LOCK_PROBE_INTERVAL;
+			}
+
+			if (now >= deadline) return INTEROP_LOCK_RESULT_TIMEOUT;
+
+			Platform::FutexWait(reinterpret_cast<u32*>(&state), value, GetSleepTime(now, deadline, probe));
+
+			now = Platform::GetMonotonicTime();
+			value = state.load(std::memory_order_relaxed);
+		}
+
+		TrackReader(lock, Platform::GetCurrentThreadId());
+		return result;
+	}
+
+	void UnlockSharedRead(SharedRwLock* lock)
+	{
+		UntrackReader(lock, Platform::GetCurrentThreadId());
+
+		std::atomic<u32>& state = lock->State;
+		u32 value = state.load(std::memory_order_relaxed);
+		u32 next = 0;
+
+		// Only a writer waits while readers hold the lock, the last reader out wakes it
+		do
+		{
+			next = value - 1;
+			if ((next & INTEROP_LOCK_READER_MASK) == 0) next &= ~INTEROP_LOCK_WAITERS;
+		} while (!state.compare_exchange_weak(value, next, std::memory_order_release, std::memory_order_relaxed));
+
+		if ((value & INTEROP_LOCK_WAITERS) != 0 && (next & INTEROP_LOCK_WAITERS) == 0)
+			Platform::FutexWake(reinterpret_cast<u32*>(&state), INTEROP_FUTEX_WAKE_ALL);
+	}
+
+	LockResult TryLockSharedWrite(SharedRwLock* lock)
+	{
+		std::atomic<u32>& state = lock->State;
+		u32 value = state.load(std::memory_order_relaxed);
+
+		if ((value & (INTEROP_LOCK_WRITER | INTEROP_LOCK_READER_MASK)) != 0) return INTEROP_LOCK_RESULT_TIMEOUT;
+
+		u64 writer = 0;
+
+		if (!lock->Writer.compare_exchange_strong(writer, Platform::GetCurrentThreadId(), std::memory_order_acquire, std::memory_order_relaxed))
+			return INTEROP_LOCK_RESULT_TIMEOUT;
+
+		// Only readers still change the state, give the claim back if one got in
+		while ((value & INTEROP_LOCK_READER_MASK) == 0)
+		{
+			if (state.compare_exchange_weak(value, value | INTEROP_LOCK_WRITER, std::memory_order_acquire, std::memory_order_relaxed))
+				return INTEROP_LOCK_RESULT_ACQUIRED;
+		}
+
+		lock->Writer.store(0, std::memory_order_release);
+		return INTEROP_LOCK_RESULT_TIMEOUT;
+	}
+
+	LockResult LockSharedWrite(SharedRwLock* lock, u32 timeout, u32 spinCount)
+	{
+		std::atomic<u32>& state = lock->State;
+		LockResult result = INTEROP_LOCK_RESULT_ACQUIRED;
+		u64 self = Platform::GetCurrentThreadId();
+
+		spinCount = GetSpinCount(spinCount);
+
+		u64 now = 0;
+		u64 deadline = 0;
+		u64 probe = 0;
+
+		u32 value = 0;
+		u32 i = 0;
+
+		// Claims the Writer field first, so that the writer flag keeping new readers out always has a known
+		// owner, then waits for the readers to leave
+		for (; true; i++)
+		{
+			u64 writer = lock->Writer.load(std::memory_order_relaxed);
+
+			if (writer == 0 && lock->Writer.compare_exchange_weak(writer, self, std::memory_order_acquire, std::memory_order_relaxed))
+				break;
+
+			if (i < spinCount)
+			{
+				INTEROP_CPU_RELAX();
+				continue;
+			}
+
+			if (deadline == 0)
+			{
+				now = Platform::GetMonotonicTime();
+				deadline = GetDeadline(now, timeout);
+				probe = now + INTEROP_SHARED_LOCK_PROBE_INTERVAL;
+			}
+
+			if (now >= probe)
+			{
+				// Ownership moves to this thread without letting anyone in
+				if (RecoverWriter(lock, self, true))
+				{
+					result = INTEROP_LOCK_RESULT_OWNER_DIED;
+					break;
+				}
+
+				probe = now + INTEROP_SHARED_LOCK_PROBE_INTERVAL;
+			}
+
+			if (now >= deadline) return INTEROP_LOCK_RESULT_TIMEOUT;
+
+			value = state.load(std::memory_order_relaxed);
+
+			// The owner sets the flag right after claiming the field and clears it right before releasing it,
+			// only sleep while it is set
+			if ((value & INTEROP_LOCK_WRITER) != 0)
+			{
+				if (!MarkWaiters(state, value)) continue;
+				Platform::FutexWait(reinterpret_cast<u32*>(&state), value, GetSleepTime(now, deadline, probe));
+			}
+
+			else
+				std::this_thread::yield();
+
+			now = Platform::GetMonotonicTime();
+		}
+
+		value = state.fetch_or(INTEROP_LOCK_WRITER, std::memory_order_acquire) | INTEROP_LOCK_WRITER;
+
+		for (; (value & INTEROP_LOCK_READER_MASK) != 0; i++)
+		{
+			if (i < spinCount)
+			{
+				INTEROP_CPU_RELAX();
+				value = state.load(std::memory_order_acquire);
+
+				continue;
+			}
+
+			if (deadline == 0)
+			{
+				now = Platform::GetMonotonicTime();
+				deadline = GetDeadline(now, timeout);
+				probe = now + INTEROP_SHARED_LOCK_PROBE_INTERVAL;
+			}
+
+			if (!MarkWaiters(state, value)) continue;
+
+			if (now >= probe)
+			{
+				RecoverReaders(lock);
+				probe = now + INTEROP_SHARED_LOCK_PROBE_INTERVAL;
+
+				value = state.load(std::memory_order_acquire);
+				continue;
+			}
+
+			// Gives the writer flag back so that the readers queued behind it get in
+			if (now >= deadline)
+			{
+				UnlockSharedWrite(lock);
+				return INTEROP_LOCK_RESULT_TIMEOUT;
+			}
+
+			Platform::FutexWait(reinterpret_cast<u32*>(&state), value, GetSleepTime(now, deadline, probe));
+
+			now = Platform::GetMonotonicTime();
+			value = state.load(std::memory_order_acquire);
+		}
+
+		return result;
+	}
+
+	void UnlockSharedWrite(SharedRwLock* lock)
+	{
+		if ((lock->State.fetch_and(~(INTEROP_LOCK_WRITER | INTEROP_LOCK_WAITERS), std::memory_order_release) & INTEROP_LOCK_WAITERS) != 0)
+			Platform::FutexWake(reinterpret_cast<u32*>(&lock->State), INTEROP_FUTEX_WAKE_ALL);
+
+		lock->Writer.store(0, std::memory_order_release);
+	}
+
+}
+
+#undef INTEROP_CPU_RELAX
+#undef INTEROP_FUTEX_WAKE_ALL
+#undef INTEROP_SHARED_LOCK_PROBE_INTERVAL
+#undef INTEROP_LOCK_WAITERS
+#undef INTEROP_LOCK_OWNER_MASK
+#undef INTEROP_LOCK_WRITER
+#undef INTEROP_LOCK_READER_MASK
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <atomic>
+
+// Iterations spent polling a held lock before a waiter falls asleep on it
+#define INTEROP_SHARED_LOCK_SPIN_COUNT 256
+#define INTEROP_SHARED_LOCK_INFINITE 0xFFFFFFFFu
+
+// Reader/writer locks remember that many readers, the others cannot be recovered if they die
+#define INTEROP_SHARED_RWLOCK_READER_SLOTS 16
+
+namespace Interop::Memory
+{
+
+	enum LockResult : u32
+	{
+		INTEROP_LOCK_RESULT_ACQUIRED = 0,
+		INTEROP_LOCK_RESULT_OWNER_DIED = 1, // Acquired from a writer that died holding it, the data it protects may be half-written
+		INTEROP_LOCK_RESULT_TIMEOUT = 2,
+	};
+
+	// Mutex living inside the shared memory map, usable from every process attached to it. The state holds
+	// the thread id of the owner and a waiters flag, so that unlocking skips the futex syscall without waiters.
+	// The futex word only fits 31 bits of the id: exact on Linux, where pid_max is at most 2^22.
+	// Blocked waiters check the owner from time to time and take the lock over if its thread is gone (robust
+	// semantics, detected on Linux and Windows; other platforms wait for the timeout).
+	// Both kinds of lock probe owners by thread id every 50 ms rather than through the kernel robust futex list:
+	// an id reused by a new thread before the probe makes the dead owner look alive until the timeout.
+	struct SharedMutex
+	{
+		std::atomic<u32> State;
+		u32 Padding;
+	};
+
+	// Writer-preferring reader/writer lock living inside the shared memory map. The state holds the number
+	// of readers, a writer flag (set while a writer holds or waits for the lock) and a waiters flag. Writers
+	// claim the Writer field with their thread id before setting the flag and clear the flag before releasing
+	// the field, so the flag is never set without a writer to recover it from. Readers also claim a slot with
+	// their thread id so that a waiting writer can drop the ones that died.
+	struct SharedRwLock
+	{
+		std::atomic<u32> State;
+		u32 Padding;
+
+		std::atomic<u64> Writer; // Thread id of the writer, 0 when no writer holds or waits for the lock
+		std::atomic<u64> Readers[INTEROP_SHARED_RWLOCK_READER_SLOTS];
+	};
+
+	static_assert(sizeof(std::atomic<u32>) == sizeof(u32), "Shared locks wait on the address of their state");
+
+	INTEROP_API SharedMutex* CreateSharedMutex(void* address);
+	INTEROP_API SharedMutex* ReserveSharedMutex();
+
+	// Spins, then sleeps until the mutex is acquired or the timeout (ms) expires
+	INTEROP_API LockResult LockSharedMutex(SharedMutex* mutex, u32 timeout = INTEROP_SHARED_LOCK_INFINITE, u32 spinCount = INTEROP_SHARED_LOCK_SPIN_COUNT);
+	INTEROP_API LockResult TryLockSharedMutex(SharedMutex* mutex);
+	INTEROP_API void UnlockSharedMutex(SharedMutex* mutex);
+
+	INTEROP_API SharedRwLock* CreateSharedRwLock(void* address);
+	INTEROP_API SharedRwLock* ReserveSharedRwLock();
+
+	// Readers must not take the lock again while holding it, a writer waiting in between would deadlock them
+	INTEROP_API LockResult LockSharedRead(SharedRwLock* lock, u32 timeout = INTEROP_SHARED_LOCK_INFINITE, u32 spinCount = INTEROP_SHARED_LOCK_SPIN_COUNT);
+	INTEROP_API LockResult TryLockSharedRead(SharedRwLock* lock);
+	INTEROP_API void UnlockSharedRead(SharedRwLock* lock);
+
+	INTEROP_API LockResult LockSharedWrite(SharedRwLock* lock, u32 timeout = INTEROP_SHARED_LOCK_INFINITE, u32 spinCount = INTEROP_SHARED_LOCK_SPIN_COUNT);
+	INTEROP_API LockResult TryLockSharedWrite(SharedRwLock* lock);
+	INTEROP_API void UnlockSharedWrite(SharedRwLock* lock);
+
+}
\ No newline at end of file
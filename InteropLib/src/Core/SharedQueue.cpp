@@ -0,0 +1,105 @@
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+#include "Core/SharedQueue.hpp"
+
+#include <cstdio>
+#include <new>
+
+namespace Interop::Memory
+{
+
+	u32 GetQueueSize(u32 capacity)
+	{
+		return static_cast<u32>(sizeof(SharedQueue) + (capacity - 1) * sizeof(QueueCell));
+	}
+
+	SharedQueue* CreateQueue(void* address, u32 capacity)
+	{
+		if (address == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to create shared queue, no memory provided");
+			return nullptr;
+		}
+
+		if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+		{
+			INTEROP_LOG_ERROR("Unable to create shared queue, the capacity (%u) must be a power of 2", capacity);
+			return nullptr;
+		}
+
+		SharedQueue* queue = static_cast<SharedQueue*>(address);
+
+		queue->Capacity = capacity;
+		queue->Mask = capacity - 1;
+
+		new (&queue->EnqueuePosition) std::atomic<u32>(0);
+		new (&queue->DequeuePosition) std::atomic<u32>(0);
+
+		for (u32 i = 0; i < capacity; i++)
+		{
+			new (&queue->Cells[i].Sequence) std::atomic<u32>(i);
+			queue->Cells[i].Item = {};
+		}
+
+		return queue;
+	}
+
+	b8 Enqueue(SharedQueue* queue, const QueueItem& item)
+	{
+		u32 position = queue->EnqueuePosition.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			QueueCell& cell = queue->Cells[position & queue->Mask];
+			u32 sequence = cell.Sequence.load(std::memory_order_acquire);
+			i32 diff = static_cast<i32>(sequence - position);
+
+			if (diff == 0)
+			{
+				if (queue->EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					cell.Item = item;
+					cell.Sequence.store(position + 1, std::memory_order_release);
+
+					return true;
+				}
+			}
+
+			else if (diff < 0)
+				return false;
+
+			else
+				position = queue->EnqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	b8 Dequeue(SharedQueue* queue, QueueItem* item)
+	{
+		u32 position = queue->DequeuePosition.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			QueueCell& cell = queue->Cells[position & queue->Mask];
+			u32 sequence = cell.Sequence.load(std::memory_order_acquire);
+			i32 diff = static_cast<i32>(sequence - (position + 1));
+
+			if (diff == 0)
+			{
+				if (queue->DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					*item = cell.Item;
+					cell.Sequence.store(position + queue->Mask + 1, std::memory_order_release);
+
+					return true;
+				}
+			}
+
+			else if (diff < 0)
+				return false;
+
+			else
+				position = queue->DequeuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <atomic>
+
+namespace Interop::Memory
+{
+
+	struct QueueItem
+	{
+		u32 Type = 0;
+		u32 Index = 0;
+		u64 Payload = 0;
+	};
+
+	struct QueueCell
+	{
+		std::atomic<u32> Sequence;
+		u32 Padding;
+		QueueItem Item;
+	};
+
+	// Bounded multi-producer/multi-consumer ring living inside the shared memory map,
+	// usable by every process attached to it (capacity must be a power of 2)
+	struct SharedQueue
+	{
+		u32 Capacity;
+		u32 Mask;
+
+		alignas(64) std::atomic<u32> EnqueuePosition;
+		alignas(64) std::atomic<u32> DequeuePosition;
+		alignas(64) QueueCell Cells[1];
+	};
+
+	static_assert(std::atomic<u32>::is_always_lock_free, "Shared queues require lock-free 32-bit atomics");
+
+	INTEROP_API u32 GetQueueSize(u32 capacity);
+	INTEROP_API SharedQueue* CreateQueue(void* address, u32 capacity);
+
+	INTEROP_API b8 Enqueue(SharedQueue* queue, const QueueItem& item);
+	INTEROP_API b8 Dequeue(SharedQueue* queue, QueueItem* item);
+
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+#include "Core/Memory.hpp"
+#include "Core/SlabAllocator.hpp"
+#include "Core/Stats.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#define INTEROP_SLAB_TAG_SHIFT 32
+#define INTEROP_SLAB_OFFSET_MASK 0xFFFFFFFFull
+
+namespace Interop::Memory
+{
+
+	static INTEROP_INLINE char* GetBase()
+	{
+		return static_cast<char*>(State::s_Instance->Allocation->BaseAddress);
+	}
+
+	// Free blocks store the offset of the next free block in their first bytes
+	static INTEROP_INLINE std::atomic_ref<u32> GetLink(SharedOffset offset)
+	{
+		return std::atomic_ref<u32>(*reinterpret_cast<u32*>(GetBase() + offset));
+	}
+
+	static INTEROP_INLINE u32 GetClassIndex(u32 size)
+	{
+		u32 shift = size <= (1u << INTEROP_SLAB_MIN_SHIFT) ? INTEROP_SLAB_MIN_SHIFT : static_cast<u32>(std::bit_width(size - 1));
+		return shift - INTEROP_SLAB_MIN_SHIFT;
+	}
+
+	static INTEROP_INLINE u32 GetClassSize(u32 classIndex)
+	{
+		return 1u << (classIndex + INTEROP_SLAB_MIN_SHIFT);
+	}
+
+	static INTEROP_INLINE u64 MakeHead(u64 previous, SharedOffset offset)
+	{
+		return ((previous >> INTEROP_SLAB_TAG_SHIFT) + 1) << INTEROP_SLAB_TAG_SHIFT | offset;
+	}
+
+	static SharedOffset PopBlock(SlabHeap* heap, u32 classIndex)
+	{
+		std::atomic<u64>& list = heap->FreeLists[classIndex];
+		u64 head = list.load(std::memory_order_acquire);
+
+		while ((head & INTEROP_SLAB_OFFSET_MASK) != 0)
+		{
+			SharedOffset offset = static_cast<SharedOffset>(head & INTEROP_SLAB_OFFSET_MASK);
+
+			// The block may be popped and overwritten under us, the tag then fails the exchange
+			SharedOffset next = GetLink(offset).load(std::memory_order_relaxed);
+
+			if (list.compare_exchange_weak(head, MakeHead(head, next), std::memory_order_acquire, std::memory_order_acquire))
+				return offset;
+		}
+
+		return 0;
+	}
+
+	// Pushes the chain first -> ... -> last, already linked, in a single exchange
+	static void PushBlocks(SlabHeap* heap, u32 classIndex, SharedOffset first, SharedOffset last)
+	{
+		std::atomic<u64>& list = heap->FreeLists[classIndex];
+		u64 head = list.load(std::memory_order_relaxed);
+
+		do
+		{
+			GetLink(last).store(static_cast<SharedOffset>(head & INTEROP_SLAB_OFFSET_MASK), std::memory_order_relaxed);
+		} while (!list.compare_exchange_weak(head, MakeHead(head, first), std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// Hands a new page to the class, returns its first block and frees the others
+	static SharedOffset CarvePage(SlabHeap* heap, u32 classIndex)
+	{
+		u32 page = heap->NextPage.load(std::memory_order_relaxed);
+
+		do
+		{
+			if (page >= heap->PageCount) return 0;
+		} while (!heap->NextPage.compare_exchange_weak(page, page + 1, std::memory_order_relaxed));
+
+		heap->PageClasses[page] = static_cast<u8>(classIndex + 1);
+
+		u32 blockSize = GetClassSize(classIndex);
+		u32 blockCount = INTEROP_SLAB_PAGE_SIZE / blockSize;
+		SharedOffset first = heap->FirstPage + page * INTEROP_SLAB_PAGE_SIZE;
+
+		if (blockCount > 1)
+		{
+			for (u32 i = 1; i + 1 < blockCount; i++)
+				GetLink(first + i * blockSize).store(first + (i + 1) * blockSize, std::memory_order_relaxed);
+
+			PushBlocks(heap, classIndex, first + blockSize, first + (blockCount - 1) * blockSize);
+		}
+
+		return first;
+	}
+
+	SlabHeap* CreateSlabHeap(void* address, u32 size)
+	{
+		if (address == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to create slab heap, no memory provided");
+			return nullptr;
+		}
+
+		u32 headerSize = static_cast<u32>(offsetof(SlabHeap, PageClasses));
+		u32 pageCount = size > headerSize ? (size - headerSize) / (INTEROP_SLAB_PAGE_SIZE + 1) : 0;
+
+		// Pages start on a page boundary of the map, so that blocks are aligned on their size
+		SharedOffset heapOffset = GetOffset(address);
+		SharedOffset firstPage = (heapOffset + headerSize + pageCount + INTEROP_SLAB_PAGE_SIZE - 1) & ~(INTEROP_SLAB_PAGE_SIZE - 1);
+
+		while (pageCount > 0 && firstPage + pageCount * INTEROP_SLAB_PAGE_SIZE > heapOffset + size)
+			pageCount--;
+
+		if (pageCount == 0)
+		{
+			INTEROP_LOG_ERROR("Unable to create slab heap, %u bytes cannot hold a single %u bytes page", size, INTEROP_SLAB_PAGE_SIZE);
+			return nullptr;
+		}
+
+		SlabHeap* heap = static_cast<SlabHeap*>(address);
+
+		heap->PageCount = pageCount;
+		heap->FirstPage = firstPage;
+		heap->Padding = 0;
+
+		new (&heap->NextPage) std::atomic<u32>(0);
+
+		for (u32 i = 0; i < INTEROP_SLAB_CLASS_COUNT; i++)
+			new (&heap->FreeLists[i]) std::atomic<u64>(0);
+
+		memset(heap->PageClasses, 0, pageCount);
+
+		return heap;
+	}
+
+	SlabHeap* ReserveSlabHeap(u32 size)
+	{
+		if (State::s_Instance == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to use shared memory as it has not been opened");
+			return nullptr;
+		}
+
+		State* state = State::s_Instance;
+		std::lock_guard<std::mutex> lock(state->CreationLock);
+
+		if (state->Slabs != nullptr)
+		{
+			INTEROP_LOG_WARNING("A slab heap has already been reserved in this shared memory map");
+			return state->Slabs;
+		}
+
+		// Over-reserving one page lets CreateSlabHeap align the pages without losing one
+		state->Slabs = CreateSlabHeap(Reserve(size + INTEROP_SLAB_PAGE_SIZE), size + INTEROP_SLAB_PAGE_SIZE);
+
+		return state->Slabs;
+	}
+
+	SharedOffset SlabAlloc(SlabHeap* heap, u32 size)
+	{
+		if (size == 0 || size > INTEROP_SLAB_MAX_SIZE) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to allocate %u bytes from the slab heap (max: %u)", size, INTEROP_SLAB_MAX_SIZE);
+			return 0;
+		}
+
+		u32 classIndex = GetClassIndex(size);
+
+		SharedOffset offset = PopBlock(heap, classIndex);
+		if (offset == 0) offset = CarvePage(heap, classIndex);
+
+		if (offset == 0) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to allocate %u bytes from the slab heap, it is exhausted", size);
+			Stats::RecordReservationFailure();
+		}
+
+		return offset;
+	}
+
+	void SlabFree(SlabHeap* heap, SharedOffset offset)
+	{
+		if (offset == 0) return;
+
+		u32 page = (offset - heap->FirstPage) / INTEROP_SLAB_PAGE_SIZE;
+		u32 classIndex = offset >= heap->FirstPage && page < heap->PageCount ? heap->PageClasses[page] : 0;
+
+		if (classIndex == 0 || (offset - heap->FirstPage) % GetClassSize(classIndex - 1) != 0) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Ignoring free of 0x%08x, it is not a block of the slab heap", offset);
+			return;
+		}
+
+#ifdef INTEROP_DEBUG
+		memset(GetBase() + offset + sizeof(SharedOffset), INTEROP_SLAB_POISON, GetClassSize(classIndex - 1) - sizeof(SharedOffset));
+#endif
+
+		PushBlocks(heap, classIndex - 1, offset, offset);
+	}
+
+	u32 GetSlabSize(const SlabHeap* heap, SharedOffset offset)
+	{
+		u32 page = (offset - heap->FirstPage) / INTEROP_SLAB_PAGE_SIZE;
+
+		if (offset < heap->FirstPage || page >= heap->PageCount || heap->PageClasses[page] == 0)
+			return 0;
+
+		return GetClassSize(heap->PageClasses[page] - 1u);
+	}
+
+	SharedOffset Alloc(u32 size)
+	{
+		if (State::s_Instance == nullptr || State::s_Instance->Slabs == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to allocate shared memory, no slab heap has been reserved");
+			return 0;
+		}
+
+		return SlabAlloc(State::s_Instance->Slabs, size);
+	}
+
+	void Free(SharedOffset offset)
+	{
+		if (State::s_Instance == nullptr || State::s_Instance->Slabs == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to free shared memory, no slab heap has been reserved");
+			return;
+		}
+
+		SlabFree(State::s_Instance->Slabs, offset);
+	}
+
+}
+
+#undef INTEROP_SLAB_TAG_SHIFT
+#undef INTEROP_SLAB_OFFSET_MASK
\ No newline at end of file
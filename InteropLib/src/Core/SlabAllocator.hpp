@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+#include "Core/Memory.hpp"
+
+#include <atomic>
+
+// Size classes are powers of two, from 16 bytes up to a whole page
+#define INTEROP_SLAB_MIN_SHIFT 4
+#define INTEROP_SLAB_PAGE_SHIFT 14
+#define INTEROP_SLAB_PAGE_SIZE (1u << INTEROP_SLAB_PAGE_SHIFT)
+#define INTEROP_SLAB_CLASS_COUNT (INTEROP_SLAB_PAGE_SHIFT - INTEROP_SLAB_MIN_SHIFT + 1)
+#define INTEROP_SLAB_MAX_SIZE INTEROP_SLAB_PAGE_SIZE
+
+// Written over freed slab memory in debug builds, past the free list link
+#define INTEROP_SLAB_POISON 0xDD
+
+namespace Interop::Memory
+{
+
+	// Offset from the start of the shared memory map, valid in every process attached to it
+	// (0 is never a valid allocation, the heap header always comes first)
+	typedef u32 SharedOffset;
+
+	// Heap living inside the shared memory map. Pages are handed to a size class on first use and never
+	// return to the heap, blocks go back to the lock-free free list of their class. Free list heads
+	// pack a tag with the offset of the first block, the tag changing on every update to rule out ABA.
+	struct SlabHeap
+	{
+		u32 PageCount;
+		SharedOffset FirstPage;
+
+		std::atomic<u32> NextPage;
+		u32 Padding;
+
+		alignas(64) std::atomic<u64> FreeLists[INTEROP_SLAB_CLASS_COUNT];
+
+		u8 PageClasses[1]; // PageCount entries, 0 for pages not handed out yet, else the class index + 1
+	};
+
+	static_assert(std::atomic<u64>::is_always_lock_free, "Slab heaps require lock-free 64-bit atomics");
+
+	INTEROP_API SlabHeap* CreateSlabHeap(void* address, u32 size);
+
+	// Reserves the heap used by Alloc and Free, once per shared memory map
+	INTEROP_API SlabHeap* ReserveSlabHeap(u32 size);
+
+	// Returns 0 when the size is 0 or above INTEROP_SLAB_MAX_SIZE, or when the heap is exhausted
+	INTEROP_API SharedOffset SlabAlloc(SlabHeap* heap, u32 size);
+	INTEROP_API void SlabFree(SlabHeap* heap, SharedOffset offset);
+
+	// Usable size of an allocation, its size class
+	INTEROP_API u32 GetSlabSize(const SlabHeap* heap, SharedOffset offset);
+
+	INTEROP_API SharedOffset Alloc(u32 size);
+	INTEROP_API void Free(SharedOffset offset);
+
+	INTEROP_INLINE void* Resolve(SharedOffset offset)
+	{
+		return offset != 0 ? static_cast<char*>(State::s_Instance->Allocation->BaseAddress) + offset : nullptr;
+	}
+
+	INTEROP_INLINE SharedOffset GetOffset(const void* address)
+	{
+		return address != nullptr ? static_cast<SharedOffset>(static_cast<const char*>(address) - static_cast<const char*>(State::s_Instance->Allocation->BaseAddress)) : 0;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+#include "Core/Memory.hpp"
+#include "Core/Stats.hpp"
+
+#include "Platform/Platform.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+namespace Interop::Stats
+{
+
+	static Page s_PrivatePage = {};
+	static FunctionStats s_DroppedFunction = {};
+	static BlockStats s_DroppedBlock = {};
+	static CacheStats s_DroppedCache = {};
+
+	Page* State::s_Page = &s_PrivatePage;
+
+	static std::mutex s_Mutex; // Serializes Open and registrations
+	static std::atomic<u32> s_NextStripe = 0;
+	static b8 s_Opened = false;
+
+	static Memory::SharedBuffer s_Buffer;
+	static std::string s_Name;
+	static std::string s_Path;
+
+	// Leaves the page mapped: functions bound by the process may still count calls while statics are destroyed
+	struct PageGuard
+	{
+		~PageGuard()
+		{
+#ifdef INTEROP_PLATFORM_UNIX
+			if (State::s_Page->ProcessId == Platform::GetCurrentProcessId())
+				std::remove(s_Path.c_str());
+#endif
+		}
+	};
+
+	static void InitPage(Page* page)
+	{
+		memset(static_cast<void*>(page), 0, sizeof(Page));
+
+		page->Magic = INTEROP_STATS_MAGIC;
+		page->Version = INTEROP_STATS_VERSION;
+		page->Size = sizeof(Page);
+		page->ProcessId = Platform::GetCurrentProcessId();
+		page->StartTime = static_cast<u64>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+	}
+
+	static b8 OpenLocked()
+	{
+		if (s_Opened) return State::s_Page != &s_PrivatePage;
+		s_Opened = true;
+
+		InitPage(&s_PrivatePage);
+
+		const char* disable = getenv(INTEROP_STATS_DISABLE_ENV);
+
+		if (disable != nullptr && strcmp(disable, "1") == 0)
+		{
+			INTEROP_LOG_INFO("Statistics are kept private, %s is set", INTEROP_STATS_DISABLE_ENV);
+			return false;
+		}
+
+		s_Name = INTEROP_STATS_NAME_PREFIX + std::to_string(Platform::GetCurrentProcessId());
+
+		s_Buffer.Name = s_Name.c_str();
+		s_Buffer.Size = sizeof(Page);
+
+#ifdef INTEROP_PLATFORM_UNIX
+		// An explicit path is never unlinked by the platform layer, PageGuard removes it without unmapping
+		s_Path = INTEROP_STATS_DIRECTORY + s_Name;
+		s_Buffer.Path = s_Path.c_str();
+#endif
+
+		if (!Platform::OpenOrCreateMemoryMap(&s_Buffer))
+		{
+			INTEROP_LOG_WARNING("Unable to map the statistics page \"%s\", counters are kept private", s_Name.c_str());
+			return false;
+		}
+
+		static PageGuard s_Guard;
+
+		// The file may be left over by a process that had the same id
+		Page* page = static_cast<Page*>(s_Buffer.BaseAddress);
+		InitPage(page);
+
+		State::s_Page = page;
+		return true;
+	}
+
+	u32 NextStripe()
+	{
+		return s_NextStripe.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	b8 Open()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		return OpenLocked();
+	}
+
+	FunctionStats* RegisterFunction(const char* classPath, const char* name)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		OpenLocked();
+
+		Page* page = State::s_Page;
+		u32 count = page->FunctionCount.load(std::memory_order_relaxed);
+
+		char qualifiedName[sizeof(FunctionStats::Name)];
+		snprintf(qualifiedName, sizeof(qualifiedName), "%s.%s", classPath, name);
+
+		for (u32 i = 0; i < count; i++)
+		{
+			if (strcmp(page->Functions[i].Name, qualifiedName) == 0)
+				return &page->Functions[i];
+		}
+
+		if (count == INTEROP_STATS_MAX_FUNCTIONS)
+		{
+			page->DroppedFunctions.fetch_add(1, std::memory_order_relaxed);
+			return &s_DroppedFunction;
+		}
+
+		FunctionStats* entry = &page->Functions[count];
+		memcpy(entry->Name, qualifiedName, sizeof(qualifiedName));
+
+		page->FunctionCount.store(count + 1, std::memory_order_release);
+		return entry;
+	}
+
+	BlockStats* RegisterBlock(const char* typeName, u32 elementSize, u32 capacity)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		OpenLocked();
+
+		Page* page = State::s_Page;
+		u32 count = page->BlockCount.load(std::memory_order_relaxed);
+
+		if (count == INTEROP_STATS_MAX_BLOCKS)
+		{
+			page->DroppedBlocks.fetch_add(1, std::memory_order_relaxed);
+			return &s_DroppedBlock;
+		}
+
+		BlockStats* entry = &page->Blocks[count];
+
+		snprintf(entry->Name, sizeof(entry->Name), "%s", typeName);
+		entry->ElementSize = elementSize;
+		entry->Capacity = capacity;
+
+		page->BlockCount.store(count + 1, std::memory_order_release);
+		return entry;
+	}
+
+	CacheStats* RegisterCache(const char* name)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		OpenLocked();
+
+		Page* page = State::s_Page;
+		u32 count = page->CacheCount.load(std::memory_order_relaxed);
+
+		char storedName[sizeof(CacheStats::Name)];
+		snprintf(storedName, sizeof(storedName), "%s", name);
+
+		// Caches in front of the same function share their counters
+		for (u32 i = 0; i < count; i++)
+		{
+			if (strcmp(page->Caches[i].Name, storedName) == 0)
+				return &page->Caches[i];
+		}
+
+		if (count == INTEROP_STATS_MAX_CACHES)
+		{
+			page->DroppedCaches.fetch_add(1, std::memory_order_relaxed);
+			return &s_DroppedCache;
+		}
+
+		CacheStats* entry = &page->Caches[count];
+		memcpy(entry->Name, storedName, sizeof(storedName));
+
+		page->CacheCount.store(count + 1, std::memory_order_release);
+		return entry;
+	}
+
+	void RecordReservationFailure()
+	{
+		GetPage()->ReservationFailures.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void RecordReserved(const std::atomic<u32>& reserved, u32 size)
+	{
+		Page* page = GetPage();
+		page->MemorySize.store(size, std::memory_order_relaxed);
+
+		// Reservations racing with this one may publish a value older than ours. Whoever publishes checks the
+		// source again afterwards, so the last caller to leave always leaves the latest value behind.
+		u32 published = page->MemoryReserved.load(std::memory_order_relaxed);
+		u32 current = reserved.load(std::memory_order_relaxed);
+
+		while (published != current)
+		{
+			if (page->MemoryReserved.compare_exchange_weak(published, current, std::memory_order_relaxed))
+				published = current;
+
+			current = reserved.load(std::memory_order_relaxed);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <atomic>
+
+#define INTEROP_STATS_MAGIC 0x54535049 // "IPST"
+#define INTEROP_STATS_VERSION 2
+
+#define INTEROP_STATS_MAX_FUNCTIONS 128
+#define INTEROP_STATS_MAX_BLOCKS 64
+#define INTEROP_STATS_MAX_CACHES 32
+
+// Copies of the counters bumped on every call, a power of two: threads take them in turn and readers add them up
+#define INTEROP_STATS_STRIPES 16
+
+// Pages are named "<prefix><pid>": a file of the temporary directory on Unix, a named mapping on Windows
+#define INTEROP_STATS_NAME_PREFIX "interop-stats-"
+#define INTEROP_STATS_DIRECTORY "/tmp/"
+
+// Set to 1 to keep the counters in private memory, where interop-stat cannot see them
+#define INTEROP_STATS_DISABLE_ENV "INTEROP_STATS_DISABLE"
+
+namespace Interop::Stats
+{
+
+	struct FunctionStats
+	{
+		char Name[120]; // "<class path>.<name>", cut to fit
+		std::atomic<u64> Calls; // Only calls counted outside the stripes, add the entry of every stripe
+	};
+
+	struct BlockStats
+	{
+		char Name[48]; // Type name as reported by typeid
+		u32 ElementSize;
+		u32 Capacity;
+		std::atomic<u32> HighWater; // Highest slot written through Set or MarkDirty, plus one
+		u32 Padding;
+	};
+
+	struct CacheStats
+	{
+		char Name[96]; // Name of the cached function, "<class path>.<name>"
+		std::atomic<u64> Hits;
+		std::atomic<u64> Misses; // Including expired entries and entries of an older generation
+		std::atomic<u64> Evictions; // Live entries replaced to make room
+		std::atomic<u64> Invalidations;
+	};
+
+	// Counters of the threads bumping one stripe, so that threads calling the same function do not share a line
+	struct alignas(64) Stripe
+	{
+		std::atomic<u64> BytesCopied;
+		std::atomic<u64> Calls[INTEROP_STATS_MAX_FUNCTIONS]; // Indexed like the function entries
+	};
+
+	// Mapped by every process using InteropLib and read by interop-stat, the way hsperfdata works: counters are
+	// bumped with relaxed atomics and never reset, readers derive rates from successive samples. Entries are
+	// written before their count is published. The layout only grows: fields are appended and Size tells readers
+	// how much of it the writer knows about.
+	struct Page
+	{
+		u32 Magic;
+		u32 Version;
+		u32 Size;
+		i32 ProcessId;
+		u64 StartTime; // Milliseconds since the Unix epoch
+
+		alignas(64) std::atomic<u64> ControllerCalls; // Calls into managed code made by the controller (bootstraps, GC regions, pre-warm)
+		alignas(64) std::atomic<u64> BytesCopied; // By Set, Transform and bounded text copies, add the count of every stripe
+		alignas(64) std::atomic<u64> ReservationFailures; // Reserve, blocks and slab allocations
+		std::atomic<u32> MemorySize;
+		std::atomic<u32> MemoryReserved;
+
+		std::atomic<u32> FunctionCount;
+		std::atomic<u32> BlockCount;
+		std::atomic<u32> DroppedFunctions; // Registered once the table was full, counted in no entry
+		std::atomic<u32> DroppedBlocks;
+
+		alignas(64) FunctionStats Functions[INTEROP_STATS_MAX_FUNCTIONS];
+		BlockStats Blocks[INTEROP_STATS_MAX_BLOCKS];
+
+		std::atomic<u32> CacheCount;
+		std::atomic<u32> DroppedCaches;
+		alignas(64) CacheStats Caches[INTEROP_STATS_MAX_CACHES];
+
+		Stripe Stripes[INTEROP_STATS_STRIPES];
+	};
+
+	static_assert(sizeof(FunctionStats) == 128 && sizeof(BlockStats) == 64 && sizeof(CacheStats) == 128, "Stats entries must not share cache lines");
+	static_assert(std::atomic<u64>::is_always_lock_free, "Stats pages require lock-free 64-bit atomics");
+
+	struct State
+	{
+		// Never null: counters go to a private page until Open maps the shared one
+		INTEROP_API static Page* s_Page;
+	};
+
+	// Maps the page of this process, once. It stays mapped until exit, as bound functions keep pointers to their
+	// entries, and its file is removed at exit. Forked children keep counting into the page of their parent.
+	INTEROP_API b8 Open();
+
+	// Returns the entry of a function, registering it on first use. Entries past the capacity of the page share
+	// a private one, so callers never check for null.
+	INTEROP_API FunctionStats* RegisterFunction(const char* classPath, const char* name);
+	INTEROP_API BlockStats* RegisterBlock(const char* typeName, u32 elementSize, u32 capacity);
+	INTEROP_API CacheStats* RegisterCache(const char* name);
+
+	INTEROP_INLINE Page* GetPage()
+	{
+		return State::s_Page;
+	}
+
+	// Relaxed, counts are exact but only ordered with respect to other updates of the same counter.
+	// Counters bumped on hot paths from many threads belong in their own line, or in per-shard counters.
+	INTEROP_INLINE void Add(std::atomic<u64>& counter, u64 value)
+	{
+		counter.fetch_add(value, std::memory_order_relaxed);
+	}
+
+	// Stripe of the calling thread, unbounded: callers mask it with their stripe count
+	INTEROP_API u32 NextStripe();
+
+	INTEROP_INLINE u32 GetStripe()
+	{
+		static thread_local u32 t_Stripe = NextStripe();
+		return t_Stripe;
+	}
+
+	// Entries of the private page, and the dropped entry, have no counter in the stripes of the current page
+	INTEROP_INLINE void AddCall(FunctionStats* function)
+	{
+		Page* page = GetPage();
+		uintptr_t offset = reinterpret_cast<uintptr_t>(function) - reinterpret_cast<uintptr_t>(page->Functions);
+
+		if (offset < sizeof(page->Functions))
+			Add(page->Stripes[GetStripe() & (INTEROP_STATS_STRIPES - 1)].Calls[offset / sizeof(FunctionStats)], 1);
+
+		else
+			Add(function->Calls, 1);
+	}
+
+	INTEROP_INLINE void AddBytesCopied(u64 size)
+	{
+		Add(GetPage()->Stripes[GetStripe() & (INTEROP_STATS_STRIPES - 1)].BytesCopied, size);
+	}
+
+	// Only stores when the mark moves, so that steady-state writes read a shared line without bouncing it
+	INTEROP_INLINE void RecordSlot(BlockStats* block, u32 index)
+	{
+		u32 highWater = block->HighWater.load(std::memory_order_relaxed);
+
+		while (index >= highWater && !block->HighWater.compare_exchange_weak(highWater, index + 1, std::memory_order_relaxed)) {}
+	}
+
+	INTEROP_API void RecordReservationFailure();
+	// Publishes the reserved size of the shared buffer, called after every change of it
+	INTEROP_API void RecordReserved(const std::atomic<u32>& reserved, u32 size);
+
+}
\ No newline at end of file
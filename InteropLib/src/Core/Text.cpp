@@ -0,0 +1,494 @@
+#include "Core/Definitions.hpp"
+#include "Core/Stats.hpp"
+#include "Core/Text.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define INTEROP_TEXT_X64 1
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define INTEROP_TARGET_AVX2
+#else
+#define INTEROP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Interop::Text
+{
+
+	// Every kernel processes whole blocks of ASCII and stops at the first block holding anything else
+	// (or too short to fill a block), returning the number of elements it handled.
+	// The AVX2 kernels finish with 16-element SSE2 blocks, leaving less than 16 elements to scalar code,
+	// after clearing the upper YMM state to avoid the AVX to SSE transition penalty.
+	struct Kernels
+	{
+		const char* Name;
+		u32 BlockSize; // Scalar loops only hand back to the kernels when at least a block is left
+
+		u32 (*FindZero)(const u8* text, u32 size);
+		u32 (*ScanAscii)(const u8* text, u32 size);
+		u32 (*WidenAscii)(const u8* source, u32 size, u16* destination);
+		u32 (*NarrowAscii)(const u16* source, u32 size, u8* destination);
+	};
+
+	static u32 FindZeroScalar(const u8* text, u32 size)
+	{
+		const void* zero = memchr(text, 0, size);
+		return zero != nullptr ? static_cast<u32>(static_cast<const u8*>(zero) - text) : size;
+	}
+
+#ifndef INTEROP_TEXT_X64
+
+	static u32 NoAsciiBlocks(const u8*, u32)
+	{
+		return 0;
+	}
+
+	static u32 NoWidenBlocks(const u8*, u32, u16*)
+	{
+		return 0;
+	}
+
+	static u32 NoNarrowBlocks(const u16*, u32, u8*)
+	{
+		return 0;
+	}
+
+#else
+
+	static INTEROP_INLINE u32 CountTrailingZeros(u32 mask)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, mask);
+
+		return static_cast<u32>(index);
+#else
+		return static_cast<u32>(__builtin_ctz(mask));
+#endif
+	}
+
+	static u32 FindZeroSse2(const u8* text, u32 size)
+	{
+		u32 i = 0;
+
+		for (; i + 16 <= size; i += 16)
+		{
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+			u32 mask = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_setzero_si128())));
+
+			if (mask != 0)
+				return i + CountTrailingZeros(mask);
+		}
+
+		return i + FindZeroScalar(text + i, size - i);
+	}
+
+	static u32 ScanAsciiSse2(const u8* text, u32 size)
+	{
+		u32 i = 0;
+
+		for (; i + 16 <= size; i += 16)
+		{
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+			if (_mm_movemask_epi8(block) != 0) return i;
+		}
+
+		// Overlapping last block, re-checking elements already handled rather than going scalar
+		if (i < size && size >= 16)
+		{
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + size - 16));
+			if (_mm_movemask_epi8(block) == 0) return size;
+		}
+
+		return i;
+	}
+
+	static u32 WidenAsciiSse2(const u8* source, u32 size, u16* destination)
+	{
+		u32 i = 0;
+
+		for (; i + 16 <= size; i += 16)
+		{
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+			if (_mm_movemask_epi8(block) != 0) return i;
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_unpacklo_epi8(block, _mm_setzero_si128()));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 8), _mm_unpackhi_epi8(block, _mm_setzero_si128()));
+		}
+
+		// Overlapping last block, rewriting the same values over elements already converted
+		if (i < size && size >= 16)
+		{
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + size - 16));
+			if (_mm_movemask_epi8(block) != 0) return i;
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + size - 16), _mm_unpacklo_epi8(block, _mm_setzero_si128()));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + size - 8), _mm_unpackhi_epi8(block, _mm_setzero_si128()));
+
+			return size;
+		}
+
+		return i;
+	}
+
+	static u32 NarrowAsciiSse2(const u16* source, u32 size, u8* destination)
+	{
+		const __m128i nonAscii = _mm_set1_epi16(static_cast<i16>(0xFF80));
+		u32 i = 0;
+
+		for (; i + 16 <= size; i += 16)
+		{
+			__m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+			__m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 8));
+			__m128i check = _mm_and_si128(_mm_or_si128(low, high), nonAscii);
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(check, _mm_setzero_si128())) != 0xFFFF) return i;
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+		}
+
+		// Overlapping last block, rewriting the same values over elements already converted
+		if (i < size && size >= 16)
+		{
+			__m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + size - 16));
+			__m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + size - 8));
+			__m128i check = _mm_and_si128(_mm_or_si128(low, high), nonAscii);
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(check, _mm_setzero_si128())) != 0xFFFF) return i;
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + size - 16), _mm_packus_epi16(low, high));
+
+			return size;
+		}
+
+		return i;
+	}
+
+	INTEROP_TARGET_AVX2 static u32 FindZeroAvx2(const u8* text, u32 size)
+	{
+		u32 i = 0;
+
+		for (; i + 32 <= size; i += 32)
+		{
+			__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+			u32 mask = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_setzero_si256())));
+
+			if (mask != 0)
+				return i + CountTrailingZeros(mask);
+		}
+
+		_mm256_zeroupper();
+		return i + FindZeroSse2(text + i, size - i);
+	}
+
+	INTEROP_TARGET_AVX2 static u32 ScanAsciiAvx2(const u8* text, u32 size)
+	{
+		u32 i = 0;
+
+		for (; i + 32 <= size; i += 32)
+		{
+			__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+			if (_mm256_movemask_epi8(block) != 0) break;
+		}
+
+		_mm256_zeroupper();
+		return i + ScanAsciiSse2(text + i, size - i);
+	}
+
+	INTEROP_TARGET_AVX2 static u32 WidenAsciiAvx2(const u8* source, u32 size, u16* destination)
+	{
+		u32 i = 0;
+
+		for (; i + 32 <= size; i += 32)
+		{
+			__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+			if (_mm256_movemask_epi8(block) != 0) break;
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(block)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(block, 1)));
+		}
+
+		_mm256_zeroupper();
+		return i + WidenAsciiSse2(source + i, size - i, destination + i);
+	}
+
+	INTEROP_TARGET_AVX2 static u32 NarrowAsciiAvx2(const u16* source, u32 size, u8* destination)
+	{
+		const __m256i nonAscii = _mm256_set1_epi16(static_cast<i16>(0xFF80));
+		u32 i = 0;
+
+		for (; i + 32 <= size; i += 32)
+		{
+			__m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+			__m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 16));
+
+			if (!_mm256_testz_si256(_mm256_or_si256(low, high), nonAscii)) break;
+
+			// packus works per 128-bit lane, the permutation restores the element order
+			__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), packed);
+		}
+
+		_mm256_zeroupper();
+		return i + NarrowAsciiSse2(source + i, size - i, destination + i);
+	}
+
+	static b8 SupportsAvx2()
+	{
+#ifdef _MSC_VER
+		i32 info[4];
+
+		__cpuid(info, 1);
+		if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+#endif
+
+	static Kernels SelectKernels()
+	{
+#ifdef INTEROP_TEXT_X64
+		if (SupportsAvx2())
+			return { "avx2", 16, &FindZeroAvx2, &ScanAsciiAvx2, &WidenAsciiAvx2, &NarrowAsciiAvx2 };
+
+		return { "sse2", 16, &FindZeroSse2, &ScanAsciiSse2, &WidenAsciiSse2, &NarrowAsciiSse2 };
+#else
+		return { "scalar", 0xFFFFFFFF, &FindZeroScalar, &NoAsciiBlocks, &NoWidenBlocks, &NoNarrowBlocks };
+#endif
+	}
+
+	static const Kernels s_Kernels = SelectKernels();
+
+	// Returns the length of the sequence decoded, 0 if it is invalid or truncated
+	static INTEROP_INLINE u32 DecodeUtf8(const u8* text, u32 size, u32* codePoint)
+	{
+		u8 lead = text[0];
+
+		if (lead < 0x80)
+		{
+			*codePoint = lead;
+			return 1;
+		}
+
+		if (lead >= 0xC2 && lead <= 0xDF)
+		{
+			if (size < 2 || (text[1] & 0xC0) != 0x80) return 0;
+
+			*codePoint = ((lead & 0x1Fu) << 6) | (text[1] & 0x3Fu);
+			return 2;
+		}
+
+		if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			if (size < 3 || (text[1] & 0xC0) != 0x80 || (text[2] & 0xC0) != 0x80) return 0;
+
+			*codePoint = ((lead & 0x0Fu) << 12) | ((text[1] & 0x3Fu) << 6) | (text[2] & 0x3Fu);
+			if (*codePoint < 0x800 || (*codePoint >= 0xD800 && *codePoint <= 0xDFFF)) return 0;
+
+			return 3;
+		}
+
+		if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			if (size < 4 || (text[1] & 0xC0) != 0x80 || (text[2] & 0xC0) != 0x80 || (text[3] & 0xC0) != 0x80) return 0;
+
+			*codePoint = ((lead & 0x07u) << 18) | ((text[1] & 0x3Fu) << 12) | ((text[2] & 0x3Fu) << 6) | (text[3] & 0x3Fu);
+			if (*codePoint < 0x10000 || *codePoint > 0x10FFFF) return 0;
+
+			return 4;
+		}
+
+		return 0;
+	}
+
+	const char* GetInstructionSet()
+	{
+		return s_Kernels.Name;
+	}
+
+	u32 Length(const char* text, u32 capacity)
+	{
+		return s_Kernels.FindZero(reinterpret_cast<const u8*>(text), capacity);
+	}
+
+	b8 ValidateUtf8(const char* text, u32 size)
+	{
+		const u8* bytes = reinterpret_cast<const u8*>(text);
+		u32 i = 0;
+
+		while (i < size)
+		{
+			i += s_Kernels.ScanAscii(bytes + i, size - i);
+
+			// Scalar until the next ASCII byte, then back to the vector kernel
+			while (i < size)
+			{
+				u32 codePoint;
+				u32 length = DecodeUtf8(bytes + i, size - i, &codePoint);
+
+				if (length == 0) return false;
+
+				i += length;
+				if (length == 1 && size - i >= s_Kernels.BlockSize) break;
+			}
+		}
+
+		return true;
+	}
+
+	b8 Utf8ToUtf16(const char* source, u32 size, u16* destination, u32 capacity, u32* written)
+	{
+		const u8* bytes = reinterpret_cast<const u8*>(source);
+		u32 i = 0;
+		u32 o = 0;
+
+		*written = 0;
+
+		while (i < size)
+		{
+			u32 room = capacity - o;
+			u32 blocks = s_Kernels.WidenAscii(bytes + i, size - i < room ? size - i : room, destination + o);
+
+			i += blocks;
+			o += blocks;
+
+			while (i < size)
+			{
+				u32 codePoint;
+				u32 length = DecodeUtf8(bytes + i, size - i, &codePoint);
+
+				if (length == 0) return false;
+
+				if (codePoint < 0x10000)
+				{
+					if (o + 1 > capacity) return false;
+
+					destination[o++] = static_cast<u16>(codePoint);
+				}
+
+				else
+				{
+					if (o + 2 > capacity) return false;
+
+					codePoint -= 0x10000;
+					destination[o++] = static_cast<u16>(0xD800 + (codePoint >> 10));
+					destination[o++] = static_cast<u16>(0xDC00 + (codePoint & 0x3FF));
+				}
+
+				i += length;
+				if (length == 1 && size - i >= s_Kernels.BlockSize) break;
+			}
+		}
+
+		*written = o;
+
+		return true;
+	}
+
+	b8 Utf16ToUtf8(const u16* source, u32 size, char* destination, u32 capacity, u32* written)
+	{
+		u8* bytes = reinterpret_cast<u8*>(destination);
+		u32 i = 0;
+		u32 o = 0;
+
+		*written = 0;
+
+		while (i < size)
+		{
+			u32 room = capacity - o;
+			u32 blocks = s_Kernels.NarrowAscii(source + i, size - i < room ? size - i : room, bytes + o);
+
+			i += blocks;
+			o += blocks;
+
+			while (i < size)
+			{
+				u32 unit = source[i];
+
+				if (unit < 0x80)
+				{
+					if (o + 1 > capacity) return false;
+
+					bytes[o++] = static_cast<u8>(unit);
+					i++;
+
+					if (size - i >= s_Kernels.BlockSize) break;
+					continue;
+				}
+
+				if (unit < 0x800)
+				{
+					if (o + 2 > capacity) return false;
+
+					bytes[o++] = static_cast<u8>(0xC0 | (unit >> 6));
+					bytes[o++] = static_cast<u8>(0x80 | (unit & 0x3F));
+					i++;
+				}
+
+				else if (unit >= 0xD800 && unit <= 0xDFFF)
+				{
+					if (unit > 0xDBFF || i + 1 >= size || source[i + 1] < 0xDC00 || source[i + 1] > 0xDFFF) return false;
+					if (o + 4 > capacity) return false;
+
+					u32 codePoint = 0x10000 + ((unit - 0xD800) << 10) + (source[i + 1] - 0xDC00);
+
+					bytes[o++] = static_cast<u8>(0xF0 | (codePoint >> 18));
+					bytes[o++] = static_cast<u8>(0x80 | ((codePoint >> 12) & 0x3F));
+					bytes[o++] = static_cast<u8>(0x80 | ((codePoint >> 6) & 0x3F));
+					bytes[o++] = static_cast<u8>(0x80 | (codePoint & 0x3F));
+					i += 2;
+				}
+
+				else
+				{
+					if (o + 3 > capacity) return false;
+
+					bytes[o++] = static_cast<u8>(0xE0 | (unit >> 12));
+					bytes[o++] = static_cast<u8>(0x80 | ((unit >> 6) & 0x3F));
+					bytes[o++] = static_cast<u8>(0x80 | (unit & 0x3F));
+					i++;
+				}
+			}
+		}
+
+		*written = o;
+
+		return true;
+	}
+
+	u32 CopyBounded(char* destination, u32 capacity, const char* source, u32 size)
+	{
+		if (capacity == 0) return 0;
+
+		u32 length = Length(source, size);
+
+		if (length > capacity - 1)
+		{
+			length = capacity - 1;
+
+			// Back off continuation bytes so that the cut never splits a sequence
+			while (length > 0 && (static_cast<u8>(source[length]) & 0xC0) == 0x80)
+				length--;
+		}
+
+		memcpy(destination, source, length);
+		destination[length] = '\0';
+
+		Stats::AddBytesCopied(length);
+
+		return length;
+	}
+
+}
+
+#undef INTEROP_TARGET_AVX2
+#undef INTEROP_TEXT_X64
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+namespace Interop::Text
+{
+
+	// Name of the kernels picked at startup: "avx2", "sse2" or "scalar"
+	INTEROP_API const char* GetInstructionSet();
+
+	// Length of a null-terminated string stored in a fixed-size field, capacity if it is not terminated
+	INTEROP_API u32 Length(const char* text, u32 capacity);
+
+	// Strict validation: rejects overlong encodings, surrogates and code points above U+10FFFF
+	INTEROP_API b8 ValidateUtf8(const char* text, u32 size);
+
+	// Transcode without terminating the output, fail on invalid input or if the output does not fit
+	INTEROP_API b8 Utf8ToUtf16(const char* source, u32 size, u16* destination, u32 capacity, u32* written);
+	INTEROP_API b8 Utf16ToUtf8(const u16* source, u32 size, char* destination, u32 capacity, u32* written);
+
+	// Copies into a fixed-size field, truncating on a code point boundary and always null-terminating.
+	// Returns the number of bytes copied, terminator excluded.
+	INTEROP_API u32 CopyBounded(char* destination, u32 capacity, const char* source, u32 size);
+
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
+#include "Core/Trace.hpp"
+
+#include "Platform/Platform.hpp"
+
+#include <cstdio>
+#include <mutex>
+
+namespace Interop::Trace
+{
+
+	std::atomic<b8> State::s_Enabled = false;
+
+	static std::atomic<ThreadBuffer*> s_Buffers = nullptr;
+	static std::atomic<u32> s_Epoch = 0;
+	static std::atomic<u32> s_Capacity = 0;
+
+	static u64 s_StartTicks = 0;
+	static u64 s_StartNanoseconds = 0;
+
+	// Keeps Start from moving to a new session while Stop still reads the buffers of the last one
+	static std::mutex s_SessionMutex;
+
+	// Gives the buffer back to the pool when its thread exits, its events stay readable until then
+	struct BufferOwner
+	{
+		ThreadBuffer* Buffer = nullptr;
+
+		~BufferOwner()
+		{
+			if (Buffer != nullptr)
+				Buffer->Owned.store(0, std::memory_order_release);
+		}
+	};
+
+	static thread_local BufferOwner t_Owner;
+
+	u64 Nanoseconds()
+	{
+		return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	ThreadBuffer* ClaimBuffer(u32 epoch)
+	{
+		// Buffers of the current session may still have to be written by Stop
+		for (ThreadBuffer* buffer = s_Buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next)
+		{
+			u32 owned = 0;
+
+			if (buffer->Owned.load(std::memory_order_relaxed) != 0 || !buffer->Owned.compare_exchange_strong(owned, 1, std::memory_order_acquire, std::memory_order_relaxed))
+				continue;
+
+			if (buffer->Epoch.load(std::memory_order_relaxed) != epoch)
+				return buffer;
+
+			buffer->Owned.store(0, std::memory_order_release);
+		}
+
+		ThreadBuffer* buffer = new ThreadBuffer();
+		buffer->Owned.store(1, std::memory_order_relaxed);
+
+		ThreadBuffer* head = s_Buffers.load(std::memory_order_relaxed);
+
+		do buffer->Next = head;
+		while (!s_Buffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+
+		return buffer;
+	}
+
+	ThreadBuffer* AcquireBuffer()
+	{
+		ThreadBuffer* buffer = t_Owner.Buffer;
+		u32 epoch = s_Epoch.load(std::memory_order_acquire);
+
+		if (buffer == nullptr) [[unlikely]]
+		{
+			buffer = ClaimBuffer(epoch);
+			buffer->ThreadId = static_cast<u32>(Platform::GetCurrentThreadId());
+
+			t_Owner.Buffer = buffer;
+		}
+
+		if (buffer->Epoch.load(std::memory_order_relaxed) != epoch)
+		{
+			// First event of a new session on this thread, discard the previous one and
+			// follow the capacity of the new session. Stop only reads buffers of its own session.
+			u32 capacity = s_Capacity.load(std::memory_order_relaxed);
+
+			if (buffer->Capacity != capacity)
+			{
+				delete[] buffer->Events;
+
+				buffer->Events = new Event[capacity];
+				buffer->Capacity = capacity;
+			}
+
+			buffer->Count.store(0, std::memory_order_relaxed);
+			buffer->Dropped.store(0, std::memory_order_relaxed);
+			buffer->Epoch.store(epoch, std::memory_order_release);
+		}
+
+		return buffer;
+	}
+
+	void Record(const char* name, const char* category, u64 begin, u64 end)
+	{
+		ThreadBuffer* buffer = AcquireBuffer();
+		u32 count = buffer->Count.load(std::memory_order_relaxed);
+
+		if (count >= buffer->Capacity) [[unlikely]]
+		{
+			buffer->Dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		buffer->Events[count] = { name, category, begin, end };
+		buffer->Count.store(count + 1, std::memory_order_release);
+	}
+
+	b8 Start(u32 eventsPerThread)
+	{
+		std::lock_guard<std::mutex> lock(s_SessionMutex);
+
+		if (IsEnabled()) [[unlikely]]
+		{
+			INTEROP_LOG_WARNING("A trace session is already running");
+			return false;
+		}
+
+		if (eventsPerThread == 0)
+		{
+			INTEROP_LOG_ERROR("Unable to start a trace session with a per-thread capacity of 0 events");
+			return false;
+		}
+
+		// Published before the epoch, threads resize their buffer on their first event of the session
+		s_Capacity.store(eventsPerThread, std::memory_order_relaxed);
+
+		// Owners reset their buffer again on their first event, this drops whatever
+		// threads recorded after the last session was stopped
+		for (ThreadBuffer* buffer = s_Buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next)
+		{
+			buffer->Count.store(0, std::memory_order_relaxed);
+			buffer->Dropped.store(0, std::memory_order_relaxed);
+		}
+
+		s_StartNanoseconds = Nanoseconds();
+		s_StartTicks = Timestamp();
+
+		s_Epoch.fetch_add(1, std::memory_order_release);
+		State::s_Enabled.store(true, std::memory_order_release);
+
+		return true;
+	}
+
+	void WriteEscaped(FILE* file, const char* str)
+	{
+		for (const char* c = str; c != nullptr && *c != '\0'; c++)
+		{
+			if (*c == '"' || *c == '\\') fputc('\\', file);
+			if (static_cast<u8>(*c) >= 0x20) fputc(*c, file);
+		}
+	}
+
+	b8 Stop(const char* path)
+	{
+		std::lock_guard<std::mutex> lock(s_SessionMutex);
+
+		if (!IsEnabled()) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("No trace session is running");
+			return false;
+		}
+
+		State::s_Enabled.store(false, std::memory_order_release);
+
+		u64 stopTicks = Timestamp();
+		u64 stopNanoseconds = Nanoseconds();
+
+		if (path == nullptr)
+			return true;
+
+		FILE* file = fopen(path, "w");
+
+		if (file == nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to open \"%s\" to write the trace session", path);
+			return false;
+		}
+
+		f64 elapsedMicroseconds = static_cast<f64>(stopNanoseconds - s_StartNanoseconds) / 1000.0;
+		f64 ticksPerMicrosecond = elapsedMicroseconds > 0.0 ? static_cast<f64>(stopTicks - s_StartTicks) / elapsedMicroseconds : 1.0;
+
+		u32 epoch = s_Epoch.load(std::memory_order_acquire);
+		i32 pid = Platform::GetCurrentProcessId();
+		u64 dropped = 0;
+
+		fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+		fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"InteropLib\"}}", pid);
+
+		for (ThreadBuffer* buffer = s_Buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next)
+		{
+			if (buffer->Epoch.load(std::memory_order_acquire) != epoch)
+				continue;
+
+			u32 count = buffer->Count.load(std::memory_order_acquire);
+			dropped += buffer->Dropped.load(std::memory_order_relaxed);
+
+			for (u32 i = 0; i < count; i++)
+			{
+				const Event& e = buffer->Events[i];
+
+				// Scopes opened during an earlier session and closed during this one, not part of it
+				if (e.Begin < s_StartTicks)
+					continue;
+
+				// Counters of different cores may disagree slightly
+				f64 ts = static_cast<f64>(e.Begin - s_StartTicks) / ticksPerMicrosecond;
+				f64 dur = e.End > e.Begin ? static_cast<f64>(e.End - e.Begin) / ticksPerMicrosecond : 0.0;
+
+				fprintf(file, ",\n{\"name\":\"");
+				WriteEscaped(file, e.Name);
+				fprintf(file, "\",\"cat\":\"");
+				WriteEscaped(file, e.Category);
+				fprintf(file, "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u}", ts, dur, pid, buffer->ThreadId);
+			}
+		}
+
+		fprintf(file, "\n]}\n");
+		fclose(file);
+
+		if (dropped > 0)
+		{
+			INTEROP_LOG_ERROR("Trace session written to \"%s\", %llu events dropped because of full thread buffers", path, dropped);
+		}
+
+		return true;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include <atomic>
+#include <chrono>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace Interop::Trace
+{
+
+	struct Event
+	{
+		const char* Name;
+		const char* Category;
+		u64 Begin;
+		u64 End;
+	};
+
+	// Written only by its owning thread, read by Stop once the owner published the event count.
+	// Released when the owner exits, and handed to a new thread once its session has been stopped.
+	struct ThreadBuffer
+	{
+		ThreadBuffer* Next = nullptr;
+		Event* Events = nullptr;
+
+		u32 ThreadId = 0;
+		u32 Capacity = 0;
+
+		std::atomic<u32> Epoch = 0;
+		std::atomic<u32> Count = 0;
+		std::atomic<u32> Dropped = 0;
+		std::atomic<u32> Owned = 0;
+	};
+
+	struct State
+	{
+		INTEROP_API static std::atomic<b8> s_Enabled;
+	};
+
+	// Event names and categories are stored by pointer: they must outlive the trace session
+	INTEROP_API b8 Start(u32 eventsPerThread = 65536);
+	INTEROP_API b8 Stop(const char* path = nullptr);
+
+	INTEROP_API void Record(const char* name, const char* category, u64 begin, u64 end);
+
+	INTEROP_INLINE u64 Timestamp()
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return __rdtsc();
+
+#else
+		return static_cast<u64>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+	}
+
+	INTEROP_INLINE b8 IsEnabled()
+	{
+		return State::s_Enabled.load(std::memory_order_relaxed);
+	}
+
+	class Scope final
+	{
+	public:
+		INTEROP_INLINE Scope(const char* name, const char* category) : m_Name(name), m_Category(category)
+		{
+			if (IsEnabled()) [[unlikely]]
+				m_Begin = Timestamp();
+		}
+
+		Scope(Scope&) = delete;
+
+		INTEROP_INLINE ~Scope()
+		{
+			// Scopes outliving their session are not recorded in the next one, Stop skips those spanning both
+			if (m_Begin != 0 && IsEnabled()) [[unlikely]]
+				Record(m_Name, m_Category, m_Begin, Timestamp());
+		}
+
+		Scope& operator=(Scope&) = delete;
+
+	private:
+		const char* m_Name;
+		const char* m_Category;
+		u64 m_Begin = 0;
+	};
+
+}
+
+#define INTEROP_TRACE_CONCAT_IMPL(a, b) a##b
+#define INTEROP_TRACE_CONCAT(a, b) INTEROP_TRACE_CONCAT_IMPL(a, b)
+
+#define INTEROP_TRACE_SCOPE(name, category) ::Interop::Trace::Scope INTEROP_TRACE_CONCAT(traceScope, __LINE__)(name, category)
\ No newline at end of file
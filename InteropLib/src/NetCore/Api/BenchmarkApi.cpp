@@ -0,0 +1,13 @@
+#include "Core/Definitions.hpp"
+
+#include "NetCore/Api/BenchmarkApi.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	void BenchmarkNoop(void* obj)
+	{
+		(void)obj;
+	}
+
+}
\ No newline at end of file
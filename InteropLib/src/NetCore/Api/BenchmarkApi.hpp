@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	INTEROP_C_API void BenchmarkNoop(void* obj);
+
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "Core/Buffer.hpp"
+#include "Core/Definitions.hpp"
+
+#include "NetCore/Api/BufferApi.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	Buffers::Buffer* CreateBuffer(u64 size)
+	{
+		return Buffers::Create(size);
+	}
+
+	Buffers::Buffer* CreateSharedBuffer(u32 size)
+	{
+		return Buffers::CreateShared(size);
+	}
+
+	void AcquireBuffer(Buffers::Buffer* buffer)
+	{
+		Buffers::Acquire(buffer);
+	}
+
+	u32 ReleaseBuffer(Buffers::Buffer* buffer)
+	{
+		return Buffers::Release(buffer);
+	}
+
+}
\ No newline at end of file
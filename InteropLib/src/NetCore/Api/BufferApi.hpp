@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Core/Buffer.hpp"
+#include "Core/Definitions.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	INTEROP_C_API Buffers::Buffer* CreateBuffer(u64 size);
+	INTEROP_C_API Buffers::Buffer* CreateSharedBuffer(u32 size);
+	INTEROP_C_API void AcquireBuffer(Buffers::Buffer* buffer);
+	INTEROP_C_API u32 ReleaseBuffer(Buffers::Buffer* buffer);
+
+}
\ No newline at end of file
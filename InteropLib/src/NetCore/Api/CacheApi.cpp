@@ -0,0 +1,14 @@
+#include "Core/Definitions.hpp"
+#include "Core/ResultCache.hpp"
+
+#include "NetCore/Api/CacheApi.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	u32 InvalidateResultCache(const char* name)
+	{
+		return Cache::Invalidate(name);
+	}
+
+}
\ No newline at end of file
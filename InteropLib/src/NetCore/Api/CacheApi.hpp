@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	INTEROP_C_API u32 InvalidateResultCache(const char* name);
+
+}
\ No newline at end of file
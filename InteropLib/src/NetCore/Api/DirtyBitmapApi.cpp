@@ -0,0 +1,14 @@
+#include "Core/Definitions.hpp"
+#include "Core/DirtyBitmap.hpp"
+
+#include "NetCore/Api/DirtyBitmapApi.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	u32 CollectDirtySlots(u64* words, u32 wordCount, u64* destination)
+	{
+		return Memory::CollectDirty(words, wordCount, destination);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	INTEROP_C_API u32 CollectDirtySlots(u64* words, u32 wordCount, u64* destination);
+
+}
\ No newline at end of file
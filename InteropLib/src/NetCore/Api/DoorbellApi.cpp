@@ -0,0 +1,24 @@
+#include "Core/Definitions.hpp"
+#include "Core/Doorbell.hpp"
+
+#include "NetCore/Api/DoorbellApi.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	Memory::Doorbell* ReserveDoorbell(u8 eventFd)
+	{
+		return Memory::ReserveDoorbell(eventFd != 0);
+	}
+
+	void RingDoorbell(Memory::Doorbell* doorbell)
+	{
+		Memory::RingDoorbell(doorbell);
+	}
+
+	u8 WaitDoorbell(Memory::Doorbell* doorbell, u32 observed, u32 timeout)
+	{
+		return Memory::WaitDoorbell(doorbell, observed, timeout) ? 1 : 0;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+#include "Core/Doorbell.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	INTEROP_C_API Memory::Doorbell* ReserveDoorbell(u8 eventFd);
+	INTEROP_C_API void RingDoorbell(Memory::Doorbell* doorbell);
+	INTEROP_C_API u8 WaitDoorbell(Memory::Doorbell* doorbell, u32 observed, u32 timeout);
+
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "Core/Definitions.hpp"
+#include "Core/Recorder.hpp"
+#include "Core/Trace.hpp"
 
 #include "NetCore/Api/ExampleApi.hpp"
 
@@ -9,12 +11,18 @@ namespace Interop::NetCore::Api
 
 	void PrintHostedObjProperties(void* obj)
 	{
+		INTEROP_TRACE_SCOPE("PrintHostedObjProperties", "native");
+		INTEROP_RECORD_EXPORT(PrintHostedObjProperties, static_cast<CustomObject*>(obj));
+
 		CustomObject* customObj = static_cast<CustomObject*>(obj);
 		printf("[C++] PrintHostedObjProperties: TextProperty=\"%s\"; DoubleProperty=%f\n", customObj->TextProperty, customObj->DoubleProperty);
 	}
 
 	void ProcessCustomObject(void* obj, ParseCustomObjectFn callback)
 	{
+		INTEROP_TRACE_SCOPE("ProcessCustomObject", "native");
+		INTEROP_RECORD_EXPORT(ProcessCustomObject, static_cast<CustomObject*>(obj), callback);
+
 		callback(obj);
 	}
 
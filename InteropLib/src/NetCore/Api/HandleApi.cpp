@@ -0,0 +1,68 @@
+#include "Core/Definitions.hpp"
+#include "Core/HandleTable.hpp"
+
+#include "NetCore/Api/HandleApi.hpp"
+
+#include <vector>
+
+namespace Interop::NetCore::Api
+{
+
+	u32 AllocateHandles(const Handles::HandleTarget* targets, u32 count, Handles::Handle* handles)
+	{
+		return Handles::Allocate(targets, count, handles);
+	}
+
+	u32 ReleaseHandles(const Handles::Handle* handles, u32 count)
+	{
+		return Handles::Release(handles, count);
+	}
+
+	intptr_t ResolveHandle(Handles::Handle handle)
+	{
+		return Handles::Resolve(handle);
+	}
+
+	void* GetHandleAddress(Handles::Handle handle)
+	{
+		return Handles::GetAddress(handle);
+	}
+
+	void SetHandleReleaseCallback(Handles::ReleaseCallbackFn callback)
+	{
+		Handles::SetReleaseCallback(callback);
+	}
+
+	u32 AllocateCompactHandles(const Handles::HandleTarget* targets, u32 count, Handles::CompactHandle* handles)
+	{
+		std::vector<Handles::Handle> allocated(count);
+
+		u32 result = Handles::Allocate(targets, count, allocated.data());
+
+		for (u32 i = 0; i < result; i++)
+			handles[i] = Handles::Compact(allocated[i]);
+
+		return result;
+	}
+
+	u32 ReleaseCompactHandles(const Handles::CompactHandle* handles, u32 count)
+	{
+		std::vector<Handles::Handle> expanded(count);
+
+		for (u32 i = 0; i < count; i++)
+			expanded[i] = Handles::Expand(handles[i]);
+
+		return Handles::Release(expanded.data(), count);
+	}
+
+	intptr_t ResolveCompactHandle(Handles::CompactHandle handle)
+	{
+		return Handles::Resolve(Handles::Expand(handle));
+	}
+
+	void* GetCompactHandleAddress(Handles::CompactHandle handle)
+	{
+		return Handles::GetAddress(Handles::Expand(handle));
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+#include "Core/HandleTable.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	INTEROP_C_API u32 AllocateHandles(const Handles::HandleTarget* targets, u32 count, Handles::Handle* handles);
+	INTEROP_C_API u32 ReleaseHandles(const Handles::Handle* handles, u32 count);
+	INTEROP_C_API intptr_t ResolveHandle(Handles::Handle handle);
+	INTEROP_C_API void* GetHandleAddress(Handles::Handle handle);
+	INTEROP_C_API void SetHandleReleaseCallback(Handles::ReleaseCallbackFn callback);
+
+	// Version 2 exports, taking compact handles
+	INTEROP_C_API u32 AllocateCompactHandles(const Handles::HandleTarget* targets, u32 count, Handles::CompactHandle* handles);
+	INTEROP_C_API u32 ReleaseCompactHandles(const Handles::CompactHandle* handles, u32 count);
+	INTEROP_C_API intptr_t ResolveCompactHandle(Handles::CompactHandle handle);
+	INTEROP_C_API void* GetCompactHandleAddress(Handles::CompactHandle handle);
+
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "Core/Definitions.hpp"
+
+#include "NetCore/Api/NativeExports.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	static NativeExports CreateNativeExports()
+	{
+		NativeExports exports = {};
+
+		exports.PrintHostedObjProperties = &PrintHostedObjProperties;
+		exports.ProcessCustomObject = &ProcessCustomObject;
+		exports.BenchmarkNoop = &BenchmarkNoop;
+
+		exports.AllocateCompactHandles = &AllocateCompactHandles;
+		exports.ReleaseCompactHandles = &ReleaseCompactHandles;
+		exports.ResolveCompactHandle = &ResolveCompactHandle;
+		exports.GetCompactHandleAddress = &GetCompactHandleAddress;
+		exports.SetHandleReleaseCallback = &SetHandleReleaseCallback;
+
+		exports.ReserveDoorbell = &ReserveDoorbell;
+		exports.RingDoorbell = &RingDoorbell;
+		exports.WaitDoorbell = &WaitDoorbell;
+
+		exports.GetTextLength = &GetTextLength;
+		exports.ValidateUtf8Text = &ValidateUtf8Text;
+		exports.TranscodeUtf8ToUtf16 = &TranscodeUtf8ToUtf16;
+		exports.TranscodeUtf16ToUtf8 = &TranscodeUtf16ToUtf8;
+		exports.CopyTextBounded = &CopyTextBounded;
+
+		exports.AllocateScratch = &AllocateScratch;
+		exports.GetScratchMark = &GetScratchMark;
+		exports.ResetScratch = &ResetScratch;
+		exports.GetScratchStats = &GetScratchStats;
+
+		exports.CollectDirtySlots = &CollectDirtySlots;
+
+		exports.SharedAlloc = &SharedAlloc;
+		exports.SharedFree = &SharedFree;
+		exports.ResolveSharedOffset = &ResolveSharedOffset;
+		exports.GetSharedAllocationSize = &GetSharedAllocationSize;
+
+		exports.CreateBuffer = &CreateBuffer;
+		exports.CreateSharedBuffer = &CreateSharedBuffer;
+		exports.AcquireBuffer = &AcquireBuffer;
+		exports.ReleaseBuffer = &ReleaseBuffer;
+
+		exports.ReserveSharedMutex = &ReserveSharedMutex;
+		exports.TryLockSharedMutex = &TryLockSharedMutex;
+		exports.LockSharedMutex = &LockSharedMutex;
+		exports.UnlockSharedMutex = &UnlockSharedMutex;
+		exports.ReserveSharedRwLock = &ReserveSharedRwLock;
+		exports.TryLockSharedRead = &TryLockSharedRead;
+		exports.LockSharedRead = &LockSharedRead;
+		exports.UnlockSharedRead = &UnlockSharedRead;
+		exports.TryLockSharedWrite = &TryLockSharedWrite;
+		exports.LockSharedWrite = &LockSharedWrite;
+		exports.UnlockSharedWrite = &UnlockSharedWrite;
+
+		exports.InvalidateResultCache = &InvalidateResultCache;
+
+		exports.AllocateHandles = &AllocateHandles;
+		exports.ReleaseHandles = &ReleaseHandles;
+		exports.ResolveHandle = &ResolveHandle;
+		exports.GetHandleAddress = &GetHandleAddress;
+
+		return exports;
+	}
+
+	static const NativeExports s_NativeExports = CreateNativeExports();
+
+	const NativeExports* GetNativeExports()
+	{
+		return &s_NativeExports;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+#include "NetCore/Api/BenchmarkApi.hpp"
+#include "NetCore/Api/BufferApi.hpp"
+#include "NetCore/Api/CacheApi.hpp"
+#include "NetCore/Api/DirtyBitmapApi.hpp"
+#include "NetCore/Api/DoorbellApi.hpp"
+#include "NetCore/Api/ExampleApi.hpp"
+#include "NetCore/Api/HandleApi.hpp"
+#include "NetCore/Api/ScratchApi.hpp"
+#include "NetCore/Api/SharedLockApi.hpp"
+#include "NetCore/Api/SlabApi.hpp"
+#include "NetCore/Api/TextApi.hpp"
+
+// Bump on every change to NativeExports, which is append-only:
+// managed code built against an older version keeps reading its own prefix
+#define INTEROP_NATIVE_EXPORTS_VERSION 11
+
+namespace Interop::NetCore::Api
+{
+
+	typedef void (INTEROP_DELEGATE_CALLTYPE* PrintHostedObjPropertiesFn)(void* obj);
+	typedef void (INTEROP_DELEGATE_CALLTYPE* ProcessCustomObjectFn)(void* obj, ParseCustomObjectFn callback);
+	typedef void (INTEROP_DELEGATE_CALLTYPE* BenchmarkNoopFn)(void* obj);
+
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* AllocateHandlesFn)(const Handles::HandleTarget* targets, u32 count, Handles::Handle* handles);
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* ReleaseHandlesFn)(const Handles::Handle* handles, u32 count);
+	typedef intptr_t (INTEROP_DELEGATE_CALLTYPE* ResolveHandleFn)(Handles::Handle handle);
+	typedef void* (INTEROP_DELEGATE_CALLTYPE* GetHandleAddressFn)(Handles::Handle handle);
+	typedef void (INTEROP_DELEGATE_CALLTYPE* SetHandleReleaseCallbackFn)(Handles::ReleaseCallbackFn callback);
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* AllocateCompactHandlesFn)(const Handles::HandleTarget* targets, u32 count, Handles::CompactHandle* handles);
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* ReleaseCompactHandlesFn)(const Handles::CompactHandle* handles, u32 count);
+	typedef intptr_t (INTEROP_DELEGATE_CALLTYPE* ResolveCompactHandleFn)(Handles::CompactHandle handle);
+	typedef void* (INTEROP_DELEGATE_CALLTYPE* GetCompactHandleAddressFn)(Handles::CompactHandle handle);
+
+	typedef Memory::Doorbell* (INTEROP_DELEGATE_CALLTYPE* ReserveDoorbellFn)(u8 eventFd);
+	typedef void (INTEROP_DELEGATE_CALLTYPE* RingDoorbellFn)(Memory::Doorbell* doorbell);
+	typedef u8 (INTEROP_DELEGATE_CALLTYPE* WaitDoorbellFn)(Memory::Doorbell* doorbell, u32 observed, u32 timeout);
+
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* GetTextLengthFn)(const char* text, u32 capacity);
+	typedef u8 (INTEROP_DELEGATE_CALLTYPE* ValidateUtf8TextFn)(const char* text, u32 size);
+	typedef i32 (INTEROP_DELEGATE_CALLTYPE* TranscodeUtf8ToUtf16Fn)(const char* source, u32 size, u16* destination, u32 capacity);
+	typedef i32 (INTEROP_DELEGATE_CALLTYPE* TranscodeUtf16ToUtf8Fn)(const u16* source, u32 size, char* destination, u32 capacity);
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* CopyTextBoundedFn)(char* destination, u32 capacity, const char* source, u32 size);
+
+	typedef void* (INTEROP_DELEGATE_CALLTYPE* AllocateScratchFn)(u32 size, u32 alignment);
+	typedef u64 (INTEROP_DELEGATE_CALLTYPE* GetScratchMarkFn)();
+	typedef void (INTEROP_DELEGATE_CALLTYPE* ResetScratchFn)(u64 mark);
+	typedef void (INTEROP_DELEGATE_CALLTYPE* GetScratchStatsFn)(Scratch::ScratchStats* stats);
+
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* CollectDirtySlotsFn)(u64* words, u32 wordCount, u64* destination);
+
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* SharedAllocFn)(u32 size);
+	typedef void (INTEROP_DELEGATE_CALLTYPE* SharedFreeFn)(u32 offset);
+	typedef void* (INTEROP_DELEGATE_CALLTYPE* ResolveSharedOffsetFn)(u32 offset);
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* GetSharedAllocationSizeFn)(u32 offset);
+
+	typedef Buffers::Buffer* (INTEROP_DELEGATE_CALLTYPE* CreateBufferFn)(u64 size);
+	typedef Buffers::Buffer* (INTEROP_DELEGATE_CALLTYPE* CreateSharedBufferFn)(u32 size);
+	typedef void (INTEROP_DELEGATE_CALLTYPE* AcquireBufferFn)(Buffers::Buffer* buffer);
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* ReleaseBufferFn)(Buffers::Buffer* buffer);
+
+	typedef Memory::SharedMutex* (INTEROP_DELEGATE_CALLTYPE* ReserveSharedMutexFn)();
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* TryLockSharedMutexFn)(Memory::SharedMutex* mutex);
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* LockSharedMutexFn)(Memory::SharedMutex* mutex, u32 timeout);
+	typedef void (INTEROP_DELEGATE_CALLTYPE* UnlockSharedMutexFn)(Memory::SharedMutex* mutex);
+	typedef Memory::SharedRwLock* (INTEROP_DELEGATE_CALLTYPE* ReserveSharedRwLockFn)();
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* TryLockSharedRwLockFn)(Memory::SharedRwLock* lock);
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* LockSharedRwLockFn)(Memory::SharedRwLock* lock, u32 timeout);
+	typedef void (INTEROP_DELEGATE_CALLTYPE* UnlockSharedRwLockFn)(Memory::SharedRwLock* lock);
+
+	typedef u32 (INTEROP_DELEGATE_CALLTYPE* InvalidateResultCacheFn)(const char* name);
+
+	// Every INTEROP_C_API export, handed to the managed bootstrap by Controller::OpenContext
+	// so that managed code calls native code through raw function pointers
+	struct NativeExports
+	{
+		u32 Version = INTEROP_NATIVE_EXPORTS_VERSION;
+		u32 Size = sizeof(NativeExports);
+
+		PrintHostedObjPropertiesFn PrintHostedObjProperties = nullptr;
+		ProcessCustomObjectFn ProcessCustomObject = nullptr;
+		BenchmarkNoopFn BenchmarkNoop = nullptr;
+
+		// Version 2, compact handles superseded by the version 11 exports
+		AllocateCompactHandlesFn AllocateCompactHandles = nullptr;
+		ReleaseCompactHandlesFn ReleaseCompactHandles = nullptr;
+		ResolveCompactHandleFn ResolveCompactHandle = nullptr;
+		GetCompactHandleAddressFn GetCompactHandleAddress = nullptr;
+		SetHandleReleaseCallbackFn SetHandleReleaseCallback = nullptr;
+
+		// Version 3
+		ReserveDoorbellFn ReserveDoorbell = nullptr;
+		RingDoorbellFn RingDoorbell = nullptr;
+		WaitDoorbellFn WaitDoorbell = nullptr;
+
+		// Version 4
+		GetTextLengthFn GetTextLength = nullptr;
+		ValidateUtf8TextFn ValidateUtf8Text = nullptr;
+		TranscodeUtf8ToUtf16Fn TranscodeUtf8ToUtf16 = nullptr;
+		TranscodeUtf16ToUtf8Fn TranscodeUtf16ToUtf8 = nullptr;
+		CopyTextBoundedFn CopyTextBounded = nullptr;
+
+		// Version 5
+		AllocateScratchFn AllocateScratch = nullptr;
+		GetScratchMarkFn GetScratchMark = nullptr;
+		ResetScratchFn ResetScratch = nullptr;
+		GetScratchStatsFn GetScratchStats = nullptr;
+
+		// Version 6
+		CollectDirtySlotsFn CollectDirtySlots = nullptr;
+
+		// Version 7
+		SharedAllocFn SharedAlloc = nullptr;
+		SharedFreeFn SharedFree = nullptr;
+		ResolveSharedOffsetFn ResolveSharedOffset = nullptr;
+		GetSharedAllocationSizeFn GetSharedAllocationSize = nullptr;
+
+		// Version 8
+		CreateBufferFn CreateBuffer = nullptr;
+		CreateSharedBufferFn CreateSharedBuffer = nullptr;
+		AcquireBufferFn AcquireBuffer = nullptr;
+		ReleaseBufferFn ReleaseBuffer = nullptr;
+
+		// Version 9
+		ReserveSharedMutexFn ReserveSharedMutex = nullptr;
+		TryLockSharedMutexFn TryLockSharedMutex = nullptr;
+		LockSharedMutexFn LockSharedMutex = nullptr;
+		UnlockSharedMutexFn UnlockSharedMutex = nullptr;
+		ReserveSharedRwLockFn ReserveSharedRwLock = nullptr;
+		TryLockSharedRwLockFn TryLockSharedRead = nullptr;
+		LockSharedRwLockFn LockSharedRead = nullptr;
+		UnlockSharedRwLockFn UnlockSharedRead = nullptr;
+		TryLockSharedRwLockFn TryLockSharedWrite = nullptr;
+		LockSharedRwLockFn LockSharedWrite = nullptr;
+		UnlockSharedRwLockFn UnlockSharedWrite = nullptr;
+
+		// Version 10
+		InvalidateResultCacheFn InvalidateResultCache = nullptr;
+
+		// Version 11, 64-bit handles
+		AllocateHandlesFn AllocateHandles = nullptr;
+		ReleaseHandlesFn ReleaseHandles = nullptr;
+		ResolveHandleFn ResolveHandle = nullptr;
+		GetHandleAddressFn GetHandleAddress = nullptr;
+	};
+
+	typedef i32 (INTEROP_DELEGATE_CALLTYPE* BootstrapFn)(const NativeExports* exports);
+
+	INTEROP_API const NativeExports* GetNativeExports();
+
+}
\ No newline at end of file
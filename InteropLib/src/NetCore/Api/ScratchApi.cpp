@@ -0,0 +1,29 @@
+#include "Core/Definitions.hpp"
+#include "Core/ScratchArena.hpp"
+
+#include "NetCore/Api/ScratchApi.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	void* AllocateScratch(u32 size, u32 alignment)
+	{
+		return Scratch::Allocate(size, alignment);
+	}
+
+	u64 GetScratchMark()
+	{
+		return Scratch::GetMark();
+	}
+
+	void ResetScratch(u64 mark)
+	{
+		Scratch::Reset(mark);
+	}
+
+	void GetScratchStats(Scratch::ScratchStats* stats)
+	{
+		Scratch::GetStats(stats);
+	}
+
+}
\ No newline at end of file
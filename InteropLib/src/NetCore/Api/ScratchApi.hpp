@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+#include "Core/ScratchArena.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	INTEROP_C_API void* AllocateScratch(u32 size, u32 alignment);
+	INTEROP_C_API u64 GetScratchMark();
+	INTEROP_C_API void ResetScratch(u64 mark);
+	INTEROP_C_API void GetScratchStats(Scratch::ScratchStats* stats);
+
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "Core/Definitions.hpp"
+#include "Core/SharedLock.hpp"
+
+#include "NetCore/Api/SharedLockApi.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	Memory::SharedMutex* ReserveSharedMutex()
+	{
+		return Memory::ReserveSharedMutex();
+	}
+
+	u32 TryLockSharedMutex(Memory::SharedMutex* mutex)
+	{
+		return Memory::TryLockSharedMutex(mutex);
+	}
+
+	u32 LockSharedMutex(Memory::SharedMutex* mutex, u32 timeout)
+	{
+		return Memory::LockSharedMutex(mutex, timeout);
+	}
+
+	void UnlockSharedMutex(Memory::SharedMutex* mutex)
+	{
+		Memory::UnlockSharedMutex(mutex);
+	}
+
+	Memory::SharedRwLock* ReserveSharedRwLock()
+	{
+		return Memory::ReserveSharedRwLock();
+	}
+
+	u32 TryLockSharedRead(Memory::SharedRwLock* lock)
+	{
+		return Memory::TryLockSharedRead(lock);
+	}
+
+	u32 LockSharedRead(Memory::SharedRwLock* lock, u32 timeout)
+	{
+		return Memory::LockSharedRead(lock, timeout);
+	}
+
+	void UnlockSharedRead(Memory::SharedRwLock* lock)
+	{
+		Memory::UnlockSharedRead(lock);
+	}
+
+	u32 TryLockSharedWrite(Memory::SharedRwLock* lock)
+	{
+		return Memory::TryLockSharedWrite(lock);
+	}
+
+	u32 LockSharedWrite(Memory::SharedRwLock* lock, u32 timeout)
+	{
+		return Memory::LockSharedWrite(lock, timeout);
+	}
+
+	void UnlockSharedWrite(Memory::SharedRwLock* lock)
+	{
+		Memory::UnlockSharedWrite(lock);
+	}
+
+}
\ No newline at end of file
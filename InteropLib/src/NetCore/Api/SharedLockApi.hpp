@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+#include "Core/SharedLock.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	INTEROP_C_API Memory::SharedMutex* ReserveSharedMutex();
+	INTEROP_C_API u32 TryLockSharedMutex(Memory::SharedMutex* mutex);
+	INTEROP_C_API u32 LockSharedMutex(Memory::SharedMutex* mutex, u32 timeout);
+	INTEROP_C_API void UnlockSharedMutex(Memory::SharedMutex* mutex);
+
+	INTEROP_C_API Memory::SharedRwLock* ReserveSharedRwLock();
+	INTEROP_C_API u32 TryLockSharedRead(Memory::SharedRwLock* lock);
+	INTEROP_C_API u32 LockSharedRead(Memory::SharedRwLock* lock, u32 timeout);
+	INTEROP_C_API void UnlockSharedRead(Memory::SharedRwLock* lock);
+	INTEROP_C_API u32 TryLockSharedWrite(Memory::SharedRwLock* lock);
+	INTEROP_C_API u32 LockSharedWrite(Memory::SharedRwLock* lock, u32 timeout);
+	INTEROP_C_API void UnlockSharedWrite(Memory::SharedRwLock* lock);
+
+}
\ No newline at end of file
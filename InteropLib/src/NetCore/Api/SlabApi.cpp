@@ -0,0 +1,30 @@
+#include "Core/Definitions.hpp"
+#include "Core/SlabAllocator.hpp"
+
+#include "NetCore/Api/SlabApi.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	u32 SharedAlloc(u32 size)
+	{
+		return Memory::Alloc(size);
+	}
+
+	void SharedFree(u32 offset)
+	{
+		Memory::Free(offset);
+	}
+
+	void* ResolveSharedOffset(u32 offset)
+	{
+		return Memory::Resolve(offset);
+	}
+
+	u32 GetSharedAllocationSize(u32 offset)
+	{
+		Memory::SlabHeap* heap = Memory::State::s_Instance != nullptr ? Memory::State::s_Instance->Slabs : nullptr;
+		return heap != nullptr ? Memory::GetSlabSize(heap, offset) : 0;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	INTEROP_C_API u32 SharedAlloc(u32 size);
+	INTEROP_C_API void SharedFree(u32 offset);
+	INTEROP_C_API void* ResolveSharedOffset(u32 offset);
+	INTEROP_C_API u32 GetSharedAllocationSize(u32 offset);
+
+}
\ No newline at end of file
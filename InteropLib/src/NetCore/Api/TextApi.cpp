@@ -0,0 +1,36 @@
+#include "Core/Definitions.hpp"
+#include "Core/Text.hpp"
+
+#include "NetCore/Api/TextApi.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	u32 GetTextLength(const char* text, u32 capacity)
+	{
+		return Text::Length(text, capacity);
+	}
+
+	u8 ValidateUtf8Text(const char* text, u32 size)
+	{
+		return Text::ValidateUtf8(text, size) ? 1 : 0;
+	}
+
+	i32 TranscodeUtf8ToUtf16(const char* source, u32 size, u16* destination, u32 capacity)
+	{
+		u32 written = 0;
+		return Text::Utf8ToUtf16(source, size, destination, capacity, &written) ? static_cast<i32>(written) : -1;
+	}
+
+	i32 TranscodeUtf16ToUtf8(const u16* source, u32 size, char* destination, u32 capacity)
+	{
+		u32 written = 0;
+		return Text::Utf16ToUtf8(source, size, destination, capacity, &written) ? static_cast<i32>(written) : -1;
+	}
+
+	u32 CopyTextBounded(char* destination, u32 capacity, const char* source, u32 size)
+	{
+		return Text::CopyBounded(destination, capacity, source, size);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+namespace Interop::NetCore::Api
+{
+
+	INTEROP_C_API u32 GetTextLength(const char* text, u32 capacity);
+	INTEROP_C_API u8 ValidateUtf8Text(const char* text, u32 size);
+	INTEROP_C_API i32 TranscodeUtf8ToUtf16(const char* source, u32 size, u16* destination, u32 capacity);
+	INTEROP_C_API i32 TranscodeUtf16ToUtf8(const u16* source, u32 size, char* destination, u32 capacity);
+	INTEROP_C_API u32 CopyTextBounded(char* destination, u32 capacity, const char* source, u32 size);
+
+}
\ No newline at end of file
@@ -7,6 +7,15 @@ namespace Interop::NetCore
 	{
 		void* Context = nullptr;
 		void* LoadFunctionPointer = nullptr;
+
+		// Set once the assemblies of a bundle are loaded, they live in the default load context
+		// and their functions are bound by type name rather than by assembly path
+		void* GetFunctionPointer = nullptr;
+
+		// Managed GC region entry points, bound on first use
+		void* EnterGcRegion = nullptr;
+		void* ExitGcRegion = nullptr;
+		void* GetGcStats = nullptr;
 	};
 
 }
\ No newline at end of file
@@ -1,12 +1,20 @@
+#include "Core/AssemblyBundle.hpp"
 #include "Core/Definitions.hpp"
 #include "Core/DynamicLibrary.hpp"
 #include "Core/HostedAssembly.hpp"
+#include "Core/Log.hpp"
 #include "Core/Memory.hpp"
+#include "Core/Stats.hpp"
+#include "Core/Trace.hpp"
 
 #include "NetCore/NetCoreContext.hpp"
 #include "NetCore/NetCoreController.hpp"
+#include "NetCore/NetCoreGcRegion.hpp"
+#include "NetCore/NetCorePrewarm.hpp"
 #include "NetCore/NetCoreVersion.hpp"
 
+#include "NetCore/Api/NativeExports.hpp"
+
 #include "Platform/Platform.hpp"
 
 #include <hostfxr.h>
@@ -23,6 +31,26 @@
 #define INTEROP_PATH_DELIMITER ";"
 #endif
 
+// Directory containing the hostfxr library to load instead of the one from the .NET installation
+#define INTEROP_HOSTFXR_PATH_ENV "INTEROP_HOSTFXR_PATH"
+
+// Managed bootstrap receiving the native exports, looked up as "<Assembly>.Native.Bootstrap"
+#define INTEROP_BOOTSTRAP_CLASS_SUFFIX ".Native.Bootstrap"
+#define INTEROP_BOOTSTRAP_METHOD_NAME "Initialize"
+
+// Managed pre-warm entry point, looked up as "<Assembly>.Native.Prewarm"
+#define INTEROP_PREWARM_CLASS_SUFFIX ".Native.Prewarm"
+#define INTEROP_PREWARM_METHOD_NAME "Start"
+
+// Longest wait (ms) for a running pre-warm when its context opens or closes
+#define INTEROP_PREWARM_RESET_TIMEOUT 5000
+
+// Managed GC region entry points, looked up as "<Assembly>.Native.GcRegion"
+#define INTEROP_GC_REGION_CLASS_SUFFIX ".Native.GcRegion"
+#define INTEROP_GC_REGION_ENTER_METHOD_NAME "Enter"
+#define INTEROP_GC_REGION_EXIT_METHOD_NAME "Exit"
+#define INTEROP_GC_REGION_STATS_METHOD_NAME "GetStats"
+
 #define INTEROP_HOSTFXR_INIT_FN_NAME "hostfxr_initialize_for_runtime_config"
 #define INTEROP_HOSTFXR_GET_DELEGATE_FN_NAME "hostfxr_get_runtime_delegate"
 #define INTEROP_HOSTFXR_CLOSE_FN_NAME "hostfxr_close"
@@ -33,6 +61,27 @@ namespace Interop::NetCore
 	b8 LoadHostfxr(DynamicLibrary* hostfxr, const char* version);
 	b8 ValidateHostfxrPath(const char* path, NetCoreVersion& version);
 
+	// Static rather than owned by the controller: the managed thread may still report progress once it is gone
+	static PrewarmStatus s_PrewarmStatus;
+
+	// Forgets the pre-warm of the previous context, so that the next one does not report it. A pre-warm still
+	// running is waited for first, its managed thread keeps writing to the status until it is done.
+	static void ResetPrewarmStatus()
+	{
+		u32 observed = Memory::ReadDoorbell(&s_PrewarmStatus.Completed);
+
+		if (s_PrewarmStatus.State.load(std::memory_order_acquire) == INTEROP_PREWARM_STATE_RUNNING
+			&& !Memory::WaitDoorbell(&s_PrewarmStatus.Completed, observed, INTEROP_PREWARM_RESET_TIMEOUT))
+		{
+			INTEROP_LOG_WARNING("A pre-warm is still running, the next one cannot start until it is done");
+			return;
+		}
+
+		s_PrewarmStatus.State.store(INTEROP_PREWARM_STATE_IDLE, std::memory_order_release);
+		s_PrewarmStatus.Prepared.store(0, std::memory_order_relaxed);
+		s_PrewarmStatus.Failed.store(0, std::memory_order_relaxed);
+	}
+
 	Controller::Controller(const char* version) : m_TargetVersion(version)
 	{
 		m_Hostfxr = new DynamicLibrary("hostfxr");
@@ -45,6 +94,11 @@ namespace Interop::NetCore
 
 	void Controller::Destroy()
 	{
+		if (m_WorkerFarm != nullptr)
+		{
+			StopWorkers();
+		}
+
 		if (m_Hostfxr != nullptr)
 		{
 			delete m_Hostfxr;
@@ -55,6 +109,9 @@ namespace Interop::NetCore
 		{
 			Memory::Destroy(&m_MemoryState);
 			m_MemoryState = nullptr;
+
+			m_WorkerRegion = nullptr;
+			m_WorkerRegionSize = 0;
 		}
 	}
 
@@ -62,7 +119,7 @@ namespace Interop::NetCore
 	{
 		if (!LoadHostfxr(m_Hostfxr, m_TargetVersion))
 		{
-			printf("%s\n", "Unable to load hostfxr. Please check or repair your .NET installation.");
+			INTEROP_LOG_ERROR("Unable to load hostfxr. Please check or repair your .NET installation.");
 			return false;
 		}
 
@@ -72,17 +129,20 @@ namespace Interop::NetCore
 
 		if (!success)
 		{
-			printf("%s\n", "Unable to load the necessary function pointers from hostfxr");
+			INTEROP_LOG_ERROR("Unable to load the necessary function pointers from hostfxr");
 			Destroy();
 
 			return false;
 		}
 
-		success = Memory::Init(&m_MemoryState);
+		// Before the shared memory, so that its blocks and reservations are counted in the mapped page
+		Stats::Open();
+
+		success = Memory::Init(&m_MemoryState, m_PersistentMemoryPath, m_SharedMemorySize != 0 ? m_SharedMemorySize : INTEROP_MEMORY_DEFAULT_SIZE);
 
 		if (!success)
 		{
-			printf("%s\n", "Unable to init the necessary shared memory system");
+			INTEROP_LOG_ERROR("Unable to init the necessary shared memory system");
 			Destroy();
 
 			return false;
@@ -91,11 +151,54 @@ namespace Interop::NetCore
 		return true;
 	}
 
+	void Controller::SetPersistentMemory(const char* path)
+	{
+		if (m_MemoryState != nullptr)
+		{
+			INTEROP_LOG_WARNING("Shared memory is already initialized, persistence only applies to the next Init");
+		}
+
+		m_PersistentMemoryPath = path;
+	}
+
+	void Controller::SetSharedMemorySize(u32 size)
+	{
+		if (m_MemoryState != nullptr)
+		{
+			INTEROP_LOG_WARNING("Shared memory is already initialized, its size only applies to the next Init");
+		}
+
+		m_SharedMemorySize = size;
+	}
+
+	void Controller::SetAssemblyBundle(const char* path)
+	{
+		if (m_CurrentContext != nullptr)
+		{
+			INTEROP_LOG_WARNING("The .NET context is already open, the assembly bundle only applies to the next OpenContext");
+		}
+
+		m_AssemblyBundlePath = path;
+	}
+
+	b8 Controller::CheckpointMemory() const
+	{
+		if (m_MemoryState == nullptr || m_PersistentMemoryPath == nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to checkpoint shared memory, persistence has not been enabled");
+			return false;
+		}
+
+		return Memory::Checkpoint();
+	}
+
 	b8 Controller::OpenContext(HostedAssembly* assembly)
 	{
+		INTEROP_TRACE_SCOPE("OpenContext", "bind");
+
 		if (assembly == nullptr) [[unlikely]]
 		{
-			printf("%s\n", "Unable to open a .NET context, no assembly specified");
+			INTEROP_LOG_ERROR("Unable to open a .NET context, no assembly specified");
 			return false;
 		}
 
@@ -105,22 +208,26 @@ namespace Interop::NetCore
 			{
 				if (m_CurrentContext->LoadFunctionPointer != nullptr)
 				{
-					printf("%s\n", ".NET context already initialized");
+					INTEROP_LOG_WARNING(".NET context already initialized");
 					return true;
 				}
 
-				printf("%s\n", "Invalid .NET context, please close it fully before reusing it");
+				INTEROP_LOG_ERROR("Invalid .NET context, please close it fully before reusing it");
 				return false;
 			}
 		}
 
+		ResetPrewarmStatus();
+
 		m_CurrentContext = new NetCoreContext();
 
 		if (m_Hostfxr->Binaries == nullptr || m_Hostfxr->Functions.empty()) [[unlikely]]
 		{
-			printf("%s\n", "Unable to open a .NET context, hostfxr has not been initialized");
+			INTEROP_LOG_ERROR("Unable to open a .NET context, hostfxr has not been initialized");
 			delete m_CurrentContext;
 
+			m_CurrentContext = nullptr;
+
 			return false;
 		}
 
@@ -135,11 +242,13 @@ namespace Interop::NetCore
 
 		if (result != 0)
 		{
-			printf("Unable to load or parse .NET runtime configuration file (Path: \"%s\")\n", runtimeCfgPath.c_str());
+			INTEROP_LOG_ERROR("Unable to load or parse .NET runtime configuration file (Path: \"%s\")", runtimeCfgPath.c_str());
 
 			close(m_CurrentContext->Context);
 			delete m_CurrentContext;
 
+			m_CurrentContext = nullptr;
+
 			return false;
 		}
 
@@ -148,11 +257,130 @@ namespace Interop::NetCore
 
 		if (result != 0)
 		{
-			printf("%s\n", "Unable to load function to fetch C# methods. Aborting.");
+			INTEROP_LOG_ERROR("Unable to load function to fetch C# methods. Aborting.");
 
 			close(m_CurrentContext->Context);
 			delete m_CurrentContext;
 
+			m_CurrentContext = nullptr;
+
+			return false;
+		}
+
+		if (m_AssemblyBundlePath != nullptr && !LoadBundle())
+		{
+			close(m_CurrentContext->Context);
+			delete m_CurrentContext;
+
+			m_CurrentContext = nullptr;
+
+			return false;
+		}
+
+		if (!RunBootstrap(assembly))
+		{
+			close(m_CurrentContext->Context);
+			delete m_CurrentContext;
+
+			m_CurrentContext = nullptr;
+
+			return false;
+		}
+
+		return true;
+	}
+
+	b8 Controller::LoadBundle() const
+	{
+		INTEROP_TRACE_SCOPE("LoadBundle", "bind");
+
+		const auto getRuntimeDelegate = (hostfxr_get_runtime_delegate_fn)m_Hostfxr->Functions[INTEROP_HOSTFXR_GET_DELEGATE_FN_NAME];
+
+		void* loadAssemblyBytes = nullptr;
+		void* getFunctionPointer = nullptr;
+
+		i32 result = getRuntimeDelegate(m_CurrentContext->Context, hdt_load_assembly_bytes, &loadAssemblyBytes);
+		if (result == 0) result = getRuntimeDelegate(m_CurrentContext->Context, hdt_get_function_pointer, &getFunctionPointer);
+
+		if (result != 0)
+		{
+			INTEROP_LOG_ERROR("Unable to load assemblies from memory, the .NET runtime does not support it (.NET 8 or later is required)");
+			return false;
+		}
+
+		AssemblyBundle bundle(m_AssemblyBundlePath);
+		if (!bundle.Open()) return false;
+
+		// The runtime copies each image, the bundle can be unmapped as soon as they are all loaded
+		for (const BundleEntry& entry : bundle.Entries)
+		{
+			result = ((load_assembly_bytes_fn)loadAssemblyBytes)(entry.Image, entry.ImageSize, entry.Symbols, entry.SymbolsSize, nullptr, nullptr);
+
+			if (result != 0)
+			{
+				INTEROP_LOG_ERROR("Unable to load .NET assembly \"%s\" from bundle \"%s\" (error: 0x%08x)", entry.Name, m_AssemblyBundlePath, static_cast<u32>(result));
+				return false;
+			}
+		}
+
+		m_CurrentContext->GetFunctionPointer = getFunctionPointer;
+
+		return true;
+	}
+
+	b8 Controller::BindFunction(const char* name, const char* classPath, HostedAssembly* assembly, void** fn) const
+	{
+		std::string qualifiedType = std::string(classPath);
+		qualifiedType += ", ";
+		qualifiedType += assembly->Name;
+
+		if (m_CurrentContext->GetFunctionPointer != nullptr)
+		{
+			return ((get_function_pointer_fn)m_CurrentContext->GetFunctionPointer)
+			(
+				qualifiedType.c_str(),
+				name,
+				UNMANAGEDCALLERSONLY_METHOD,
+				nullptr,
+				nullptr,
+				fn
+			) == 0;
+		}
+
+		std::string assemblyPath = std::string(assembly->Path);
+		assemblyPath += assembly->Name;
+		assemblyPath += ".dll";
+
+		return ((load_assembly_and_get_function_pointer_fn)m_CurrentContext->LoadFunctionPointer)
+		(
+			assemblyPath.c_str(),
+			qualifiedType.c_str(),
+			name,
+			UNMANAGEDCALLERSONLY_METHOD,
+			nullptr,
+			fn
+		) == 0;
+	}
+
+	b8 Controller::RunBootstrap(HostedAssembly* assembly) const
+	{
+		std::string bootstrapClass = std::string(assembly->Name);
+		bootstrapClass += INTEROP_BOOTSTRAP_CLASS_SUFFIX;
+
+		void* fn = nullptr;
+
+		if (!BindFunction(INTEROP_BOOTSTRAP_METHOD_NAME, bootstrapClass.c_str(), assembly, &fn))
+		{
+			INTEROP_LOG_INFO("No bootstrap found in .NET assembly \"%s\", native exports will not be available to managed code", assembly->Name);
+			return true;
+		}
+
+		Stats::Add(Stats::GetPage()->ControllerCalls, 1);
+		i32 result = ((Api::BootstrapFn)fn)(Api::GetNativeExports());
+
+		if (result != 0)
+		{
+			INTEROP_LOG_ERROR("The bootstrap of .NET assembly \"%s\" rejected the native exports (version: %u, error: %d)", assembly->Name, INTEROP_NATIVE_EXPORTS_VERSION, result);
 			return false;
 		}
 
@@ -163,21 +391,25 @@ namespace Interop::NetCore
 	{
 		if (m_CurrentContext == nullptr) [[unlikely]]
 		{
-			printf("%s\n", "The .NET context is already closed");
+			INTEROP_LOG_WARNING("The .NET context is already closed");
 			return true;
 		}
 
 		if (m_Hostfxr->Binaries == nullptr || m_Hostfxr->Functions.empty()) [[unlikely]]
 		{
-			printf("%s\n", "Unable to open a .NET context, hostfxr has not been initialized");
+			INTEROP_LOG_ERROR("Unable to open a .NET context, hostfxr has not been initialized");
 			return false;
 		}
 
+		ResetPrewarmStatus();
+
 		const auto close = (hostfxr_close_fn)m_Hostfxr->Functions[INTEROP_HOSTFXR_CLOSE_FN_NAME];
 
 		close(m_CurrentContext->Context);
 		delete m_CurrentContext;
 
+		m_CurrentContext = nullptr;
+
 		return true;
 	}
 
@@ -185,62 +417,217 @@ namespace Interop::NetCore
 	{
 		if (name == nullptr) [[unlikely]]
 		{
-			printf("%s\n", "Unable to load function pointer from .NET assembly, no function name provided.");
+			INTEROP_LOG_ERROR("Unable to load function pointer from .NET assembly, no function name provided.");
 			return false;
 		}
 
 		if (classPath == nullptr) [[unlikely]]
 		{
-			printf("Unable to load function \"%s\" from .NET assembly, no class path specified\n", name);
+			INTEROP_LOG_ERROR("Unable to load function \"%s\" from .NET assembly, no class path specified", name);
 			return false;
 		}
 
 		if (assembly == nullptr) [[unlikely]]
 		{
-			printf("Unable to load function \"%s\" from .NET assembly, the HostedAssembly object has not been initialized\n", name);
+			INTEROP_LOG_ERROR("Unable to load function \"%s\" from .NET assembly, the HostedAssembly object has not been initialized", name);
 			return false;
 		}
 
 		if (assembly->Functions.find(name) != assembly->Functions.end())
 		{
-			printf("Function \"%s\" already loaded for .NET assembly \"%s\"\n", name, assembly->Name);
+			INTEROP_LOG_WARNING("Function \"%s\" already loaded for .NET assembly \"%s\"", name, assembly->Name);
 			return true;
 		}
 
 		if (m_CurrentContext == nullptr)
 		{
-			printf("%s\n", ".NET context close, please open it before trying to load functions");
+			INTEROP_LOG_ERROR(".NET context close, please open it before trying to load functions");
 			return false;
 		}
 
-		std::string assemblyPath = std::string(assembly->Path);
-		assemblyPath += assembly->Name;
-		assemblyPath += ".dll";
+		INTEROP_TRACE_SCOPE(name, "bind");
 
-		std::string qualifiedType = std::string(classPath);
-		qualifiedType += ", ";
-		qualifiedType += assembly->Name;
+		void* fn = nullptr;
+		if (!BindFunction(name, classPath, assembly, &fn)) return false;
+
+		assembly->Functions[name] = fn;
+		assembly->BoundMethods[name] = std::string(classPath) + "." + name;
+		assembly->FunctionStats[name] = Stats::RegisterFunction(classPath, name);
+
+		return true;
+	}
+
+	b8 Controller::StartPrewarm(HostedAssembly* assembly, const char* const* callees, u32 calleeCount) const
+	{
+		if (assembly == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to pre-warm .NET assembly, the HostedAssembly object has not been initialized");
+			return false;
+		}
+
+		if (m_CurrentContext == nullptr)
+		{
+			INTEROP_LOG_ERROR(".NET context closed, please open it before pre-warming assembly \"%s\"", assembly->Name);
+			return false;
+		}
+
+		if (s_PrewarmStatus.State.exchange(INTEROP_PREWARM_STATE_RUNNING, std::memory_order_acq_rel) == INTEROP_PREWARM_STATE_RUNNING)
+		{
+			INTEROP_LOG_WARNING("A pre-warm is already running");
+			return true;
+		}
+
+		INTEROP_TRACE_SCOPE("StartPrewarm", "bind");
+
+		std::string classPath = std::string(assembly->Name);
+		classPath += INTEROP_PREWARM_CLASS_SUFFIX;
 
 		void* fn = nullptr;
-		i32 result = ((load_assembly_and_get_function_pointer_fn)m_CurrentContext->LoadFunctionPointer)
-		(
-			assemblyPath.c_str(),
-			qualifiedType.c_str(),
-			name,
-			UNMANAGEDCALLERSONLY_METHOD,
-			nullptr,
-			&fn
-		);
 
-		if (result != 0) return false;
+		if (!BindFunction(INTEROP_PREWARM_METHOD_NAME, classPath.c_str(), assembly, &fn))
+		{
+			INTEROP_LOG_ERROR("Unable to pre-warm .NET assembly \"%s\", it has no pre-warm entry point", assembly->Name);
+			s_PrewarmStatus.State.store(INTEROP_PREWARM_STATE_IDLE, std::memory_order_release);
 
-		assembly->Functions[name] = fn;
+			return false;
+		}
+
+		std::vector<const char*> methods;
+		methods.reserve(assembly->BoundMethods.size() + calleeCount);
+
+		for (const auto& [name, method] : assembly->BoundMethods)
+			methods.push_back(method.c_str());
+
+		for (u32 i = 0; i < calleeCount; i++)
+			methods.push_back(callees[i]);
+
+		s_PrewarmStatus.Prepared.store(0, std::memory_order_relaxed);
+		s_PrewarmStatus.Failed.store(0, std::memory_order_relaxed);
+
+		PrewarmRequest request = { methods.data(), static_cast<u32>(methods.size()), 0, &s_PrewarmStatus };
+
+		Stats::Add(Stats::GetPage()->ControllerCalls, 1);
+
+		if (((PrewarmFn)fn)(&request) != 0)
+		{
+			INTEROP_LOG_ERROR("The pre-warm entry point of .NET assembly \"%s\" rejected the request", assembly->Name);
+			s_PrewarmStatus.State.store(INTEROP_PREWARM_STATE_IDLE, std::memory_order_release);
+
+			return false;
+		}
 
 		return true;
 	}
 
+	b8 Controller::WaitPrewarm(u32 timeout, u32* failed) const
+	{
+		u32 observed = Memory::ReadDoorbell(&s_PrewarmStatus.Completed);
+		u32 state = s_PrewarmStatus.State.load(std::memory_order_acquire);
+
+		if (state == INTEROP_PREWARM_STATE_RUNNING && Memory::WaitDoorbell(&s_PrewarmStatus.Completed, observed, timeout))
+			state = s_PrewarmStatus.State.load(std::memory_order_acquire);
+
+		if (failed != nullptr)
+			*failed = s_PrewarmStatus.Failed.load(std::memory_order_relaxed);
+
+		return state == INTEROP_PREWARM_STATE_DONE;
+	}
+
+	b8 Controller::BindGcRegion(HostedAssembly* assembly) const
+	{
+		if (assembly == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to control the .NET GC, the HostedAssembly object has not been initialized");
+			return false;
+		}
+
+		if (m_CurrentContext == nullptr)
+		{
+			INTEROP_LOG_ERROR(".NET context closed, please open it before controlling the GC");
+			return false;
+		}
+
+		if (m_CurrentContext->GetGcStats != nullptr) return true;
+
+		INTEROP_TRACE_SCOPE("BindGcRegion", "bind");
+
+		std::string classPath = std::string(assembly->Name);
+		classPath += INTEROP_GC_REGION_CLASS_SUFFIX;
+
+		void* enter = nullptr;
+		void* exit = nullptr;
+		void* stats = nullptr;
+
+		if (!BindFunction(INTEROP_GC_REGION_ENTER_METHOD_NAME, classPath.c_str(), assembly, &enter)
+			|| !BindFunction(INTEROP_GC_REGION_EXIT_METHOD_NAME, classPath.c_str(), assembly, &exit)
+			|| !BindFunction(INTEROP_GC_REGION_STATS_METHOD_NAME, classPath.c_str(), assembly, &stats))
+		{
+			INTEROP_LOG_ERROR("Unable to control the GC from .NET assembly \"%s\", it has no GC region entry points", assembly->Name);
+			return false;
+		}
+
+		m_CurrentContext->EnterGcRegion = enter;
+		m_CurrentContext->ExitGcRegion = exit;
+		m_CurrentContext->GetGcStats = stats;
+
+		return true;
+	}
+
+	b8 Controller::EnterGcRegion(HostedAssembly* assembly, u64 allocationBudget, GcStats* before, GcLatencyMode fallback) const
+	{
+		if (!BindGcRegion(assembly)) return false;
+
+		GcRegionRequest request = { allocationBudget, fallback, 0, before };
+
+		Stats::Add(Stats::GetPage()->ControllerCalls, 1);
+		i32 result = ((GcRegionFn)m_CurrentContext->EnterGcRegion)(&request);
+
+		if (result != 0)
+		{
+			INTEROP_LOG_ERROR("Unable to enter a GC region of %llu bytes (error: %d)", static_cast<unsigned long long>(allocationBudget), result);
+			return false;
+		}
+
+		return true;
+	}
+
+	GcRegionResult Controller::ExitGcRegion(GcStats* after) const
+	{
+		if (m_CurrentContext == nullptr || m_CurrentContext->ExitGcRegion == nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to exit GC region, none has been entered");
+			return INTEROP_GC_REGION_RESULT_ERROR;
+		}
+
+		GcRegionRequest request = { 0, INTEROP_GC_LATENCY_MODE_NONE, 0, after };
+
+		Stats::Add(Stats::GetPage()->ControllerCalls, 1);
+		i32 result = ((GcRegionFn)m_CurrentContext->ExitGcRegion)(&request);
+
+		if (result < 0)
+		{
+			INTEROP_LOG_ERROR("Unable to exit GC region (error: %d)", result);
+			return INTEROP_GC_REGION_RESULT_ERROR;
+		}
+
+		return result == 0 ? INTEROP_GC_REGION_RESULT_NO_COLLECTION : INTEROP_GC_REGION_RESULT_COLLECTED;
+	}
+
+	b8 Controller::GetGcStats(HostedAssembly* assembly, GcStats* stats) const
+	{
+		if (stats == nullptr || !BindGcRegion(assembly)) return false;
+
+		Stats::Add(Stats::GetPage()->ControllerCalls, 1);
+		return ((GcStatsFn)m_CurrentContext->GetGcStats)(stats) == 0;
+	}
+
 	b8 LoadHostfxr(DynamicLibrary* hostfxr, const char* version)
 	{
+		const char* overridePath = getenv(INTEROP_HOSTFXR_PATH_ENV);
+
+		if (overridePath != nullptr && strlen(overridePath) > 0)
+			return Platform::LoadLibrary("hostfxr", overridePath, hostfxr);
+
 		const char* dotnetRoot = getenv("DOTNET_ROOT");
 		const char* path = getenv("PATH");
 
@@ -305,7 +692,7 @@ namespace Interop::NetCore
 	{
 		if (path == nullptr) [[unlikely]]
 		{
-			printf("%s\n", "Empty path passed to hostfxr resolver - check your PATH environment variable.");
+			INTEROP_LOG_ERROR("Empty path passed to hostfxr resolver - check your PATH environment variable.");
 			return false;
 		}
 
@@ -353,4 +740,18 @@ namespace Interop::NetCore
 #undef INTEROP_HOSTFXR_GET_DELEGATE_FN_NAME
 #undef INTEROP_HOSTFXR_INIT_FN_NAME
 
+#undef INTEROP_HOSTFXR_PATH_ENV
+
+#undef INTEROP_GC_REGION_STATS_METHOD_NAME
+#undef INTEROP_GC_REGION_EXIT_METHOD_NAME
+#undef INTEROP_GC_REGION_ENTER_METHOD_NAME
+#undef INTEROP_GC_REGION_CLASS_SUFFIX
+
+#undef INTEROP_PREWARM_RESET_TIMEOUT
+#undef INTEROP_PREWARM_METHOD_NAME
+#undef INTEROP_PREWARM_CLASS_SUFFIX
+
+#undef INTEROP_BOOTSTRAP_METHOD_NAME
+#undef INTEROP_BOOTSTRAP_CLASS_SUFFIX
+
 #undef INTEROP_PATH_DELIMITER
\ No newline at end of file
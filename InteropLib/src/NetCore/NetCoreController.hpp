@@ -2,6 +2,8 @@
 
 #include "Core/Definitions.hpp"
 
+#include "NetCore/NetCoreGcRegion.hpp"
+
 namespace Interop
 {
 
@@ -14,6 +16,7 @@ namespace Interop::Memory
 {
 
 	struct State;
+	struct QueueItem;
 
 }
 
@@ -21,6 +24,8 @@ namespace Interop::NetCore
 {
 
 	struct NetCoreContext;
+	struct WorkerFarm;
+	struct WorkerFarmDesc;
 
 	class Controller final
 	{
@@ -32,21 +37,70 @@ namespace Interop::NetCore
 
 		INTEROP_API b8 Init();
 
+		// Must be called before Init, keeps the shared memory region in the file provided across restarts
+		INTEROP_API void SetPersistentMemory(const char* path);
+
+		// Must be called before Init, the region holds INTEROP_MEMORY_DEFAULT_SIZE bytes otherwise
+		INTEROP_API void SetSharedMemorySize(u32 size);
+		INTEROP_API b8 CheckpointMemory() const;
+
+		// Must be called before OpenContext, hosted assemblies are then loaded from the bundle rather than from their own files
+		INTEROP_API void SetAssemblyBundle(const char* path);
+
 		INTEROP_API b8 OpenContext(HostedAssembly* assembly);
 		INTEROP_API b8 CloseContext();
 		INTEROP_API b8 LoadAssemblyFunction(const char* name, const char* classPath, HostedAssembly* assembly) const;
 
+		// Opt-in, compiles the functions loaded so far and the callees provided on a managed background thread,
+		// so that their first calls skip the JIT. Callees are "Namespace.Type.Method" or "Namespace.Type.*",
+		// optionally followed by ", Assembly" when they do not belong to the hosted assembly.
+		INTEROP_API b8 StartPrewarm(HostedAssembly* assembly, const char* const* callees = nullptr, u32 calleeCount = 0) const;
+
+		// Returns true once the pre-warm of the current context is done, waiting up to the timeout (ms) for it.
+		// Opening or closing a context forgets it, after waiting for it if it is still running.
+		INTEROP_API b8 WaitPrewarm(u32 timeout, u32* failed = nullptr) const;
+
+		// Starts a latency-critical section: no managed collection happens until ExitGcRegion as long as managed
+		// code allocates less than the budget. When the runtime cannot commit the budget, switches to the fallback
+		// latency mode instead, or fails for INTEROP_GC_LATENCY_MODE_NONE. The latency mode of the stats tells which.
+		INTEROP_API b8 EnterGcRegion(HostedAssembly* assembly, u64 allocationBudget, GcStats* before = nullptr,
+			GcLatencyMode fallback = INTEROP_GC_LATENCY_MODE_SUSTAINED_LOW_LATENCY) const;
+
+		// Ends the section and restores the previous latency mode, tells whether collections happened in it
+		INTEROP_API GcRegionResult ExitGcRegion(GcStats* after = nullptr) const;
+
+		INTEROP_API b8 GetGcStats(HostedAssembly* assembly, GcStats* stats) const;
+
+		INTEROP_API b8 StartWorkers(const WorkerFarmDesc& desc);
+		INTEROP_API b8 SubmitWork(const Memory::QueueItem& item);
+		INTEROP_API u32 MonitorWorkers();
+		INTEROP_API b8 StopWorkers(u32 timeout = 5000);
+
 		Controller& operator=(Controller&) = delete;
 
 	private:
 		DynamicLibrary* m_Hostfxr = nullptr;
 		NetCoreContext* m_CurrentContext = nullptr;
 		Memory::State* m_MemoryState = nullptr;
+		WorkerFarm* m_WorkerFarm = nullptr;
+
+		// Header and queue of the last worker farm, kept for the next one when it could not be unreserved
+		void* m_WorkerRegion = nullptr;
+		u32 m_WorkerRegionSize = 0;
 
 		const char* m_TargetVersion;
+		const char* m_PersistentMemoryPath = nullptr;
+		u32 m_SharedMemorySize = 0; // 0 for INTEROP_MEMORY_DEFAULT_SIZE
+		const char* m_AssemblyBundlePath = nullptr;
 
 		Controller() = default;
 		void Destroy();
+		b8 LoadBundle() const;
+		b8 BindFunction(const char* name, const char* classPath, HostedAssembly* assembly, void** fn) const;
+		b8 RunBootstrap(HostedAssembly* assembly) const;
+		b8 BindGcRegion(HostedAssembly* assembly) const;
+		b8 SpawnWorker(u32 id);
+		void RequeueItem(u32 id);
 	};
 
 }
\ No newline at end of file
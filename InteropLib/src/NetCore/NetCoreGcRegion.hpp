@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+
+namespace Interop::NetCore
+{
+
+	// Values of System.Runtime.GCLatencyMode
+	enum GcLatencyMode : i32
+	{
+		INTEROP_GC_LATENCY_MODE_NONE = -1, // Fallback only: fail rather than switch modes
+		INTEROP_GC_LATENCY_MODE_BATCH = 0,
+		INTEROP_GC_LATENCY_MODE_INTERACTIVE = 1,
+		INTEROP_GC_LATENCY_MODE_LOW_LATENCY = 2,
+		INTEROP_GC_LATENCY_MODE_SUSTAINED_LOW_LATENCY = 3,
+		INTEROP_GC_LATENCY_MODE_NO_GC_REGION = 4,
+	};
+
+	// Outcome of leaving a GC region, the values returned by the managed exit entry point
+	enum GcRegionResult : i32
+	{
+		INTEROP_GC_REGION_RESULT_ERROR = -1, // No region was entered, or leaving it failed
+		INTEROP_GC_REGION_RESULT_NO_COLLECTION = 0,
+		INTEROP_GC_REGION_RESULT_COLLECTED = 1, // The region is over, but collections happened in it
+	};
+
+	// Counters of the managed GC since the runtime started, compare two snapshots to tell what happened in between
+	struct GcStats
+	{
+		u32 Collections[3]; // Per generation, a collection of generation N also counts for the younger ones
+		i32 LatencyMode; // GcLatencyMode
+
+		u64 PauseDuration; // Total time managed threads were suspended by the GC, in nanoseconds
+		u64 AllocatedBytes; // Total allocated on the managed heap, all threads
+	};
+
+	struct GcRegionRequest
+	{
+		u64 AllocationBudget; // Managed bytes the section may allocate without triggering a collection
+		i32 FallbackLatencyMode; // Applied instead when the runtime cannot commit the budget
+		u32 Padding;
+
+		GcStats* Stats; // Snapshot taken once the section is entered or left, may be null
+	};
+
+	// The entry points return 0 on success. Leaving the section returns 1 if collections happened in it.
+	typedef i32 (INTEROP_DELEGATE_CALLTYPE* GcRegionFn)(const GcRegionRequest* request);
+	typedef i32 (INTEROP_DELEGATE_CALLTYPE* GcStatsFn)(GcStats* stats);
+
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+#include "Core/Doorbell.hpp"
+
+#include <atomic>
+
+namespace Interop::NetCore
+{
+
+	enum PrewarmState : u32
+	{
+		INTEROP_PREWARM_STATE_IDLE = 0,
+		INTEROP_PREWARM_STATE_RUNNING = 1,
+		INTEROP_PREWARM_STATE_DONE = 2,
+	};
+
+	// Progress of the pre-warm, updated by the managed background thread
+	struct PrewarmStatus
+	{
+		Memory::Doorbell Completed = { 0, 0, -1, 0 }; // Rung once the state moves to INTEROP_PREWARM_STATE_DONE
+
+		std::atomic<u32> State = INTEROP_PREWARM_STATE_IDLE;
+		std::atomic<u32> Prepared = 0; // Methods compiled
+		std::atomic<u32> Failed = 0; // Methods not found or failing to compile
+		u32 Padding = 0;
+	};
+
+	// Handed to the managed entry point, which copies the method names before returning
+	struct PrewarmRequest
+	{
+		const char* const* Methods; // "Namespace.Type.Method", optionally followed by ", Assembly"
+		u32 MethodCount;
+		u32 Padding;
+
+		PrewarmStatus* Status;
+	};
+
+	typedef i32 (INTEROP_DELEGATE_CALLTYPE* PrewarmFn)(const PrewarmRequest* request);
+
+}
\ No newline at end of file
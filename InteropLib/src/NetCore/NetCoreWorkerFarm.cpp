@@ -0,0 +1,368 @@
+#include "Core/Definitions.hpp"
+#include "Core/Doorbell.hpp"
+#include "Core/Log.hpp"
+#include "Core/Memory.hpp"
+#include "Core/SharedQueue.hpp"
+
+#include "NetCore/NetCoreContext.hpp"
+#include "NetCore/NetCoreController.hpp"
+#include "NetCore/NetCoreWorkerFarm.hpp"
+
+#include "Platform/Platform.hpp"
+
+#include <new>
+
+namespace Interop::NetCore
+{
+
+	struct WorkerFarm
+	{
+		WorkerFarmDesc Desc = {};
+		WorkerFarmHeader* Header = nullptr;
+		Memory::SharedQueue* Queue = nullptr;
+	};
+
+	b8 Controller::StartWorkers(const WorkerFarmDesc& desc)
+	{
+		if (m_WorkerFarm != nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_WARNING("Worker processes have already been started");
+			return false;
+		}
+
+		if (m_MemoryState == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to start worker processes, the controller has not been initialized");
+			return false;
+		}
+
+		if (m_CurrentContext != nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to start worker processes after a .NET context has been opened in the supervisor");
+			return false;
+		}
+
+		if (desc.Main == nullptr || desc.WorkerCount == 0 || desc.WorkerCount > INTEROP_MAX_WORKERS)
+		{
+			INTEROP_LOG_ERROR("Unable to start worker processes, invalid worker function or count (%u, max: %u)", desc.WorkerCount, INTEROP_MAX_WORKERS);
+			return false;
+		}
+
+		if (desc.QueueCapacity < 2 || desc.QueueCapacity > INTEROP_MAX_WORKER_QUEUE_CAPACITY || (desc.QueueCapacity & (desc.QueueCapacity - 1)) != 0)
+		{
+			INTEROP_LOG_ERROR("Unable to start worker processes, the queue capacity (%u) must be a power of 2 between 2 and %u", desc.QueueCapacity, INTEROP_MAX_WORKER_QUEUE_CAPACITY);
+			return false;
+		}
+
+		// Header and queue share one range, so that StopWorkers can give it back at once
+		u32 headerSize = static_cast<u32>(sizeof(WorkerFarmHeader) + (desc.WorkerCount - 1) * sizeof(WorkerSlot));
+		headerSize = (headerSize + 63) & ~63u;
+
+		u32 regionSize = headerSize + Memory::GetQueueSize(desc.QueueCapacity);
+
+		if (m_WorkerRegionSize < regionSize)
+		{
+			void* region = Memory::Reserve(regionSize);
+
+			if (region == nullptr)
+			{
+				INTEROP_LOG_ERROR("Unable to reserve the shared memory required by the worker processes");
+				return false;
+			}
+
+			m_WorkerRegion = region;
+			m_WorkerRegionSize = regionSize;
+		}
+
+		void* headerAddress = m_WorkerRegion;
+		void* queueAddress = static_cast<u8*>(m_WorkerRegion) + headerSize;
+
+		m_WorkerFarm = new WorkerFarm();
+		m_WorkerFarm->Desc = desc;
+		m_WorkerFarm->Queue = Memory::CreateQueue(queueAddress, desc.QueueCapacity);
+		m_WorkerFarm->Header = static_cast<WorkerFarmHeader*>(headerAddress);
+
+		if (m_WorkerFarm->Queue == nullptr)
+		{
+			delete m_WorkerFarm;
+			m_WorkerFarm = nullptr;
+
+			return false;
+		}
+
+		WorkerFarmHeader* header = m_WorkerFarm->Header;
+
+		new (&header->StopRequested) std::atomic<u32>(0);
+		header->WorkerCount = desc.WorkerCount;
+
+		Memory::CreateDoorbell(&header->WorkReady);
+
+		for (u32 i = 0; i < desc.WorkerCount; i++)
+			new (&header->Workers[i]) WorkerSlot();
+
+		b8 success = true;
+
+		for (u32 i = 0; i < desc.WorkerCount && success; i++)
+			success = SpawnWorker(i);
+
+		if (!success)
+		{
+			INTEROP_LOG_WARNING("Unable to start all the worker processes, stopping the ones already running");
+			StopWorkers(0);
+
+			return false;
+		}
+
+		return true;
+	}
+
+	b8 Controller::SubmitWork(const Memory::QueueItem& item)
+	{
+		if (m_WorkerFarm == nullptr) [[unlikely]]
+		{
+			INTEROP_LOG_ERROR("Unable to submit work, no worker processes have been started");
+			return false;
+		}
+
+		if (!Memory::Enqueue(m_WorkerFarm->Queue, item))
+			return false;
+
+		Memory::RingDoorbell(&m_WorkerFarm->Header->WorkReady);
+
+		return true;
+	}
+
+	u32 Controller::MonitorWorkers()
+	{
+		if (m_WorkerFarm == nullptr) [[unlikely]]
+			return 0;
+
+		WorkerFarmHeader* header = m_WorkerFarm->Header;
+		const WorkerFarmDesc& desc = m_WorkerFarm->Desc;
+
+		u64 now = Platform::GetMonotonicTime();
+		u32 alive = 0;
+
+		for (u32 i = 0; i < header->WorkerCount; i++)
+		{
+			WorkerSlot& slot = header->Workers[i];
+
+			if (slot.State.load(std::memory_order_acquire) != INTEROP_WORKER_STATE_RUNNING)
+				continue;
+
+			i32 pid = slot.Pid.load(std::memory_order_relaxed);
+			i32 exitCode = 0;
+
+			Platform::ProcessState state = Platform::PollProcess(pid, &exitCode);
+
+			if (state == Platform::INTEROP_PROCESS_STATE_RUNNING)
+			{
+				// Workers only beat while waiting for work, items are bounded by their own timeout.
+				// Either time may have been stored after `now` was sampled.
+				u64 busySince = slot.BusySince.load(std::memory_order_acquire);
+				u64 heartbeat = slot.Heartbeat.load(std::memory_order_relaxed);
+
+				b8 healthy = busySince != 0
+					? desc.ItemTimeout == 0 || busySince >= now || now - busySince <= desc.ItemTimeout
+					: heartbeat >= now || now - heartbeat <= desc.HeartbeatTimeout;
+
+				if (healthy)
+				{
+					alive++;
+					continue;
+				}
+
+				if (busySince != 0) INTEROP_LOG_WARNING("Worker %u (pid: %d) exceeded the item timeout, killing it", i, pid);
+				else INTEROP_LOG_WARNING("Worker %u (pid: %d) missed its heartbeat, killing it", i, pid);
+
+				Platform::KillProcess(pid);
+				Platform::PollProcess(pid, &exitCode, true);
+
+				// Read again now that the worker is dead, it may have finished the item before the kill
+				if (busySince != 0 && slot.BusySince.load(std::memory_order_acquire) != 0)
+					RequeueItem(i);
+			}
+
+			else
+			{
+				INTEROP_LOG_WARNING("Worker %u (pid: %d) exited with code %d", i, pid, exitCode);
+			}
+
+			if (header->StopRequested.load(std::memory_order_relaxed) != 0)
+			{
+				slot.State.store(INTEROP_WORKER_STATE_STOPPED, std::memory_order_release);
+				continue;
+			}
+
+			if (slot.Restarts.load(std::memory_order_relaxed) >= desc.MaxRestarts)
+			{
+				INTEROP_LOG_ERROR("Worker %u exceeded the maximum number of restarts (%u)", i, desc.MaxRestarts);
+				slot.State.store(INTEROP_WORKER_STATE_FAILED, std::memory_order_release);
+
+				continue;
+			}
+
+			slot.Restarts.fetch_add(1, std::memory_order_relaxed);
+
+			if (SpawnWorker(i))
+				alive++;
+		}
+
+		return alive;
+	}
+
+	void Controller::RequeueItem(u32 id)
+	{
+		WorkerSlot& slot = m_WorkerFarm->Header->Workers[id];
+		const Memory::QueueItem& item = slot.Current;
+
+		slot.BusySince.store(0, std::memory_order_relaxed);
+
+		if (!Memory::Enqueue(m_WorkerFarm->Queue, item))
+		{
+			INTEROP_LOG_ERROR("Unable to requeue the item (type: %u, index: %u) of worker %u, the queue is full", item.Type, item.Index, id);
+			slot.Lost.fetch_add(1, std::memory_order_relaxed);
+
+			return;
+		}
+
+		INTEROP_LOG_WARNING("Requeued the item (type: %u, index: %u) of worker %u", item.Type, item.Index, id);
+		slot.Requeued.fetch_add(1, std::memory_order_relaxed);
+
+		Memory::RingDoorbell(&m_WorkerFarm->Header->WorkReady);
+	}
+
+	b8 Controller::StopWorkers(u32 timeout)
+	{
+		if (m_WorkerFarm == nullptr)
+		{
+			INTEROP_LOG_WARNING("No worker processes to stop");
+			return true;
+		}
+
+		WorkerFarmHeader* header = m_WorkerFarm->Header;
+		header->StopRequested.store(1, std::memory_order_release);
+		Memory::RingDoorbell(&header->WorkReady);
+
+		u64 deadline = Platform::GetMonotonicTime() + timeout;
+		b8 graceful = true;
+
+		for (u32 i = 0; i < header->WorkerCount; i++)
+		{
+			WorkerSlot& slot = header->Workers[i];
+
+			if (slot.State.load(std::memory_order_acquire) != INTEROP_WORKER_STATE_RUNNING)
+				continue;
+
+			i32 pid = slot.Pid.load(std::memory_order_relaxed);
+
+			while (Platform::PollProcess(pid, nullptr) == Platform::INTEROP_PROCESS_STATE_RUNNING)
+			{
+				if (Platform::GetMonotonicTime() >= deadline)
+				{
+					INTEROP_LOG_WARNING("Worker %u (pid: %d) did not stop in time, killing it", i, pid);
+
+					Platform::KillProcess(pid);
+					Platform::PollProcess(pid, nullptr, true);
+					graceful = false;
+
+					break;
+				}
+
+				Platform::SleepFor(1);
+			}
+
+			slot.State.store(INTEROP_WORKER_STATE_STOPPED, std::memory_order_release);
+		}
+
+		// Every worker is gone, nothing refers to the region anymore
+		if (Memory::Unreserve(m_WorkerRegion, m_WorkerRegionSize))
+		{
+			m_WorkerRegion = nullptr;
+			m_WorkerRegionSize = 0;
+		}
+
+		delete m_WorkerFarm;
+		m_WorkerFarm = nullptr;
+
+		return graceful;
+	}
+
+	b8 Controller::SpawnWorker(u32 id)
+	{
+		WorkerSlot& slot = m_WorkerFarm->Header->Workers[id];
+
+		slot.Heartbeat.store(Platform::GetMonotonicTime(), std::memory_order_relaxed);
+		slot.BusySince.store(0, std::memory_order_relaxed);
+		slot.State.store(INTEROP_WORKER_STATE_RUNNING, std::memory_order_release);
+
+		i32 pid = Platform::ForkProcess();
+
+		if (pid == -1)
+		{
+			slot.State.store(INTEROP_WORKER_STATE_FAILED, std::memory_order_release);
+			return false;
+		}
+
+		if (pid == 0)
+		{
+			// Worker process: it owns a copy of this controller, but must never
+			// tear down the shared state of the supervisor
+			Worker worker(id, m_WorkerFarm->Header, m_WorkerFarm->Queue);
+			slot.Pid.store(Platform::GetCurrentProcessId(), std::memory_order_relaxed);
+
+			i32 exitCode = m_WorkerFarm->Desc.Main(this, &worker, m_WorkerFarm->Desc.UserData);
+
+			Log::Flush();
+			Platform::ExitCurrentProcess(exitCode);
+		}
+
+		slot.Pid.store(pid, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	b8 Worker::WaitForWork(Memory::QueueItem* item, u32 timeout)
+	{
+		u64 deadline = Platform::GetMonotonicTime() + timeout;
+		WorkerSlot& slot = m_Header->Workers[Id];
+
+		slot.BusySince.store(0, std::memory_order_relaxed);
+
+		while (!IsStopRequested())
+		{
+			Heartbeat();
+
+			// Read before dequeuing, so that a submission racing with an empty queue still wakes us up
+			u32 observed = Memory::ReadDoorbell(&m_Header->WorkReady);
+
+			if (Memory::Dequeue(m_Queue, item))
+			{
+				slot.Current = *item;
+				slot.BusySince.store(Platform::GetMonotonicTime(), std::memory_order_release);
+				slot.Processed.fetch_add(1, std::memory_order_relaxed);
+
+				return true;
+			}
+
+			u64 now = Platform::GetMonotonicTime();
+			if (now >= deadline) return false;
+
+			u64 wait = deadline - now;
+			Memory::WaitDoorbell(&m_Header->WorkReady, observed, static_cast<u32>(wait < INTEROP_WORKER_MAX_WAIT ? wait : INTEROP_WORKER_MAX_WAIT));
+		}
+
+		return false;
+	}
+
+	void Worker::Heartbeat()
+	{
+		m_Header->Workers[Id].Heartbeat.store(Platform::GetMonotonicTime(), std::memory_order_relaxed);
+	}
+
+	b8 Worker::IsStopRequested() const
+	{
+		return m_Header->StopRequested.load(std::memory_order_acquire) != 0;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Core/Definitions.hpp"
+#include "Core/Doorbell.hpp"
+#include "Core/SharedQueue.hpp"
+
+#include <atomic>
+
+#define INTEROP_MAX_WORKERS 64
+#define INTEROP_MAX_WORKER_QUEUE_CAPACITY (1u << 20)
+
+// Longest a worker sleeps on the work doorbell before refreshing its heartbeat
+#define INTEROP_WORKER_MAX_WAIT 100
+
+namespace Interop::NetCore
+{
+
+	class Controller;
+	class Worker;
+
+	typedef i32 (*WorkerMainFn)(Controller* controller, Worker* worker, void* userData);
+
+	enum WorkerState : u32
+	{
+		INTEROP_WORKER_STATE_STOPPED = 0,
+		INTEROP_WORKER_STATE_RUNNING = 1,
+		INTEROP_WORKER_STATE_FAILED = 2,
+	};
+
+	struct WorkerFarmDesc
+	{
+		u32 WorkerCount = 1;
+		u32 QueueCapacity = 128; // Power of 2, up to INTEROP_MAX_WORKER_QUEUE_CAPACITY
+		u32 HeartbeatTimeout = 5000; // Milliseconds, while waiting for work
+		u32 ItemTimeout = 0; // Milliseconds, while processing an item, 0 for no limit
+		u32 MaxRestarts = 3;
+
+		WorkerMainFn Main = nullptr;
+		void* UserData = nullptr;
+	};
+
+	// Per-worker health record, stored in the shared memory map
+	// so that the supervisor can observe every worker process
+	struct alignas(64) WorkerSlot
+	{
+		std::atomic<u32> State;
+		std::atomic<i32> Pid;
+		std::atomic<u32> Restarts;
+		std::atomic<u64> Heartbeat;
+		std::atomic<u64> BusySince; // Time the current item was dequeued, 0 while waiting for work
+		std::atomic<u64> Processed;
+		std::atomic<u64> Requeued; // Items taken back from this worker after it died or timed out
+		std::atomic<u64> Lost; // Items that could not be requeued, the queue was full
+
+		Memory::QueueItem Current; // Item being processed, published by BusySince
+	};
+
+	struct WorkerFarmHeader
+	{
+		std::atomic<u32> StopRequested;
+		u32 WorkerCount;
+
+		Memory::Doorbell WorkReady; // Rung on every submission and on stop requests
+
+		WorkerSlot Workers[1];
+	};
+
+	class Worker final
+	{
+	public:
+		Worker(u32 id, WorkerFarmHeader* header, Memory::SharedQueue* queue) : Id(id), m_Header(header), m_Queue(queue) {}
+		Worker(Worker&) = delete;
+
+		~Worker() = default;
+
+		const u32 Id;
+
+		INTEROP_API b8 WaitForWork(Memory::QueueItem* item, u32 timeout);
+		INTEROP_API void Heartbeat();
+		INTEROP_API b8 IsStopRequested() const;
+
+		Worker& operator=(Worker&) = delete;
+
+	private:
+		WorkerFarmHeader* m_Header;
+		Memory::SharedQueue* m_Queue;
+	};
+
+}
\ No newline at end of file
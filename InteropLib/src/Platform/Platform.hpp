@@ -19,11 +19,50 @@ namespace Interop::Memory
 namespace Interop::Platform
 {
 
+	enum ProcessState
+	{
+		INTEROP_PROCESS_STATE_RUNNING = 0,
+		INTEROP_PROCESS_STATE_EXITED = 1,
+		INTEROP_PROCESS_STATE_UNKNOWN = 2,
+	};
+
 	b8 LoadLibrary(const char* name, const char* path, DynamicLibrary* library);
 	b8 LoadLibraryFunction(const char* name, DynamicLibrary* library);
 	b8 UnloadLibrary(DynamicLibrary* library);
 
 	b8 OpenOrCreateMemoryMap(Memory::SharedBuffer* memory);
 	b8 CloseMemoryMap(Memory::SharedBuffer* memory);
+	b8 FlushMemoryMap(Memory::SharedBuffer* memory);
+
+	// Persistent maps are opened with Exclusive set when no other process has them open, and other
+	// processes wait in OpenOrCreateMemoryMap until the opener is done (re)initialising the content
+	void EndExclusiveAccess(Memory::SharedBuffer* memory);
+
+	// Maps a whole file read-only and asks the kernel to read it ahead, nullptr on failure
+	const void* MapFile(const char* path, u64* size);
+	void UnmapFile(const void* address, u64 size);
+
+	i32 ForkProcess();
+	ProcessState PollProcess(i32 pid, i32* exitCode, b8 wait = false);
+	b8 KillProcess(i32 pid);
+	i32 GetCurrentProcessId();
+	// 64 bits wide, as thread ids are on macOS
+	u64 GetCurrentThreadId();
+
+	// Whether a thread of any process, identified by GetCurrentThreadId, still runs. Always true where
+	// thread ids of other processes cannot be checked (macOS).
+	b8 IsThreadAlive(u64 threadId);
+	[[noreturn]] void ExitCurrentProcess(i32 exitCode);
+
+	u64 GetMonotonicTime();
+	void SleepFor(u32 milliseconds);
+
+	// Blocks while *address == expected, wakeups may be spurious. Shared between processes when the address is.
+	void FutexWait(u32* address, u32 expected, u32 timeout);
+	void FutexWake(u32* address, u32 count);
+
+	i32 CreateEventFd();
+	b8 SignalEventFd(i32 fd);
+	void CloseEventFd(i32 fd);
 
 }
\ No newline at end of file
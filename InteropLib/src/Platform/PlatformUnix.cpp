@@ -1,4 +1,5 @@
 #include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
 
 #ifdef INTEROP_PLATFORM_UNIX
 
@@ -9,10 +10,24 @@
 
 #include <dlfcn.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <unistd.h>
 
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef INTEROP_PLATFORM_LINUX
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#endif
+
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
 
 #include <vector>
 
@@ -25,6 +40,16 @@
 #define DYNAMIC_LIBRARY_EXTENSION ".so"
 #endif
 
+// Open file description locks belong to the descriptor rather than the process, where the platform has them
+#ifdef F_OFD_SETLK
+#define INTEROP_FILE_LOCK F_OFD_SETLK
+#define INTEROP_FILE_LOCK_WAIT F_OFD_SETLKW
+
+#else
+#define INTEROP_FILE_LOCK F_SETLK
+#define INTEROP_FILE_LOCK_WAIT F_SETLKW
+#endif
+
 namespace Interop::Platform
 {
 
@@ -32,13 +57,13 @@ namespace Interop::Platform
 	{
 		if (library == nullptr) [[unlikely]]
 		{
-			printf("Dynamic Library object not initialized. Aborting load of library \"%s\"\n", name);
+			INTEROP_LOG_ERROR("Dynamic Library object not initialized. Aborting load of library \"%s\"", name);
 			return false;
 		}
 
 		if (library->Binaries != nullptr) [[unlikely]]
 		{
-			printf("Dynamic library \"%s\" already loaded in memory.\n", name);
+			INTEROP_LOG_WARNING("Dynamic library \"%s\" already loaded in memory.", name);
 			return true;
 		}
 
@@ -52,7 +77,7 @@ namespace Interop::Platform
 
 		if (library == nullptr)
 		{
-			printf("Unable to locate library \"%s\" in the specified location (%s), falling back to /usr/local/lib\n", name, assemblyPath.data());
+			INTEROP_LOG_WARNING("Unable to locate library \"%s\" in the specified location (%s), falling back to /usr/local/lib", name, assemblyPath.data());
 
 			assemblyPathLength = strlen("/usr/local/lib/") + strlen(DYNAMIC_LIBRARY_PREFIX) + strlen(name) + strlen(DYNAMIC_LIBRARY_EXTENSION) + 1;
 
@@ -65,7 +90,7 @@ namespace Interop::Platform
 
 		if (library == nullptr)
 		{
-			printf("Unable to locate library \"%s\"", name);
+			INTEROP_LOG_ERROR("Unable to locate library \"%s\"", name);
 			return false;
 		}
 
@@ -79,19 +104,19 @@ namespace Interop::Platform
 	{
 		if (library == nullptr) [[unlikely]]
 		{
-			printf("%s\n", "Unable to unload library function, Dynamic Library object not initialized.");
+			INTEROP_LOG_ERROR("Unable to unload library function, Dynamic Library object not initialized.");
 			return false;
 		}
 
 		if (library->Binaries == nullptr) [[unlikely]]
 		{
-			printf("Unable to unload library \"%s\"\n", library->Name);
+			INTEROP_LOG_ERROR("Unable to unload library \"%s\"", library->Name);
 			return false;
 		}
 
 		if (library->Functions.find(name) != library->Functions.end())
 		{
-			printf("The function pointer for function \"%s\" has already been loaded.\n", name);
+			INTEROP_LOG_WARNING("The function pointer for function \"%s\" has already been loaded.", name);
 			return true;
 		}
 
@@ -99,7 +124,7 @@ namespace Interop::Platform
 
 		if (fnPtr == nullptr)
 		{
-			printf("Unable to load function \"%s\" from library \"%s\"\n", name, library->Name);
+			INTEROP_LOG_ERROR("Unable to load function \"%s\" from library \"%s\"", name, library->Name);
 			return false;
 		}
 
@@ -112,13 +137,13 @@ namespace Interop::Platform
 	{
 		if (library == nullptr) [[unlikely]]
 		{
-			printf("%s\n", "Unable to unload library, DynamicLibrary object not initialized.");
+			INTEROP_LOG_ERROR("Unable to unload library, DynamicLibrary object not initialized.");
 			return false;
 		}
 
 		if (library->Binaries == nullptr) [[unlikely]]
 		{
-			printf("Unable to unload library \"%s\"\n", library->Name);
+			INTEROP_LOG_ERROR("Unable to unload library \"%s\"", library->Name);
 			return false;
 		}
 
@@ -126,7 +151,7 @@ namespace Interop::Platform
 
 		if (result != 0)
 		{
-			printf("Unloading of library \"%s\" failed.\n", library->Name);
+			INTEROP_LOG_ERROR("Unloading of library \"%s\" failed.", library->Name);
 			return false;
 		}
 
@@ -135,17 +160,34 @@ namespace Interop::Platform
 		return true;
 	}
 
+	// Locks the whole backing file of a persistent map. Record locks move between write and read atomically,
+	// whereas flock releases the lock before taking the new one.
+	static b8 LockFile(i32 fd, i16 type, b8 wait)
+	{
+		struct flock lock = {};
+
+		lock.l_type = type;
+		lock.l_whence = SEEK_SET;
+		lock.l_start = 0;
+		lock.l_len = 0; // Up to the end of the file, however large it grows
+
+		i32 result = -1;
+		do result = fcntl(fd, wait ? INTEROP_FILE_LOCK_WAIT : INTEROP_FILE_LOCK, &lock); while (result == -1 && errno == EINTR);
+
+		return result == 0;
+	}
+
 	b8 OpenOrCreateMemoryMap(Memory::SharedBuffer* memory)
 	{
 		if (memory->Name == nullptr) [[unlikely]]
 		{
-			printf("%s\n", "Unable to open or create share memory map, no name has been provided");
+			INTEROP_LOG_ERROR("Unable to open or create share memory map, no name has been provided");
 			return false;
 		}
 
 		if (memory->State == Memory::INTEROP_MEMORY_MAP_STATE_OPEN)
 		{
-			printf("Shared memory map \"%s\" is already open\n", memory->Name);
+			INTEROP_LOG_WARNING("Shared memory map \"%s\" is already open", memory->Name);
 			return true;
 		}
 
@@ -153,66 +195,107 @@ namespace Interop::Platform
 
 		if (memory->Size == 0)
 		{
-			printf("Unable to open or create shared memory map \"%s\" with a size of 0", memory->Name);
+			INTEROP_LOG_ERROR("Unable to open or create shared memory map \"%s\" with a size of 0", memory->Name);
 			return false;
 		}
 
+		if (memory->MappedSize < memory->Size)
+		{
+			memory->MappedSize = memory->Size;
+		}
+
 		std::string name = std::string("/tmp/");
 		name += memory->Name;
 
+		if (memory->Path != nullptr)
+		{
+			name = memory->Path;
+		}
+
 		i32 fd = open(name.c_str(), O_CREAT | O_RDWR, (mode_t)00700);
 
 		if (fd == -1)
 		{
-			printf("Unable to get native handle for shared memory map \"%s\" (size: %d)\n", memory->Name, memory->Size);
+			INTEROP_LOG_ERROR("Unable to get native handle for shared memory map \"%s\" (size: %d)", memory->Name, memory->Size);
 			return false;
 		}
 
 		struct stat mapstat;
-		if (-1 != fstat(fd, &mapstat) && mapstat.st_size == 0)
+		if (-1 != fstat(fd, &mapstat) && mapstat.st_size < memory->MappedSize)
 		{
-			ftruncate(fd, memory->Size);
+			ftruncate(fd, memory->MappedSize);
 		}
 
-		memory->BaseAddress = mmap(0, memory->Size, PROT_WRITE | PROT_READ, MAP_SHARED, fd, 0);
+		memory->BaseAddress = mmap(0, memory->MappedSize, PROT_WRITE | PROT_READ, MAP_SHARED, fd, 0);
 
 		if (memory->BaseAddress == MAP_FAILED)
 		{
-			printf("Unable to open or create shared memory map \"%s\" (size: %d)\n", memory->Name, memory->Size);
+			INTEROP_LOG_ERROR("Unable to open or create shared memory map \"%s\" (size: %d)", memory->Name, memory->Size);
 			memory->BaseAddress = nullptr;
 			return false;
 		}
 
+		// The backing file of persistent maps stays open for its lock, released on close or process exit
+		if (memory->Path != nullptr)
+		{
+			memory->Exclusive = LockFile(fd, F_WRLCK, false);
+
+			if (!memory->Exclusive && !LockFile(fd, F_RDLCK, true))
+			{
+				INTEROP_LOG_WARNING("Unable to lock the backing file \"%s\" of shared memory map \"%s\" (error: %d)", memory->Path, memory->Name, errno);
+			}
+
+			memory->NativeHandle = reinterpret_cast<void*>(static_cast<intptr_t>(fd));
+			memory->State = Memory::INTEROP_MEMORY_MAP_STATE_OPEN;
+
+			return true;
+		}
+
 		if (close(fd) != -1)
 		{
 			memory->State = Memory::INTEROP_MEMORY_MAP_STATE_OPEN;
 			return true;
 		}
 
-		printf("Unable to open or create shared memory map \"%s\" (size: %d)\n", memory->Name, memory->Size);
+		INTEROP_LOG_ERROR("Unable to open or create shared memory map \"%s\" (size: %d)", memory->Name, memory->Size);
 		return false;
 	}
 
+	void EndExclusiveAccess(Memory::SharedBuffer* memory)
+	{
+		if (!memory->Exclusive) return;
+
+		// Converted in place: no other opener can take the write lock in between and see the map as unused
+		LockFile(static_cast<i32>(reinterpret_cast<intptr_t>(memory->NativeHandle)), F_RDLCK, true);
+		memory->Exclusive = false;
+	}
+
 	b8 CloseMemoryMap(Memory::SharedBuffer* memory)
 	{
 		if (memory->State != Memory::INTEROP_MEMORY_MAP_STATE_OPEN)
 		{
-			printf("Shared memory map \"%s\" is already closed\n", memory->Name);
+			INTEROP_LOG_WARNING("Shared memory map \"%s\" is already closed", memory->Name);
 			return true;
 		}
 
-		if (munmap(memory->BaseAddress, memory->Size) == -1)
+		if (munmap(memory->BaseAddress, memory->MappedSize) == -1)
 		{
-			printf("Unable to close shared memory map \"%s\" (size: %d)\n", memory->Name, memory->Size);
+			INTEROP_LOG_ERROR("Unable to close shared memory map \"%s\" (size: %d)", memory->Name, memory->Size);
 			return false;
 		}
 
 		std::string name = std::string("/tmp/");
 		name += memory->Name;
 
-		if (unlink(name.c_str()) == -1)
+		if (memory->Path != nullptr)
 		{
-			printf("Unable to close shared memory map \"%s\" (size: %d)\n", memory->Name, memory->Size);
+			close(static_cast<i32>(reinterpret_cast<intptr_t>(memory->NativeHandle)));
+			memory->Exclusive = false;
+		}
+
+		else if (unlink(name.c_str()) == -1)
+		{
+			INTEROP_LOG_ERROR("Unable to close shared memory map \"%s\" (size: %d)", memory->Name, memory->Size);
 			return false;
 		}
 
@@ -223,8 +306,257 @@ namespace Interop::Platform
 		return true;
 	}
 
+	b8 FlushMemoryMap(Memory::SharedBuffer* memory)
+	{
+		if (memory->State != Memory::INTEROP_MEMORY_MAP_STATE_OPEN)
+		{
+			INTEROP_LOG_ERROR("Unable to flush shared memory map \"%s\" as it is not open", memory->Name);
+			return false;
+		}
+
+		if (msync(memory->BaseAddress, memory->MappedSize, MS_SYNC) == -1)
+		{
+			INTEROP_LOG_ERROR("Unable to flush shared memory map \"%s\" (size: %d)", memory->Name, memory->MappedSize);
+			return false;
+		}
+
+		return true;
+	}
+
+	const void* MapFile(const char* path, u64* size)
+	{
+		i32 fd = open(path, O_RDONLY | O_CLOEXEC);
+
+		if (fd == -1)
+		{
+			INTEROP_LOG_ERROR("Unable to open file \"%s\" (errno: %d)", path, errno);
+			return nullptr;
+		}
+
+		struct stat filestat;
+		void* address = MAP_FAILED;
+
+		if (fstat(fd, &filestat) != -1 && filestat.st_size > 0)
+			address = mmap(nullptr, static_cast<size_t>(filestat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+		close(fd);
+
+		if (address == MAP_FAILED)
+		{
+			INTEROP_LOG_ERROR("Unable to map file \"%s\" (errno: %d)", path, errno);
+			return nullptr;
+		}
+
+		// One large sequential read instead of a page fault per page touched
+		madvise(address, static_cast<size_t>(filestat.st_size), MADV_WILLNEED);
+
+		*size = static_cast<u64>(filestat.st_size);
+		return address;
+	}
+
+	void UnmapFile(const void* address, u64 size)
+	{
+		if (address != nullptr) munmap(const_cast<void*>(address), static_cast<size_t>(size));
+	}
+
+	i32 ForkProcess()
+	{
+		fflush(nullptr);
+		pid_t pid = fork();
+
+		if (pid == -1)
+		{
+			INTEROP_LOG_ERROR("Unable to fork the current process");
+		}
+
+		return static_cast<i32>(pid);
+	}
+
+	ProcessState PollProcess(i32 pid, i32* exitCode, b8 wait)
+	{
+		i32 status = 0;
+		pid_t result = waitpid(static_cast<pid_t>(pid), &status, wait ? 0 : WNOHANG);
+
+		if (result == 0)
+			return INTEROP_PROCESS_STATE_RUNNING;
+
+		if (result == -1)
+		{
+			INTEROP_LOG_ERROR("Unable to query the state of process %d", pid);
+			return INTEROP_PROCESS_STATE_UNKNOWN;
+		}
+
+		if (exitCode != nullptr)
+		{
+			if (WIFEXITED(status)) *exitCode = WEXITSTATUS(status);
+			else if (WIFSIGNALED(status)) *exitCode = 128 + WTERMSIG(status);
+			else *exitCode = -1;
+		}
+
+		return INTEROP_PROCESS_STATE_EXITED;
+	}
+
+	b8 KillProcess(i32 pid)
+	{
+		if (kill(static_cast<pid_t>(pid), SIGKILL) == -1)
+		{
+			INTEROP_LOG_ERROR("Unable to kill process %d", pid);
+			return false;
+		}
+
+		return true;
+	}
+
+	i32 GetCurrentProcessId()
+	{
+		return static_cast<i32>(getpid());
+	}
+
+	// gettid is a syscall, and shared locks ask for the thread id on every acquisition
+	static thread_local u64 t_ThreadId = 0;
+
+	// The child of a fork runs on a new thread, with the cache of the forking one
+	static void ResetThreadId()
+	{
+		t_ThreadId = 0;
+	}
+
+	u64 GetCurrentThreadId()
+	{
+		if (t_ThreadId != 0) return t_ThreadId;
+
+		static const i32 s_AtFork = pthread_atfork(nullptr, nullptr, &ResetThreadId);
+		(void)s_AtFork;
+
+#ifdef INTEROP_PLATFORM_LINUX
+		t_ThreadId = static_cast<u64>(syscall(SYS_gettid));
+
+#else
+		pthread_threadid_np(nullptr, &t_ThreadId);
+#endif
+
+		return t_ThreadId;
+	}
+
+	b8 IsThreadAlive(u64 threadId)
+	{
+#ifdef INTEROP_PLATFORM_LINUX
+		// Thread ids are process ids on Linux, /proc lists them all even if only group leaders show up in readdir
+		char path[32];
+		snprintf(path, sizeof(path), "/proc/%llu/stat", static_cast<unsigned long long>(threadId));
+
+		i32 fd = open(path, O_RDONLY | O_CLOEXEC);
+
+		if (fd == -1)
+			return errno != ENOENT && errno != ESRCH;
+
+		char stat[256];
+		ssize_t size = read(fd, stat, sizeof(stat) - 1);
+		close(fd);
+
+		if (size <= 0) return false;
+		stat[size] = '\0';
+
+		// "pid (name) S ...", the name may hold parentheses itself. Zombies are dead threads nobody reaped yet.
+		const char* name = strrchr(stat, ')');
+		char state = name != nullptr && name[1] == ' ' ? name[2] : '\0';
+
+		return state != 'Z' && state != 'X' && state != 'x';
+
+#else
+		(void)threadId;
+		return true;
+#endif
+	}
+
+	void ExitCurrentProcess(i32 exitCode)
+	{
+		fflush(nullptr);
+		_exit(exitCode);
+	}
+
+	u64 GetMonotonicTime()
+	{
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+
+		return static_cast<u64>(ts.tv_sec) * 1000 + static_cast<u64>(ts.tv_nsec) / 1000000;
+	}
+
+	void SleepFor(u32 milliseconds)
+	{
+		struct timespec ts;
+		ts.tv_sec = milliseconds / 1000;
+		ts.tv_nsec = static_cast<long>(milliseconds % 1000) * 1000000;
+
+		nanosleep(&ts, nullptr);
+	}
+
+	void FutexWait(u32* address, u32 expected, u32 timeout)
+	{
+#ifdef INTEROP_PLATFORM_LINUX
+		struct timespec ts;
+		ts.tv_sec = timeout / 1000;
+		ts.tv_nsec = static_cast<long>(timeout % 1000) * 1000000;
+
+		// Not FUTEX_PRIVATE_FLAG: waiters and wakers may live in different processes
+		syscall(SYS_futex, address, FUTEX_WAIT, expected, &ts, nullptr, 0);
+#else
+		// No public futex outside Linux, callers re-check their condition after a short sleep
+		if (__atomic_load_n(address, __ATOMIC_ACQUIRE) == expected)
+			SleepFor(timeout < 1 ? timeout : 1);
+#endif
+	}
+
+	void FutexWake(u32* address, u32 count)
+	{
+#ifdef INTEROP_PLATFORM_LINUX
+		syscall(SYS_futex, address, FUTEX_WAKE, count, nullptr, nullptr, 0);
+#endif
+	}
+
+	i32 CreateEventFd()
+	{
+#ifdef INTEROP_PLATFORM_LINUX
+		i32 fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+		if (fd == -1)
+		{
+			INTEROP_LOG_ERROR("Unable to create eventfd (errno: %d)", errno);
+		}
+
+		return fd;
+#else
+		INTEROP_LOG_ERROR("Unable to create eventfd, it is only available on Linux");
+		return -1;
+#endif
+	}
+
+	b8 SignalEventFd(i32 fd)
+	{
+#ifdef INTEROP_PLATFORM_LINUX
+		u64 value = 1;
+
+		// EAGAIN means the counter is saturated, the consumer is already signaled
+		return write(fd, &value, sizeof(value)) == sizeof(value) || errno == EAGAIN;
+#else
+		return false;
+#endif
+	}
+
+	void CloseEventFd(i32 fd)
+	{
+		if (fd != -1)
+		{
+			close(fd);
+		}
+	}
+
 }
 
+#undef INTEROP_FILE_LOCK_WAIT
+#undef INTEROP_FILE_LOCK
+
 #undef DYNAMIC_LIBRARY_EXTENSION
 #undef DYNAMIC_LIBRARY_PREFIX
 
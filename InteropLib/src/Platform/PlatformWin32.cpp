@@ -1,4 +1,5 @@
 #include "Core/Definitions.hpp"
+#include "Core/Log.hpp"
 
 #ifdef INTEROP_PLATFORM_WIN32
 
@@ -10,6 +11,8 @@
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 
+#pragma comment(lib, "Synchronization.lib")
+
 #include <string>
 
 #define DYNAMIC_LIBRARY_PREFIX ""
@@ -22,13 +25,13 @@ namespace Interop::Platform
 	{
 		if (library == nullptr) [[unlikely]]
 		{
-			printf("DynamicLibrary object not initialized. Aborting load of library \"%s\"\n", name);
+			INTEROP_LOG_ERROR("DynamicLibrary object not initialized. Aborting load of library \"%s\"", name);
 			return false;
 		}
 
 		if (library->Binaries != nullptr) [[unlikely]]
 		{
-			printf("Dynamic library \"%s\" already loaded in memory.\n", name);
+			INTEROP_LOG_WARNING("Dynamic library \"%s\" already loaded in memory.", name);
 			return true;
 		}
 
@@ -45,7 +48,7 @@ namespace Interop::Platform
 
 		if (library == nullptr)
 		{
-			printf("Unable to locate library \"%s\"\n", name);
+			INTEROP_LOG_ERROR("Unable to locate library \"%s\"", name);
 			return false;
 		}
 
@@ -60,19 +63,19 @@ namespace Interop::Platform
 	{
 		if (library == nullptr) [[unlikely]]
 		{
-			printf("%s\n", "Unable to unload library function, Dynamic Library object not initialized.");
+			INTEROP_LOG_ERROR("Unable to unload library function, Dynamic Library object not initialized.");
 			return false;
 		}
 
 		if (library->Binaries == nullptr) [[unlikely]]
 		{
-			printf("Unable to unload library \"%s\"\n", library->Name);
+			INTEROP_LOG_ERROR("Unable to unload library \"%s\"", library->Name);
 			return false;
 		}
 
 		if (library->Functions.find(name) != library->Functions.end())
 		{
-			printf("The function pointer for function \"%s\" has already been loaded.\n", name);
+			INTEROP_LOG_WARNING("The function pointer for function \"%s\" has already been loaded.", name);
 			return true;
 		}
 
@@ -80,7 +83,7 @@ namespace Interop::Platform
 
 		if (fnPtr == nullptr)
 		{
-			printf("Unable to load function \"%s\" from library \"%s\"\n", name, library->Name);
+			INTEROP_LOG_ERROR("Unable to load function \"%s\" from library \"%s\"", name, library->Name);
 			return false;
 		}
 
@@ -93,13 +96,13 @@ namespace Interop::Platform
 	{
 		if (library == nullptr) [[unlikely]]
 		{
-			printf("%s\n", "Unable to unload library, DynamicLibrary object not initialized.");
+			INTEROP_LOG_ERROR("Unable to unload library, DynamicLibrary object not initialized.");
 			return false;
 		}
 
 		if (library->Binaries == nullptr) [[unlikely]]
 		{
-			printf("Unable to unload library \"%s\"\n", library->Name);
+			INTEROP_LOG_ERROR("Unable to unload library \"%s\"", library->Name);
 			return false;
 		}
 
@@ -107,7 +110,7 @@ namespace Interop::Platform
 
 		if (!result)
 		{
-			printf("Unloading of library \"%s\" failed.\n", library->Name);
+			INTEROP_LOG_ERROR("Unloading of library \"%s\" failed.", library->Name);
 			return false;
 		}
 
@@ -120,13 +123,13 @@ namespace Interop::Platform
 	{
 		if (memory->Name == nullptr) [[unlikely]]
 		{
-			printf("%s\n", "Unable to open or create share memory map, no name has been provided");
+			INTEROP_LOG_ERROR("Unable to open or create share memory map, no name has been provided");
 			return false;
 		}
 
 		if (memory->State == Memory::INTEROP_MEMORY_MAP_STATE_OPEN)
 		{
-			printf("Shared memory map \"%s\" is already open\n", memory->Name);
+			INTEROP_LOG_WARNING("Shared memory map \"%s\" is already open", memory->Name);
 			return true;
 		}
 
@@ -134,32 +137,59 @@ namespace Interop::Platform
 
 		if (memory->Size == 0)
 		{
-			printf("Unable to open or create shared memory map \"%s\" with a size of 0", memory->Name);
+			INTEROP_LOG_ERROR("Unable to open or create shared memory map \"%s\" with a size of 0", memory->Name);
 			return false;
 		}
 
+		if (memory->MappedSize < memory->Size)
+		{
+			memory->MappedSize = memory->Size;
+		}
+
 		memory->NativeHandle = (void*)OpenFileMapping(FILE_MAP_ALL_ACCESS, FALSE, memory->Name);
 
 		if (memory->NativeHandle == nullptr)
 		{
+			HANDLE file = INVALID_HANDLE_VALUE;
+
+			if (memory->Path != nullptr)
+			{
+				file = CreateFileA(memory->Path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+				if (file == INVALID_HANDLE_VALUE)
+				{
+					INTEROP_LOG_ERROR("Unable to open backing file \"%s\" of shared memory map \"%s\"", memory->Path, memory->Name);
+					return false;
+				}
+			}
+
 			memory->NativeHandle = (void*)CreateFileMapping
 			(
-				INVALID_HANDLE_VALUE,
+				file,
 				nullptr,
 				PAGE_READWRITE,
 				0,
-				memory->Size,
+				memory->MappedSize,
 				memory->Name
 			);
+
+			// Named mappings live as long as one process has them open
+			memory->Exclusive = memory->Path != nullptr && memory->NativeHandle != nullptr && GetLastError() != ERROR_ALREADY_EXISTS;
+
+			// The mapping keeps its own reference to the backing file
+			if (file != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(file);
+			}
 		}
 
 		if (memory->NativeHandle == nullptr)
 		{
-			printf("Unable to get native handle for shared memory map \"%s\" (size: %d)\n", memory->Name, memory->Size);
+			INTEROP_LOG_ERROR("Unable to get native handle for shared memory map \"%s\" (size: %d)", memory->Name, memory->Size);
 			return false;
 		}
 
-		memory->BaseAddress = MapViewOfFile((HANDLE)memory->NativeHandle, FILE_MAP_ALL_ACCESS, 0, 0, memory->Size);
+		memory->BaseAddress = MapViewOfFile((HANDLE)memory->NativeHandle, FILE_MAP_ALL_ACCESS, 0, 0, memory->MappedSize);
 
 		if (memory->BaseAddress != nullptr)
 		{
@@ -167,7 +197,7 @@ namespace Interop::Platform
 			return true;
 		}
 
-		printf("Unable to open or create shared memory map \"%s\" (size: %d)\n", memory->Name, memory->Size);
+		INTEROP_LOG_ERROR("Unable to open or create shared memory map \"%s\" (size: %d)", memory->Name, memory->Size);
 		return false;
 	}
 
@@ -175,7 +205,7 @@ namespace Interop::Platform
 	{
 		if (memory->State != Memory::INTEROP_MEMORY_MAP_STATE_OPEN)
 		{
-			printf("Shared memory map \"%s\" is already closed\n", memory->Name);
+			INTEROP_LOG_WARNING("Shared memory map \"%s\" is already closed", memory->Name);
 			return true;
 		}
 
@@ -191,10 +221,163 @@ namespace Interop::Platform
 			return true;
 		}
 
-		printf("Unable to close shared memory map \"%s\" (size: %d)\n", memory->Name, memory->Size);
+		INTEROP_LOG_ERROR("Unable to close shared memory map \"%s\" (size: %d)", memory->Name, memory->Size);
 		return false;
 	}
 
+	void EndExclusiveAccess(Memory::SharedBuffer* memory)
+	{
+		memory->Exclusive = false;
+	}
+
+	b8 FlushMemoryMap(Memory::SharedBuffer* memory)
+	{
+		if (memory->State != Memory::INTEROP_MEMORY_MAP_STATE_OPEN)
+		{
+			INTEROP_LOG_ERROR("Unable to flush shared memory map \"%s\" as it is not open", memory->Name);
+			return false;
+		}
+
+		if (!FlushViewOfFile(memory->BaseAddress, memory->MappedSize))
+		{
+			INTEROP_LOG_ERROR("Unable to flush shared memory map \"%s\" (size: %d)", memory->Name, memory->MappedSize);
+			return false;
+		}
+
+		return true;
+	}
+
+	const void* MapFile(const char* path, u64* size)
+	{
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			INTEROP_LOG_ERROR("Unable to open file \"%s\" (error: %lu)", path, GetLastError());
+			return nullptr;
+		}
+
+		LARGE_INTEGER fileSize = {};
+		HANDLE mapping = nullptr;
+		void* address = nullptr;
+
+		if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+			mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		// The view keeps the mapping and the file alive once their handles are closed
+		if (mapping != nullptr)
+		{
+			address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+
+		CloseHandle(file);
+
+		if (address == nullptr)
+		{
+			INTEROP_LOG_ERROR("Unable to map file \"%s\" (error: %lu)", path, GetLastError());
+			return nullptr;
+		}
+
+		WIN32_MEMORY_RANGE_ENTRY range = { address, static_cast<SIZE_T>(fileSize.QuadPart) };
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+
+		*size = static_cast<u64>(fileSize.QuadPart);
+		return address;
+	}
+
+	void UnmapFile(const void* address, u64 size)
+	{
+		if (address != nullptr) UnmapViewOfFile(address);
+	}
+
+	i32 ForkProcess()
+	{
+		INTEROP_LOG_ERROR("Forking the current process is not supported on Windows");
+		return -1;
+	}
+
+	ProcessState PollProcess(i32 pid, i32* exitCode, b8 wait)
+	{
+		INTEROP_LOG_ERROR("Unable to query the state of process %d, worker processes are not supported on Windows", pid);
+		return INTEROP_PROCESS_STATE_UNKNOWN;
+	}
+
+	b8 KillProcess(i32 pid)
+	{
+		INTEROP_LOG_ERROR("Unable to kill process %d, worker processes are not supported on Windows", pid);
+		return false;
+	}
+
+	i32 GetCurrentProcessId()
+	{
+		return static_cast<i32>(::GetCurrentProcessId());
+	}
+
+	u64 GetCurrentThreadId()
+	{
+		return static_cast<u64>(::GetCurrentThreadId());
+	}
+
+	b8 IsThreadAlive(u64 threadId)
+	{
+		HANDLE thread = OpenThread(SYNCHRONIZE, FALSE, static_cast<DWORD>(threadId));
+
+		// Threads of other users cannot be opened, but they exist
+		if (thread == nullptr)
+			return GetLastError() == ERROR_ACCESS_DENIED;
+
+		b8 alive = WaitForSingleObject(thread, 0) == WAIT_TIMEOUT;
+		CloseHandle(thread);
+
+		return alive;
+	}
+
+	void ExitCurrentProcess(i32 exitCode)
+	{
+		ExitProcess(static_cast<UINT>(exitCode));
+	}
+
+	u64 GetMonotonicTime()
+	{
+		return static_cast<u64>(GetTickCount64());
+	}
+
+	void SleepFor(u32 milliseconds)
+	{
+		Sleep(milliseconds);
+	}
+
+	void FutexWait(u32* address, u32 expected, u32 timeout)
+	{
+		// Only wakes waiters of the same process: cross-process doorbells fall back to their timeout
+		::WaitOnAddress(address, &expected, sizeof(u32), timeout);
+	}
+
+	void FutexWake(u32* address, u32 count)
+	{
+		if (count == 1)
+			::WakeByAddressSingle(address);
+
+		else
+			::WakeByAddressAll(address);
+	}
+
+	i32 CreateEventFd()
+	{
+		INTEROP_LOG_ERROR("Unable to create eventfd, it is only available on Linux");
+		return -1;
+	}
+
+	b8 SignalEventFd(i32 fd)
+	{
+		return false;
+	}
+
+	void CloseEventFd(i32 fd)
+	{
+	}
+
 }
 
 #undef DYNAMIC_LIBRARY_PREFIX
@@ -0,0 +1,166 @@
+#include "LoadGenerator.hpp"
+
+#ifdef INTEROP_PLATFORM_LINUX
+#include <pthread.h>
+#include <sched.h>
+
+#elif defined(INTEROP_PLATFORM_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include <algorithm>
+
+#define LOAD_TIMER_SAMPLES 100000
+
+namespace Load
+{
+
+	void Histogram::Merge(const Histogram& other)
+	{
+		for (u32 i = 0; i < LOAD_HISTOGRAM_BUCKETS; i++)
+			Counts[i] += other.Counts[i];
+
+		Total += other.Total;
+		Sum += other.Sum;
+		Max = std::max(Max, other.Max);
+	}
+
+	f64 Histogram::Percentile(f64 percentile) const
+	{
+		if (Total == 0) return 0.0;
+
+		u64 rank = static_cast<u64>(percentile / 100.0 * Total + 0.5);
+		u64 seen = 0;
+
+		for (u32 i = 0; i < LOAD_HISTOGRAM_BUCKETS; i++)
+		{
+			seen += Counts[i];
+			if (seen < std::max<u64>(rank, 1)) continue;
+
+			u32 exponent = i < 2 * LOAD_HISTOGRAM_SUB_COUNT ? 0 : i / LOAD_HISTOGRAM_SUB_COUNT - 1;
+			u64 mantissa = i - exponent * LOAD_HISTOGRAM_SUB_COUNT;
+
+			return static_cast<f64>(std::min<u64>(((mantissa + 1) << exponent) - 1, Max));
+		}
+
+		return static_cast<f64>(Max);
+	}
+
+	b8 PinCurrentThread(u32 cpu)
+	{
+#ifdef INTEROP_PLATFORM_LINUX
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+
+		return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+
+#elif defined(INTEROP_PLATFORM_WINDOWS)
+		return SetThreadAffinityMask(GetCurrentThread(), 1ull << (cpu % 64)) != 0;
+
+#else
+		(void)cpu;
+		return false;
+#endif
+	}
+
+	f64 MeasureTimerOverhead()
+	{
+		u64 total = 0;
+
+		// Latency recorded for an empty operation, what every timed operation pays on top of its own cost
+		for (u32 i = 0; i < LOAD_TIMER_SAMPLES; i++)
+		{
+			u64 begin = Now();
+			total += Now() - begin;
+		}
+
+		return static_cast<f64>(total) / LOAD_TIMER_SAMPLES;
+	}
+
+	Result Summarize(const char* scenario, u32 threads, b8 pinned, u64 elapsed, const Histogram& histogram)
+	{
+		Result result = {};
+		result.Scenario = scenario;
+		result.Threads = threads;
+		result.Pinned = pinned;
+		result.Operations = histogram.Total;
+
+		if (histogram.Total == 0 || elapsed == 0) return result;
+
+		result.Throughput = static_cast<f64>(histogram.Total) * 1e9 / static_cast<f64>(elapsed);
+		result.Mean = static_cast<f64>(histogram.Sum) / static_cast<f64>(histogram.Total);
+		result.P50 = histogram.Percentile(50.0);
+		result.P99 = histogram.Percentile(99.0);
+		result.P999 = histogram.Percentile(99.9);
+		result.Max = static_cast<f64>(histogram.Max);
+
+		return result;
+	}
+
+	void PrintTable(FILE* stream, const std::vector<Result>& results)
+	{
+		fprintf(stream, "%-16s %7s %6s %14s %10s %10s %10s %10s %12s\n", "Scenario", "Threads", "Pinned", "Ops/s", "Scaling", "P50 (ns)", "P99 (ns)", "P999 (ns)", "Max (ns)");
+
+		for (const auto& r : results)
+		{
+			fprintf(stream, "%-16s %7u %6s %14.0f %9.1f%% %10.0f %10.0f %10.0f %12.0f\n",
+				r.Scenario.c_str(), r.Threads, r.Pinned ? "yes" : "no", r.Throughput, r.Efficiency * 100.0, r.P50, r.P99, r.P999, r.Max);
+		}
+	}
+
+	static FILE* OpenOutput(const char* path)
+	{
+		FILE* file = fopen(path, "w");
+
+		if (file == nullptr)
+			printf("Unable to open \"%s\" to write load results\n", path);
+
+		return file;
+	}
+
+	b8 WriteCsv(const char* path, const std::vector<Result>& results)
+	{
+		FILE* file = OpenOutput(path);
+		if (file == nullptr) return false;
+
+		fprintf(file, "scenario,threads,pinned,operations,ops_per_sec,efficiency,mean_ns,p50_ns,p99_ns,p999_ns,max_ns\n");
+
+		for (const auto& r : results)
+		{
+			fprintf(file, "%s,%u,%u,%llu,%.1f,%.4f,%.1f,%.0f,%.0f,%.0f,%.0f\n",
+				r.Scenario.c_str(), r.Threads, r.Pinned ? 1u : 0u, static_cast<unsigned long long>(r.Operations),
+				r.Throughput, r.Efficiency, r.Mean, r.P50, r.P99, r.P999, r.Max);
+		}
+
+		fclose(file);
+		return true;
+	}
+
+	b8 WriteJson(const char* path, const std::vector<Result>& results)
+	{
+		FILE* file = OpenOutput(path);
+		if (file == nullptr) return false;
+
+		fprintf(file, "{\n\t\"latency_unit\": \"ns\",\n\t\"throughput_unit\": \"ops/s\",\n\t\"results\": [\n");
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const Result& r = results[i];
+
+			fprintf(file, "\t\t{ \"scenario\": \"%s\", \"threads\": %u, \"pinned\": %s, \"operations\": %llu, \"throughput\": %.1f, "
+				"\"efficiency\": %.4f, \"mean\": %.1f, \"p50\": %.0f, \"p99\": %.0f, \"p999\": %.0f, \"max\": %.0f }%s\n",
+				r.Scenario.c_str(), r.Threads, r.Pinned ? "true" : "false", static_cast<unsigned long long>(r.Operations), r.Throughput,
+				r.Efficiency, r.Mean, r.P50, r.P99, r.P999, r.Max, i + 1 < results.size() ? "," : "");
+		}
+
+		fprintf(file, "\t]\n}\n");
+		fclose(file);
+
+		return true;
+	}
+
+}
+
+#undef LOAD_TIMER_SAMPLES
\ No newline at end of file
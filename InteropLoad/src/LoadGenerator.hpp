@@ -0,0 +1,172 @@
+#pragma once
+
+#include <Core/Definitions.hpp>
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Log-linear latency buckets: 16 linear sub-buckets per power of two, a relative error below 6.25%
+#define LOAD_HISTOGRAM_SUB_BITS 4
+#define LOAD_HISTOGRAM_SUB_COUNT (1u << LOAD_HISTOGRAM_SUB_BITS)
+#define LOAD_HISTOGRAM_BUCKETS ((64 - LOAD_HISTOGRAM_SUB_BITS + 1) * LOAD_HISTOGRAM_SUB_COUNT)
+
+namespace Load
+{
+
+	struct Config
+	{
+		std::vector<u32> ThreadCounts = {};
+		u32 Duration = 1000; // Per thread count, in milliseconds
+		u32 Warmup = 1000; // Operations per thread before the measurement starts
+		b8 Pin = true;
+	};
+
+	// Latencies in nanoseconds, throughput in operations per second
+	struct Result
+	{
+		std::string Scenario;
+		u32 Threads = 0;
+		b8 Pinned = false;
+
+		u64 Operations = 0;
+		f64 Throughput = 0.0;
+		f64 Efficiency = 0.0; // Throughput / (Threads * single-thread throughput)
+
+		f64 Mean = 0.0;
+		f64 P50 = 0.0;
+		f64 P99 = 0.0;
+		f64 P999 = 0.0;
+		f64 Max = 0.0;
+	};
+
+	INTEROP_INLINE u64 Now()
+	{
+		return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	struct Histogram
+	{
+		u64 Counts[LOAD_HISTOGRAM_BUCKETS] = {};
+		u64 Total = 0;
+		u64 Sum = 0;
+		u64 Max = 0;
+
+		INTEROP_INLINE void Record(u64 value)
+		{
+			u32 exponent = value < 2 * LOAD_HISTOGRAM_SUB_COUNT ? 0 : static_cast<u32>(std::bit_width(value)) - LOAD_HISTOGRAM_SUB_BITS - 1;
+			u32 bucket = exponent * LOAD_HISTOGRAM_SUB_COUNT + static_cast<u32>(value >> exponent);
+
+			Counts[bucket]++;
+			Total++;
+			Sum += value;
+
+			if (value > Max) Max = value;
+		}
+
+		void Merge(const Histogram& other);
+
+		// Upper bound of the bucket holding the requested percentile
+		f64 Percentile(f64 percentile) const;
+	};
+
+	inline const void* volatile g_Sink = nullptr;
+
+	INTEROP_INLINE void DoNotOptimize(const void* value)
+	{
+		g_Sink = value;
+	}
+
+	// Pins the calling thread to a CPU, returns false where unsupported
+	b8 PinCurrentThread(u32 cpu);
+
+	// Cost of the two clock reads surrounding every operation, included in the latencies reported
+	f64 MeasureTimerOverhead();
+
+	// Runs `operation(thread, iteration)` on every thread count of the configuration, for the configured duration,
+	// timing each call. Threads are pinned to consecutive CPUs and start together once warmed up.
+	template <typename Fn>
+	void Run(const char* scenario, const Config& config, Fn&& operation, std::vector<Result>& results);
+
+	void PrintTable(FILE* stream, const std::vector<Result>& results);
+	b8 WriteCsv(const char* path, const std::vector<Result>& results);
+	b8 WriteJson(const char* path, const std::vector<Result>& results);
+
+	Result Summarize(const char* scenario, u32 threads, b8 pinned, u64 elapsed, const Histogram& histogram);
+
+}
+
+namespace Load
+{
+
+	template <typename Fn>
+	void Run(const char* scenario, const Config& config, Fn&& operation, std::vector<Result>& results)
+	{
+		u32 cpuCount = std::thread::hardware_concurrency();
+		f64 baseline = 0.0;
+
+		for (u32 threadCount : config.ThreadCounts)
+		{
+			std::vector<Histogram> histograms(threadCount);
+			std::vector<std::thread> threads;
+
+			std::atomic<u32> ready = 0;
+			std::atomic<b8> start = false;
+			std::atomic<b8> stop = false;
+			std::atomic<u32> pinned = 0;
+
+			for (u32 t = 0; t < threadCount; t++)
+			{
+				threads.emplace_back([&, t]()
+				{
+					if (config.Pin && cpuCount > 0 && PinCurrentThread(t % cpuCount))
+						pinned.fetch_add(1, std::memory_order_relaxed);
+
+					// Also attaches the thread to the runtime before the measurement
+					for (u32 i = 0; i < config.Warmup; i++)
+						operation(t, i);
+
+					ready.fetch_add(1, std::memory_order_release);
+					while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+
+					Histogram& histogram = histograms[t];
+
+					for (u32 i = 0; !stop.load(std::memory_order_relaxed); i++)
+					{
+						u64 begin = Now();
+						operation(t, i);
+						histogram.Record(Now() - begin);
+					}
+				});
+			}
+
+			while (ready.load(std::memory_order_acquire) < threadCount) std::this_thread::yield();
+
+			u64 begin = Now();
+			start.store(true, std::memory_order_release);
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(config.Duration));
+			stop.store(true, std::memory_order_relaxed);
+
+			for (std::thread& thread : threads) thread.join();
+			u64 elapsed = Now() - begin;
+
+			Histogram merged = {};
+			for (const Histogram& histogram : histograms) merged.Merge(histogram);
+
+			Result result = Summarize(scenario, threadCount, pinned.load() == threadCount, elapsed, merged);
+
+			// Efficiency against the single-thread run, or the first one measured without it
+			if (baseline == 0.0) baseline = result.Throughput / threadCount;
+			result.Efficiency = baseline > 0.0 ? result.Throughput / (baseline * threadCount) : 0.0;
+
+			results.push_back(result);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <Core/Definitions.hpp>
+#include <Core/HostedAssembly.hpp>
+#include <Core/Memory.hpp>
+#include <Core/Recorder.hpp>
+#include <Core/SharedLock.hpp>
+
+#include <NetCore/NetCoreController.hpp>
+
+#include <NetCore/Api/ExampleApi.hpp>
+
+#include "LoadGenerator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+typedef void (INTEROP_DELEGATE_CALLTYPE *NoopWithObjectFn)(void*);
+typedef void (INTEROP_DELEGATE_CALLTYPE *DelegateRoundaboutFn)(i32);
+
+#define LOAD_CLASS_PATH "Interop.Core.Benchmarks.BenchmarkEntryPoint"
+#define LOAD_SHARED_MEMORY_SIZE (1 << 20)
+#define LOAD_MAX_THREADS 256
+#define LOAD_RECORD_CAPACITY (64u << 20)
+
+using Interop::NetCore::Api::CustomObject;
+
+// Parses "1,2,4,8", returns false on invalid or out of range counts
+static b8 ParseThreadCounts(const char* list, std::vector<u32>& counts)
+{
+	counts.clear();
+
+	for (const char* cursor = list; *cursor != '\0';)
+	{
+		char* end = nullptr;
+		unsigned long count = strtoul(cursor, &end, 10);
+
+		if (end == cursor || count == 0 || count > LOAD_MAX_THREADS) return false;
+
+		counts.push_back(static_cast<u32>(count));
+		cursor = *end == ',' ? end + 1 : end;
+
+		if (*end != ',' && *end != '\0') return false;
+	}
+
+	return !counts.empty();
+}
+
+// 1, 2, 4... up to the number of CPUs, which is always measured
+static std::vector<u32> GetDefaultThreadCounts()
+{
+	u32 cpuCount = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<u32> counts;
+
+	for (u32 count = 1; count < cpuCount; count *= 2)
+		counts.push_back(count);
+
+	counts.push_back(cpuCount);
+	return counts;
+}
+
+static b8 IsSelected(const char* selected, const char* scenario)
+{
+	return selected == nullptr || strcmp(selected, scenario) == 0;
+}
+
+int main(int argc, char* argv[])
+{
+	Load::Config config = {};
+	config.ThreadCounts = GetDefaultThreadCounts();
+
+	const char* version = "9.0.0";
+	const char* scenario = nullptr;
+	const char* csvPath = nullptr;
+	const char* jsonPath = nullptr;
+	const char* recordPath = nullptr;
+
+	for (i32 i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--threads") == 0 && ParseThreadCounts(argv[i + 1], config.ThreadCounts)) continue;
+		else if (strcmp(argv[i], "--duration") == 0) config.Duration = static_cast<u32>(atoi(argv[i + 1]));
+		else if (strcmp(argv[i], "--warmup") == 0) config.Warmup = static_cast<u32>(atoi(argv[i + 1]));
+		else if (strcmp(argv[i], "--pin") == 0) config.Pin = atoi(argv[i + 1]) != 0;
+		else if (strcmp(argv[i], "--scenario") == 0) scenario = argv[i + 1];
+		else if (strcmp(argv[i], "--version") == 0) version = argv[i + 1];
+		else if (strcmp(argv[i], "--csv") == 0) csvPath = argv[i + 1];
+		else if (strcmp(argv[i], "--json") == 0) jsonPath = argv[i + 1];
+		else if (strcmp(argv[i], "--record") == 0) recordPath = argv[i + 1];
+
+		else
+		{
+			printf("Usage: %s [--threads 1,2,4] [--duration MS] [--warmup N] [--pin 0|1] [--scenario NAME] [--version X.Y.Z] [--csv PATH] [--json PATH] [--record PATH]\n", argv[0]);
+			printf("%s\n", "Scenarios: call, callback, memory-set, memory-get, shared-mutex (all by default)");
+			return 1;
+		}
+	}
+
+	if (config.Duration == 0)
+	{
+		printf("%s\n", "Duration must be greater than 0");
+		return 1;
+	}
+
+	Interop::NetCore::Controller controller(version);
+	Interop::HostedAssembly interopCore("Interop.Core");
+
+	controller.SetSharedMemorySize(LOAD_SHARED_MEMORY_SIZE);
+
+	if (!controller.Init())
+	{
+		return 1;
+	}
+
+	b8 success = controller.OpenContext(&interopCore);
+	if (success) success = controller.LoadAssemblyFunction("NoopWithObject", LOAD_CLASS_PATH, &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("DelegateRoundabout", LOAD_CLASS_PATH, &interopCore);
+
+	if (!success) return 1;
+
+	auto NoopWithObject = interopCore.GetFunction<NoopWithObjectFn>("NoopWithObject");
+	auto DelegateRoundabout = interopCore.GetFunction<DelegateRoundaboutFn>("DelegateRoundabout");
+
+	// One object per thread, on its own cache line, so that the arguments never share a line
+	struct alignas(64) ThreadObject
+	{
+		CustomObject Object;
+	};
+
+	u32 maxThreads = *std::max_element(config.ThreadCounts.begin(), config.ThreadCounts.end());
+	std::vector<ThreadObject> objects(maxThreads);
+
+	u32 capacity = Interop::Memory::GetOrCreateBlock<CustomObject>()->Capacity;
+
+	printf("Timer overhead: %.1f ns per operation, included in the latencies below\n\n", Load::MeasureTimerOverhead());
+
+	std::vector<Load::Result> results;
+
+	// Recorded calls take longer, the latencies measured while recording are only there to capture the traffic
+	if (recordPath != nullptr) Interop::Recorder::Start(LOAD_RECORD_CAPACITY);
+
+	// Native-to-managed calls with a pointer argument
+	if (IsSelected(scenario, "call"))
+	{
+		Load::Run("call", config, [&](u32 thread, u32)
+		{
+			NoopWithObject(&objects[thread].Object);
+		}, results);
+	}
+
+	// Native-to-managed call calling back into native code, which calls a managed callback
+	if (IsSelected(scenario, "callback"))
+	{
+		Load::Run("callback", config, [&](u32, u32)
+		{
+			DelegateRoundabout(1);
+		}, results);
+	}
+
+	// Threads write disjoint slots of the same shared block, as workers owning their records do
+	if (IsSelected(scenario, "memory-set"))
+	{
+		Load::Run("memory-set", config, [&](u32 thread, u32 iteration)
+		{
+			Interop::Memory::Set<CustomObject>((thread + iteration * maxThreads) % capacity, objects[thread].Object);
+		}, results);
+	}
+
+	if (IsSelected(scenario, "memory-get"))
+	{
+		Load::Run("memory-get", config, [&](u32 thread, u32 iteration)
+		{
+			Load::DoNotOptimize(Interop::Memory::Get<CustomObject>((thread + iteration * maxThreads) % capacity));
+		}, results);
+	}
+
+	// Every thread updates the same record under one robust mutex of the shared memory map
+	if (IsSelected(scenario, "shared-mutex"))
+	{
+		Interop::Memory::SharedMutex* mutex = Interop::Memory::ReserveSharedMutex();
+		CustomObject* record = Interop::Memory::Get<CustomObject>(0);
+
+		Load::Run("shared-mutex", config, [&](u32, u32 iteration)
+		{
+			Interop::Memory::LockSharedMutex(mutex);
+			record->DoubleProperty = static_cast<f64>(iteration);
+			Interop::Memory::UnlockSharedMutex(mutex);
+		}, results);
+	}
+
+	if (recordPath != nullptr && !Interop::Recorder::Stop(recordPath))
+		return 1;
+
+	controller.CloseContext();
+
+	if (results.empty())
+	{
+		printf("Unknown scenario \"%s\"\n", scenario);
+		return 1;
+	}
+
+	Load::PrintTable(stdout, results);
+
+	if (csvPath != nullptr && !Load::WriteCsv(csvPath, results))
+		return 1;
+
+	if (jsonPath != nullptr && !Load::WriteJson(jsonPath, results))
+		return 1;
+
+	return 0;
+}
+
+#undef LOAD_MAX_THREADS
+#undef LOAD_RECORD_CAPACITY
+#undef LOAD_SHARED_MEMORY_SIZE
+#undef LOAD_CLASS_PATH
\ No newline at end of file
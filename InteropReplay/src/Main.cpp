@@ -0,0 +1,250 @@
+#include <Core/Definitions.hpp>
+#include <Core/HostedAssembly.hpp>
+#include <Core/Recorder.hpp>
+
+#include <NetCore/NetCoreController.hpp>
+
+#include <NetCore/Api/ExampleApi.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef void (INTEROP_DELEGATE_CALLTYPE *NoArgumentFn)();
+typedef void (INTEROP_DELEGATE_CALLTYPE *ObjectFn)(void*);
+typedef void (INTEROP_DELEGATE_CALLTYPE *IterationsFn)(i32);
+typedef void (INTEROP_DELEGATE_CALLTYPE *ObjectIterationsFn)(void*, i32);
+typedef void (INTEROP_DELEGATE_CALLTYPE *IndexFn)(u32);
+
+#define REPLAY_SHARED_MEMORY_SIZE (1 << 20)
+
+using namespace Interop::Recorder;
+
+struct Signature
+{
+	RecordKind Kind;
+	const char* Name; // "<class path>.<name>" for managed functions
+	ReplayFn Replay;
+	void* Function; // Exports only, managed functions are bound by name
+};
+
+// Functions whose arguments can be rebuilt from a recording: pointers to arrays or to structures holding
+// addresses (frames, buffers, slot ranges) cannot, as only the first value pointed to is recorded
+static const Signature s_Signatures[] =
+{
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Benchmarks.BenchmarkEntryPoint.Noop", Replay<NoArgumentFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Benchmarks.BenchmarkEntryPoint.NoopWithObject", Replay<ObjectFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Benchmarks.BenchmarkEntryPoint.CallNativeNoop", Replay<IterationsFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Benchmarks.BenchmarkEntryPoint.CallNativeNoopExport", Replay<IterationsFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Benchmarks.BenchmarkEntryPoint.CallNativeNoopSuppressed", Replay<IterationsFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Benchmarks.BenchmarkEntryPoint.DelegateRoundabout", Replay<IterationsFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Benchmarks.BenchmarkEntryPoint.PassObjectCoTaskMem", Replay<IterationsFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Benchmarks.BenchmarkEntryPoint.PassObjectScratch", Replay<IterationsFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Benchmarks.BenchmarkEntryPoint.DecodeMarshalled", Replay<ObjectIterationsFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Benchmarks.BenchmarkEntryPoint.DecodeNativeText", Replay<ObjectIterationsFn>, nullptr },
+
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Examples.EntryPoint.PrintObjProperties", Replay<ObjectFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Examples.EntryPoint.PassObjectToHost", Replay<NoArgumentFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Examples.EntryPoint.DelegateRoundabout", Replay<NoArgumentFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Examples.EntryPoint.ReadObjectFromSharedMemory", Replay<IndexFn>, nullptr },
+	{ INTEROP_RECORD_KIND_MANAGED, "Interop.Core.Examples.EntryPoint.WriteObjectToSharedMemory", Replay<IndexFn>, nullptr },
+
+	{ INTEROP_RECORD_KIND_EXPORT, "PrintHostedObjProperties", Replay<decltype(&Interop::NetCore::Api::PrintHostedObjProperties)>, (void*)&Interop::NetCore::Api::PrintHostedObjProperties },
+	{ INTEROP_RECORD_KIND_EXPORT, "ProcessCustomObject", Replay<decltype(&Interop::NetCore::Api::ProcessCustomObject)>, (void*)&Interop::NetCore::Api::ProcessCustomObject },
+};
+
+// Replay state of a name of the recording
+struct Target
+{
+	ReplayFn Replay = nullptr;
+	void* Function = nullptr;
+
+	std::string Method; // Key of the function in the hosted assembly, kept alive for its lifetime
+
+	u64 Calls = 0;
+	u64 Skipped = 0;
+	u64 Elapsed = 0; // Nanoseconds spent in replayed calls
+};
+
+static u64 Now()
+{
+	return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static const Signature* FindSignature(const RecordedName& name)
+{
+	for (const Signature& signature : s_Signatures)
+	{
+		if (signature.Kind == name.Kind && name.Name == signature.Name)
+			return &signature;
+	}
+
+	return nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+	const char* version = "9.0.0";
+	const char* inputPath = nullptr;
+	b8 pacing = false;
+	u32 repeat = 1;
+
+	for (i32 i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--input") == 0) inputPath = argv[i + 1];
+		else if (strcmp(argv[i], "--pacing") == 0) pacing = atoi(argv[i + 1]) != 0;
+		else if (strcmp(argv[i], "--repeat") == 0) repeat = static_cast<u32>(atoi(argv[i + 1]));
+		else if (strcmp(argv[i], "--version") == 0) version = argv[i + 1];
+
+		else
+		{
+			inputPath = nullptr;
+			break;
+		}
+	}
+
+	if (inputPath == nullptr || repeat == 0 || argc % 2 == 0)
+	{
+		printf("Usage: %s --input PATH [--pacing 0|1] [--repeat N] [--version X.Y.Z]\n", argv[0]);
+		printf("%s\n", "Replays the calls of a recording as fast as possible, or at their original pace with --pacing 1");
+		return 1;
+	}
+
+	Recording recording;
+	if (!LoadRecording(inputPath, &recording)) return 1;
+
+	Interop::NetCore::Controller controller(version);
+	Interop::HostedAssembly interopCore("Interop.Core");
+
+	controller.SetSharedMemorySize(REPLAY_SHARED_MEMORY_SIZE);
+
+	if (!controller.Init())
+	{
+		return 1;
+	}
+
+	if (!controller.OpenContext(&interopCore)) return 1;
+
+	std::vector<Target> targets(recording.Names.size());
+
+	for (u32 i = 0; i < recording.Names.size(); i++)
+	{
+		const RecordedName& name = recording.Names[i];
+		const Signature* signature = FindSignature(name);
+
+		if (signature == nullptr)
+		{
+			printf("No replay signature for \"%s\", its calls are skipped\n", name.Name.c_str());
+			continue;
+		}
+
+		Target& target = targets[i];
+
+		if (name.Kind == INTEROP_RECORD_KIND_EXPORT)
+		{
+			target.Replay = signature->Replay;
+			target.Function = signature->Function;
+
+			continue;
+		}
+
+		size_t separator = name.Name.rfind('.');
+		std::string classPath = name.Name.substr(0, separator);
+		target.Method = name.Name.substr(separator + 1);
+
+		if (!controller.LoadAssemblyFunction(target.Method.c_str(), classPath.c_str(), &interopCore))
+		{
+			printf("Unable to bind \"%s\", its calls are skipped\n", name.Name.c_str());
+			continue;
+		}
+
+		target.Replay = signature->Replay;
+		target.Function = interopCore.Functions.at(target.Method.c_str());
+	}
+
+	printf("Replaying %u calls recorded over %.3f ms (%llu dropped while recording)%s\n\n", recording.Header.CallCount,
+		recording.Header.Duration / 1e6, recording.Header.Dropped, pacing ? " at their original pace" : "");
+
+	u64 wallTime = 0;
+	u64 unnamed = 0; // Calls of a function missing from the name table
+
+	for (u32 pass = 0; pass < repeat; pass++)
+	{
+		u64 start = Now();
+
+		b8 complete = ForEachCall(recording, [&](const CallHeader& call, const u8* arguments)
+		{
+			if (call.Function >= targets.size())
+			{
+				unnamed++;
+				return;
+			}
+
+			Target& target = targets[call.Function];
+
+			if (target.Replay == nullptr)
+			{
+				target.Skipped++;
+				return;
+			}
+
+			// Sleeps for the long gaps, spins for the last stretch so that short ones keep their length
+			if (pacing)
+			{
+				u64 due = start + call.Timestamp;
+				u64 now = Now();
+
+				if (due > now + 2000000) std::this_thread::sleep_for(std::chrono::nanoseconds(due - now - 1000000));
+				while (Now() < due) {}
+			}
+
+			u64 begin = Now();
+			b8 replayed = target.Replay(target.Function, arguments, call.ArgumentsSize);
+			u64 end = Now();
+
+			if (!replayed)
+			{
+				target.Skipped++;
+				return;
+			}
+
+			target.Calls++;
+			target.Elapsed += end - begin;
+		});
+
+		wallTime += Now() - start;
+
+		if (!complete)
+		{
+			printf("%s\n", "The recording is truncated, its last calls were not replayed");
+			break;
+		}
+	}
+
+	u64 replayed = 0;
+	u64 skipped = unnamed;
+
+	printf("%-80s %12s %10s %14s\n", "Function", "Calls", "Skipped", "Mean (ns)");
+
+	for (u32 i = 0; i < targets.size(); i++)
+	{
+		const Target& target = targets[i];
+		if (target.Calls == 0 && target.Skipped == 0) continue;
+
+		printf("%-80s %12llu %10llu %14.1f\n", recording.Names[i].Name.c_str(), target.Calls, target.Skipped,
+			target.Calls != 0 ? static_cast<f64>(target.Elapsed) / target.Calls : 0.0);
+
+		replayed += target.Calls;
+		skipped += target.Skipped;
+	}
+
+	printf("\nReplayed %llu calls (%llu skipped) in %.3f ms, %.0f calls/s\n", replayed, skipped, wallTime / 1e6,
+		wallTime != 0 ? replayed * 1e9 / wallTime : 0.0);
+
+	controller.CloseContext();
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,224 @@
+#include <Core/Definitions.hpp>
+#include <Core/Stats.hpp>
+
+#include "StatsReader.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+using Interop::Stats::Page;
+
+static void PrintUsage(const char* program)
+{
+	printf("Usage: %s [--pid PID] [--interval MS] [--count N] [--detail 0|1]\n", program);
+	printf("%s\n", "Lists the processes with a statistics page when no process id is given");
+}
+
+static void PrintPages()
+{
+	std::vector<i32> processIds = Stat::ListPages();
+
+	if (processIds.empty())
+	{
+		printf("%s\n", "No statistics page found");
+		return;
+	}
+
+	printf("%-10s %-8s %10s %8s %8s\n", "Process", "State", "Uptime (s)", "Funcs", "Blocks");
+
+	for (i32 processId : processIds)
+	{
+		Stat::MappedPage mapped = {};
+		b8 alive = Stat::IsProcessAlive(processId);
+
+		if (!Stat::MapPage(processId, &mapped))
+		{
+			printf("%-10d %-8s %10s %8s %8s\n", processId, "invalid", "-", "-", "-");
+			continue;
+		}
+
+		// Pages of processes that crashed stay behind, their counters are still readable
+		u64 now = static_cast<u64>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+		u64 uptime = now > mapped.Page->StartTime ? (now - mapped.Page->StartTime) / 1000 : 0;
+
+		printf("%-10d %-8s %10llu %8u %8u\n", processId, alive ? "running" : "exited", uptime,
+			mapped.Page->FunctionCount.load(std::memory_order_acquire), mapped.Page->BlockCount.load(std::memory_order_acquire));
+
+		Stat::UnmapPage(&mapped);
+	}
+}
+
+static void PrintBlocks(const Page* page)
+{
+	u32 blockCount = page->BlockCount.load(std::memory_order_acquire);
+	if (blockCount == 0) return;
+
+	printf("  %-48s %10s %10s %8s\n", "Block", "High water", "Capacity", "Used");
+
+	for (u32 i = 0; i < blockCount; i++)
+	{
+		const Interop::Stats::BlockStats& block = page->Blocks[i];
+		u32 highWater = block.HighWater.load(std::memory_order_relaxed);
+
+		printf("  %-48s %10u %10u %7.1f%%\n", Stat::DemangleTypeName(block.Name).c_str(), highWater, block.Capacity,
+			block.Capacity != 0 ? 100.0 * highWater / block.Capacity : 0.0);
+	}
+
+	if (page->DroppedBlocks.load(std::memory_order_relaxed) != 0)
+		printf("  (%u blocks not tracked, the page is full)\n", page->DroppedBlocks.load(std::memory_order_relaxed));
+}
+
+static void PrintFunctions(const Page* page, const Stat::Sample& previous, const Stat::Sample& current, f64 seconds)
+{
+	printf("  %-64s %12s %14s\n", "Function", "Calls/s", "Calls");
+
+	for (u32 i = 0; i < current.Calls.size(); i++)
+	{
+		u64 before = i < previous.Calls.size() ? previous.Calls[i] : 0;
+		const char* name = page->Functions[i].Name;
+
+		printf("  %-64.*s %12.0f %14llu\n", static_cast<int>(strnlen(name, sizeof(page->Functions[i].Name))), name,
+			(current.Calls[i] - before) / seconds, current.Calls[i]);
+	}
+
+	if (page->DroppedFunctions.load(std::memory_order_relaxed) != 0)
+		printf("  (%u functions not tracked, the page is full)\n", page->DroppedFunctions.load(std::memory_order_relaxed));
+}
+
+static void PrintCaches(const Page* page, const Stat::Sample& previous, const Stat::Sample& current, f64 seconds)
+{
+	if (current.CacheHits.empty()) return;
+
+	printf("  %-64s %12s %12s %8s %10s %8s\n", "Cache", "Hits/s", "Misses/s", "Hit %", "Evictions", "Flushes");
+
+	for (u32 i = 0; i < current.CacheHits.size(); i++)
+	{
+		const Interop::Stats::CacheStats& cache = page->Caches[i];
+
+		u64 hits = current.CacheHits[i] - (i < previous.CacheHits.size() ? previous.CacheHits[i] : 0);
+		u64 misses = current.CacheMisses[i] - (i < previous.CacheMisses.size() ? previous.CacheMisses[i] : 0);
+
+		// Rate over the interval, hits and misses since the start when the cache was idle
+		f64 hitRate = hits + misses != 0 ? 100.0 * hits / (hits + misses)
+			: current.CacheHits[i] + current.CacheMisses[i] != 0 ? 100.0 * current.CacheHits[i] / (current.CacheHits[i] + current.CacheMisses[i]) : 0.0;
+
+		printf("  %-64.*s %12.0f %12.0f %7.1f%% %10llu %8llu\n", static_cast<int>(strnlen(cache.Name, sizeof(cache.Name))), cache.Name,
+			hits / seconds, misses / seconds, hitRate, cache.Evictions.load(std::memory_order_relaxed), cache.Invalidations.load(std::memory_order_relaxed));
+	}
+
+	if (page->DroppedCaches.load(std::memory_order_relaxed) != 0)
+		printf("  (%u caches not tracked, the page is full)\n", page->DroppedCaches.load(std::memory_order_relaxed));
+}
+
+static void PrintHeader()
+{
+	printf("%-8s %14s %14s %14s %12s %12s %10s\n", "Time", "Calls/s", "Controller/s", "Copied KB/s", "Reserved KB", "Size KB", "Failures");
+}
+
+static void PrintRates(const Stat::Sample& previous, const Stat::Sample& current)
+{
+	f64 seconds = (current.Time - previous.Time) / 1e9;
+
+	time_t now = time(nullptr);
+	char clock[16];
+	strftime(clock, sizeof(clock), "%H:%M:%S", localtime(&now));
+
+	printf("%-8s %14.0f %14.0f %14.1f %12.1f %12.1f %10llu\n", clock,
+		(current.FunctionCalls - previous.FunctionCalls) / seconds,
+		(current.ControllerCalls - previous.ControllerCalls) / seconds,
+		(current.BytesCopied - previous.BytesCopied) / 1024.0 / seconds,
+		current.MemoryReserved / 1024.0, current.MemorySize / 1024.0,
+		current.ReservationFailures);
+}
+
+int main(int argc, char* argv[])
+{
+	i32 processId = 0;
+	u32 interval = 1000;
+	u32 count = 0;
+	b8 detail = false;
+
+	for (i32 i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--pid") == 0) processId = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--interval") == 0) interval = static_cast<u32>(atoi(argv[i + 1]));
+		else if (strcmp(argv[i], "--count") == 0) count = static_cast<u32>(atoi(argv[i + 1]));
+		else if (strcmp(argv[i], "--detail") == 0) detail = atoi(argv[i + 1]) != 0;
+
+		else
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (argc % 2 == 0)
+	{
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	if (processId <= 0)
+	{
+		PrintPages();
+		return 0;
+	}
+
+	if (interval == 0)
+	{
+		printf("%s\n", "Interval must be greater than 0");
+		return 1;
+	}
+
+	Stat::MappedPage mapped = {};
+
+	if (!Stat::MapPage(processId, &mapped))
+	{
+		printf("No valid statistics page for process %d\n", processId);
+		return 1;
+	}
+
+	const Page* page = mapped.Page;
+
+	Stat::Sample previous;
+	Stat::Sample current;
+
+	Stat::TakeSample(page, &previous);
+
+	if (!detail) PrintHeader();
+
+	// With a count of 0, samples for as long as the process runs
+	for (u32 sample = 0; count == 0 || sample < count; sample++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+		Stat::TakeSample(page, &current);
+
+		if (detail) PrintHeader();
+		PrintRates(previous, current);
+
+		if (detail)
+		{
+			PrintFunctions(page, previous, current, (current.Time - previous.Time) / 1e9);
+			PrintCaches(page, previous, current, (current.Time - previous.Time) / 1e9);
+			PrintBlocks(page);
+			printf("\n");
+		}
+
+		fflush(stdout);
+
+		if (!Stat::IsProcessAlive(processId))
+		{
+			printf("Process %d exited\n", processId);
+			break;
+		}
+
+		std::swap(previous, current);
+	}
+
+	Stat::UnmapPage(&mapped);
+	return 0;
+}
\ No newline at end of file
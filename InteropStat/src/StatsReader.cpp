@@ -0,0 +1,207 @@
+#include "StatsReader.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+#ifdef INTEROP_PLATFORM_UNIX
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#else
+#include <windows.h>
+#endif
+
+#ifndef _MSC_VER
+#include <cxxabi.h>
+#endif
+
+using Interop::Stats::Page;
+
+namespace Stat
+{
+
+	static b8 IsValid(const Page* page, u64 size)
+	{
+		return size >= sizeof(Page)
+			&& page->Magic == INTEROP_STATS_MAGIC
+			&& page->Version == INTEROP_STATS_VERSION
+			&& page->Size >= sizeof(Page)
+			&& page->Size <= size;
+	}
+
+	b8 MapPage(i32 processId, MappedPage* page)
+	{
+		std::string name = INTEROP_STATS_NAME_PREFIX + std::to_string(processId);
+
+#ifdef INTEROP_PLATFORM_UNIX
+		std::string path = INTEROP_STATS_DIRECTORY + name;
+		i32 fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+		if (fd == -1) return false;
+
+		struct stat filestat;
+		void* address = MAP_FAILED;
+
+		if (fstat(fd, &filestat) != -1 && static_cast<u64>(filestat.st_size) >= sizeof(Page))
+			address = mmap(nullptr, static_cast<size_t>(filestat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+		close(fd);
+
+		if (address == MAP_FAILED) return false;
+
+		page->Page = static_cast<const Page*>(address);
+		page->Size = static_cast<u64>(filestat.st_size);
+
+#else
+		HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+		if (mapping == nullptr) return false;
+
+		void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+		MEMORY_BASIC_INFORMATION info = {};
+
+		if (address == nullptr || VirtualQuery(address, &info, sizeof(info)) == 0)
+		{
+			if (address != nullptr) UnmapViewOfFile(address);
+			CloseHandle(mapping);
+
+			return false;
+		}
+
+		page->Page = static_cast<const Page*>(address);
+		page->Size = static_cast<u64>(info.RegionSize);
+		page->Handle = mapping;
+#endif
+
+		if (!IsValid(page->Page, page->Size))
+		{
+			UnmapPage(page);
+			return false;
+		}
+
+		return true;
+	}
+
+	void UnmapPage(MappedPage* page)
+	{
+		if (page->Page == nullptr) return;
+
+#ifdef INTEROP_PLATFORM_UNIX
+		munmap(const_cast<Page*>(page->Page), static_cast<size_t>(page->Size));
+
+#else
+		UnmapViewOfFile(page->Page);
+		CloseHandle(page->Handle);
+#endif
+
+		*page = {};
+	}
+
+	std::vector<i32> ListPages()
+	{
+		std::vector<i32> processIds;
+
+#ifdef INTEROP_PLATFORM_UNIX
+		std::error_code error;
+		const size_t prefixLength = strlen(INTEROP_STATS_NAME_PREFIX);
+
+		for (const auto& entry : std::filesystem::directory_iterator(INTEROP_STATS_DIRECTORY, error))
+		{
+			std::string name = entry.path().filename().string();
+			if (name.compare(0, prefixLength, INTEROP_STATS_NAME_PREFIX) != 0) continue;
+
+			char* end = nullptr;
+			long processId = strtol(name.c_str() + prefixLength, &end, 10);
+
+			if (end != name.c_str() + prefixLength && *end == '\0' && processId > 0)
+				processIds.push_back(static_cast<i32>(processId));
+		}
+#endif
+
+		return processIds;
+	}
+
+	b8 IsProcessAlive(i32 processId)
+	{
+#ifdef INTEROP_PLATFORM_UNIX
+		return kill(processId, 0) == 0 || errno == EPERM;
+
+#else
+		HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(processId));
+		if (process == nullptr) return false;
+
+		DWORD exitCode = 0;
+		b8 alive = GetExitCodeProcess(process, &exitCode) && exitCode == STILL_ACTIVE;
+
+		CloseHandle(process);
+		return alive;
+#endif
+	}
+
+	void TakeSample(const Page* page, Sample* sample)
+	{
+		sample->Time = static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+
+		sample->ControllerCalls = page->ControllerCalls.load(std::memory_order_relaxed);
+		sample->BytesCopied = page->BytesCopied.load(std::memory_order_relaxed);
+
+		for (u32 i = 0; i < INTEROP_STATS_STRIPES; i++)
+			sample->BytesCopied += page->Stripes[i].BytesCopied.load(std::memory_order_relaxed);
+
+		sample->ReservationFailures = page->ReservationFailures.load(std::memory_order_relaxed);
+		sample->MemorySize = page->MemorySize.load(std::memory_order_relaxed);
+		sample->MemoryReserved = page->MemoryReserved.load(std::memory_order_relaxed);
+
+		u32 functionCount = page->FunctionCount.load(std::memory_order_acquire);
+
+		sample->FunctionCalls = 0;
+		sample->Calls.resize(functionCount);
+
+		for (u32 i = 0; i < functionCount; i++)
+		{
+			sample->Calls[i] = page->Functions[i].Calls.load(std::memory_order_relaxed);
+
+			for (u32 j = 0; j < INTEROP_STATS_STRIPES; j++)
+				sample->Calls[i] += page->Stripes[j].Calls[i].load(std::memory_order_relaxed);
+
+			sample->FunctionCalls += sample->Calls[i];
+		}
+
+		u32 cacheCount = page->CacheCount.load(std::memory_order_acquire);
+
+		sample->CacheHits.resize(cacheCount);
+		sample->CacheMisses.resize(cacheCount);
+
+		for (u32 i = 0; i < cacheCount; i++)
+		{
+			sample->CacheHits[i] = page->Caches[i].Hits.load(std::memory_order_relaxed);
+			sample->CacheMisses[i] = page->Caches[i].Misses.load(std::memory_order_relaxed);
+		}
+	}
+
+	std::string DemangleTypeName(const char* name)
+	{
+		// Entries are cut to fit, make sure the name ends within its field
+		std::string stored(name, strnlen(name, sizeof(Interop::Stats::BlockStats::Name)));
+
+#ifndef _MSC_VER
+		i32 status = 0;
+		char* demangled = abi::__cxa_demangle(stored.c_str(), nullptr, nullptr, &status);
+
+		if (status == 0 && demangled != nullptr)
+		{
+			stored = demangled;
+			free(demangled);
+		}
+#endif
+
+		return stored;
+	}
+
+}
\ No newline at end of file
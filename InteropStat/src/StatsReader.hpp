@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Core/Definitions.hpp>
+#include <Core/Stats.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Stat
+{
+
+	struct MappedPage
+	{
+		const Interop::Stats::Page* Page = nullptr;
+		u64 Size = 0;
+		void* Handle = nullptr; // Mapping handle on Windows
+	};
+
+	// Counters of a page at one point in time, loaded one by one: they are consistent with each other
+	// only as far as relaxed loads go, which is enough for rates
+	struct Sample
+	{
+		u64 Time = 0; // Monotonic, in nanoseconds
+
+		u64 FunctionCalls = 0;
+		u64 ControllerCalls = 0;
+		u64 BytesCopied = 0;
+		u64 ReservationFailures = 0;
+		u32 MemorySize = 0;
+		u32 MemoryReserved = 0;
+
+		std::vector<u64> Calls = {}; // Per function, in page order
+		std::vector<u64> CacheHits = {}; // Per cache, in page order
+		std::vector<u64> CacheMisses = {};
+	};
+
+	// Maps the page of a process read-only, after checking its magic and layout version
+	b8 MapPage(i32 processId, MappedPage* page);
+	void UnmapPage(MappedPage* page);
+
+	// Processes with a page, live or not. Always empty on Windows, where named mappings cannot be listed.
+	std::vector<i32> ListPages();
+	b8 IsProcessAlive(i32 processId);
+
+	void TakeSample(const Interop::Stats::Page* page, Sample* sample);
+
+	// Readable form of the type names stored in block entries
+	std::string DemangleTypeName(const char* name);
+
+}
\ No newline at end of file
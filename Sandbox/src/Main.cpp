@@ -1,19 +1,60 @@
 #include <Core/Definitions.hpp>
 #include <Core/HostedAssembly.hpp>
+#include <Core/ManagedTask.hpp>
 #include <Core/Memory.hpp>
+#include <Core/Recorder.hpp>
+#include <Core/Trace.hpp>
 
 #include <NetCore/NetCoreController.hpp>
 
 #include <NetCore/Api/ExampleApi.hpp>
 
+#include <atomic>
+#include <coroutine>
+#include <exception>
+
 typedef void (INTEROP_DELEGATE_CALLTYPE *PrintObjPropertiesFn)(void*);
 typedef void (INTEROP_DELEGATE_CALLTYPE *PassObjectToHostFn)();
 typedef void (INTEROP_DELEGATE_CALLTYPE *DelegateRoundaboutFn)();
 typedef void (INTEROP_DELEGATE_CALLTYPE* ReadObjectFromSharedMemoryFn)(u32);
 typedef void (INTEROP_DELEGATE_CALLTYPE* WriteObjectToSharedMemoryFn)(u32);
 
+// Fire-and-forget coroutine, enough to await managed tasks from main
+struct SandboxCoroutine
+{
+	struct promise_type
+	{
+		SandboxCoroutine get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+SandboxCoroutine SquareAsync(Interop::Tasks::AsyncEntryFn entry, i32 value, std::atomic<b8>* done)
+{
+	// Resumed on the thread completing the managed Task
+	Interop::Tasks::TaskResult<i32> result = co_await Interop::Tasks::ManagedTask<i32>(entry, &value);
+
+	if (result.Succeeded())
+		printf("Square of %d computed by .NET: %d\n", value, result.Value);
+
+	else
+		printf("Unable to square %d in .NET: %s\n", value, result.Error);
+
+	done->store(true, std::memory_order_release);
+	done->notify_one();
+}
+
 int main(int argc, char* argv[])
 {
+	const char* tracePath = getenv("INTEROP_TRACE");
+	if (tracePath != nullptr) Interop::Trace::Start();
+
+	const char* recordPath = getenv("INTEROP_RECORD");
+	if (recordPath != nullptr) Interop::Recorder::Start();
+
 	Interop::NetCore::Controller controller = Interop::NetCore::Controller("9.0.0");
 
 	if (!controller.Init())
@@ -29,6 +70,7 @@ int main(int argc, char* argv[])
 	if (success) success = controller.LoadAssemblyFunction("DelegateRoundabout", "Interop.Core.Examples.EntryPoint", &interopCore);
 	if (success) success = controller.LoadAssemblyFunction("ReadObjectFromSharedMemory", "Interop.Core.Examples.EntryPoint", &interopCore);
 	if (success) success = controller.LoadAssemblyFunction("WriteObjectToSharedMemory", "Interop.Core.Examples.EntryPoint", &interopCore);
+	if (success) success = controller.LoadAssemblyFunction("SquareAsync", "Interop.Core.Examples.EntryPoint", &interopCore);
 	if (success) success = controller.CloseContext();
 
 	if (!success) return 1;
@@ -38,6 +80,7 @@ int main(int argc, char* argv[])
 	auto DelegateRoundabout = interopCore.GetFunction<DelegateRoundaboutFn>("DelegateRoundabout");
 	auto ReadObjectFromSharedMemory = interopCore.GetFunction<ReadObjectFromSharedMemoryFn>("ReadObjectFromSharedMemory");
 	auto WriteObjectToSharedMemory = interopCore.GetFunction<WriteObjectToSharedMemoryFn>("WriteObjectToSharedMemory");
+	auto SquareAsyncEntry = interopCore.GetFunction<Interop::Tasks::AsyncEntryFn>("SquareAsync");
 
 	Interop::NetCore::Api::CustomObject exampleObj = {};
 
@@ -56,5 +99,16 @@ int main(int argc, char* argv[])
 	sharedObj->DoubleProperty = 6.28572856;
 	PrintObjProperties((void*)sharedObj);
 
+	for (i32 value : { 12, -3 })
+	{
+		std::atomic<b8> done = false;
+		SquareAsync(SquareAsyncEntry, value, &done);
+
+		done.wait(false, std::memory_order_acquire);
+	}
+
+	if (tracePath != nullptr) Interop::Trace::Stop(tracePath);
+	if (recordPath != nullptr) Interop::Recorder::Stop(recordPath);
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+# Packs the assemblies of a .NET build output into a single bundle, loaded by Controller::SetAssemblyBundle
+# Usage: cmake -DASSEMBLY_NAME=<name> -DASSEMBLY_DIR=<dir> -DOUTPUT=<file> [-DINCLUDE_SYMBOLS=ON] -P PackAssemblyBundle.cmake
+#
+# Layout (see InteropLib/src/Core/AssemblyBundle.hpp): a text header, "INTEROP_BUNDLE <version> <count>",
+# then one "<name> <image offset> <image size> <symbols offset> <symbols size>" line per assembly, padded
+# with spaces up to a page boundary. Images and symbols follow, each starting on a 16-byte boundary.
+cmake_minimum_required(VERSION 3.18)
+
+set(BUNDLE_VERSION 1)
+set(BUNDLE_ALIGNMENT 16)
+set(BUNDLE_PAGE_SIZE 4096)
+
+if(NOT ASSEMBLY_NAME OR NOT ASSEMBLY_DIR OR NOT OUTPUT)
+	message(FATAL_ERROR "ASSEMBLY_NAME, ASSEMBLY_DIR and OUTPUT are required")
+endif()
+
+# Dependencies first, the assembly itself last
+file(GLOB assemblies ${ASSEMBLY_DIR}/*.dll)
+list(REMOVE_ITEM assemblies ${ASSEMBLY_DIR}/${ASSEMBLY_NAME}.dll)
+list(SORT assemblies)
+list(APPEND assemblies ${ASSEMBLY_DIR}/${ASSEMBLY_NAME}.dll)
+
+set(work_dir ${ASSEMBLY_DIR}/bundle)
+file(REMOVE_RECURSE ${work_dir})
+file(MAKE_DIRECTORY ${work_dir})
+
+# Files to concatenate after the header, padded so that each one starts aligned
+set(pieces)
+set(lines)
+set(offset 0)
+set(header_estimate 64)
+
+function(append_piece PATH)
+	file(SIZE ${PATH} size)
+	math(EXPR padding "(${BUNDLE_ALIGNMENT} - ${size} % ${BUNDLE_ALIGNMENT}) % ${BUNDLE_ALIGNMENT}")
+
+	set(piece_list ${pieces} ${PATH})
+
+	if(padding GREATER 0)
+		list(LENGTH piece_list index)
+		string(REPEAT " " ${padding} spaces)
+		file(WRITE ${work_dir}/padding${index} "${spaces}")
+		list(APPEND piece_list ${work_dir}/padding${index})
+	endif()
+
+	math(EXPR next "${offset} + ${size} + ${padding}")
+
+	set(pieces ${piece_list} PARENT_SCOPE)
+	set(piece_offset ${offset} PARENT_SCOPE)
+	set(piece_size ${size} PARENT_SCOPE)
+	set(offset ${next} PARENT_SCOPE)
+endfunction()
+
+set(entries)
+
+foreach(assembly ${assemblies})
+	get_filename_component(name ${assembly} NAME_WLE)
+	get_filename_component(directory ${assembly} DIRECTORY)
+
+	append_piece(${assembly})
+	set(entry "${name} ${piece_offset} ${piece_size}")
+
+	if(INCLUDE_SYMBOLS AND EXISTS ${directory}/${name}.pdb)
+		append_piece(${directory}/${name}.pdb)
+		string(APPEND entry " ${piece_offset} ${piece_size}")
+
+	else()
+		string(APPEND entry " 0 0")
+	endif()
+
+	list(APPEND entries "${entry}")
+
+	# Offsets are 64-bit decimals once relocated past the header
+	string(LENGTH "${name}" name_length)
+	math(EXPR header_estimate "${header_estimate} + ${name_length} + 4 * 21 + 1")
+endforeach()
+
+# The header size only depends on the estimate, so the offsets can be relocated before it is written
+math(EXPR header_size "(${header_estimate} + ${BUNDLE_PAGE_SIZE} - 1) / ${BUNDLE_PAGE_SIZE} * ${BUNDLE_PAGE_SIZE}")
+
+list(LENGTH assemblies count)
+set(header "INTEROP_BUNDLE ${BUNDLE_VERSION} ${count}\n")
+
+foreach(entry ${entries})
+	string(REPLACE " " ";" fields "${entry}")
+	list(GET fields 0 name)
+	list(GET fields 1 image_offset)
+	list(GET fields 2 image_size)
+	list(GET fields 3 symbols_offset)
+	list(GET fields 4 symbols_size)
+
+	math(EXPR image_offset "${image_offset} + ${header_size}")
+
+	if(symbols_size GREATER 0)
+		math(EXPR symbols_offset "${symbols_offset} + ${header_size}")
+	endif()
+
+	string(APPEND header "${name} ${image_offset} ${image_size} ${symbols_offset} ${symbols_size}\n")
+endforeach()
+
+string(LENGTH "${header}" header_length)
+math(EXPR header_padding "${header_size} - ${header_length}")
+string(REPEAT " " ${header_padding} spaces)
+file(WRITE ${work_dir}/header "${header}${spaces}")
+
+execute_process(
+	COMMAND ${CMAKE_COMMAND} -E cat ${work_dir}/header ${pieces}
+	OUTPUT_FILE ${OUTPUT}
+	RESULT_VARIABLE result)
+
+file(REMOVE_RECURSE ${work_dir})
+
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "Unable to write assembly bundle ${OUTPUT}")
+endif()
\ No newline at end of file